@@ -221,6 +221,9 @@ gasnete_coll_algorithm_t gasnete_coll_autotune_register_algorithm(gasnet_team_ha
     case GASNET_COLL_EXCHANGEM_OP: ret.fn_ptr.exchangeM_fn = (gasnete_coll_exchangeM_fn_ptr_t) coll_fnptr; break;
     case GASNET_COLL_REDUCE_OP: ret.fn_ptr.reduce_fn = (gasnete_coll_reduce_fn_ptr_t) coll_fnptr; break;
     case GASNET_COLL_REDUCEM_OP: ret.fn_ptr.reduceM_fn = (gasnete_coll_reduceM_fn_ptr_t) coll_fnptr; break;
+    case GASNET_COLL_REDUCE_ALL_OP: ret.fn_ptr.reduce_all_fn = (gasnete_coll_reduce_all_fn_ptr_t) coll_fnptr; break;
+    case GASNET_COLL_REDUCE_SCATTER_OP: ret.fn_ptr.reduce_scatter_fn = (gasnete_coll_reduce_scatter_fn_ptr_t) coll_fnptr; break;
+    case GASNET_COLL_EXCHANGEV_OP: ret.fn_ptr.exchangev_fn = (gasnete_coll_exchangev_fn_ptr_t) coll_fnptr; break;
     default: gasneti_fatalerror("not implemented yet");
   }
   return ret;
@@ -328,6 +331,38 @@ void gasnete_coll_register_broadcast_collectives(gasnete_coll_autotune_info_t* i
                                            GASNETE_COLL_MAX_BYTES /*works for all sizes*/, 0, 1,
                                            0,NULL,gasnete_coll_bcast_TreeRVGet, "BROADCAST_TREE_RVGET");
   
+  {
+    /*segments go straight into dst so the scratch space does not bound them*/
+    GASNETE_COLL_TUNING_PARAMETER(tuning_params, GASNET_COLL_PIPE_SEG_SIZE, GASNET_COLL_MIN_PIPE_SEG_SIZE, GASNET_COLL_MAX_PIPE_SEG_SIZE, 2, GASNET_COLL_TUNING_STRIDE_MULTIPLY | GASNET_COLL_TUNING_SIZE_PARAM); 
+    
+    info->collective_algorithms[GASNET_COLL_BROADCAST_OP][GASNETE_COLL_BROADCAST_TREE_PIPE] = 
+    gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_BROADCAST_OP, 
+                                             GASNETE_COLL_EVERY_SYNC_FLAG,
+                                             GASNET_COLL_DST_IN_SEGMENT | GASNET_COLL_SINGLE, 0,
+                                             GASNETE_COLL_MAX_BYTES, GASNET_COLL_MIN_PIPE_SEG_SIZE, 1,
+                                             1,tuning_params,gasnete_coll_bcast_TreePipe, "BROADCAST_TREE_PIPE");
+  }
+
+#if GASNET_PSHM
+  /*one network put per supernode, the rest through the shared segments*/
+  info->collective_algorithms[GASNET_COLL_BROADCAST_OP][GASNETE_COLL_BROADCAST_SN_PUT] = 
+  gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_BROADCAST_OP, GASNETE_COLL_EVERY_SYNC_FLAG,
+                                           GASNET_COLL_DST_IN_SEGMENT | GASNET_COLL_SINGLE, 0,
+                                           GASNETE_COLL_MAX_BYTES, 0, 0,
+                                           0,NULL,gasnete_coll_bcast_SNPut, "BROADCAST_SN_PUT");
+
+  {
+    /*smp_coll tree over flags in shared memory; only offered (via its sync flags) when the team has them*/
+    GASNETE_COLL_TUNING_PARAMETER(tuning_params, GASNET_COLL_DISSEM_RADIX, 2, MAX(2,info->team->total_ranks), 2, GASNET_COLL_TUNING_STRIDE_MULTIPLY); 
+    info->collective_algorithms[GASNET_COLL_BROADCAST_OP][GASNETE_COLL_BROADCAST_SMP_PSHM_TREE_FLAG] = 
+    gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_BROADCAST_OP, 
+                                             (info->team->smp_pshm.region ? GASNETE_COLL_EVERY_SYNC_FLAG : 0),
+                                             GASNET_COLL_SRC_IN_SEGMENT | GASNET_COLL_DST_IN_SEGMENT | GASNET_COLL_SINGLE, 0,
+                                             GASNETE_COLL_MAX_BYTES, 0, 0,
+                                             1,tuning_params,gasnete_coll_bcast_SMPTreeFlag, "BROADCAST_SMP_PSHM_TREE_FLAG");
+  }
+#endif
+  
   
   
   
@@ -623,6 +658,14 @@ void gasnete_coll_register_gather_collectives(gasnete_coll_autotune_info_t* info
                                            0, 0,
                                            GASNETE_COLL_MAX_BYTES, 0, 0,
                                            0,NULL,gasnete_coll_gath_RVous, "GATHER_RVOUS");
+#if GASNET_PSHM
+  info->collective_algorithms[GASNET_COLL_GATHER_OP][GASNETE_COLL_GATHER_SN_EAGER]=
+  gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_GATHER_OP, 
+                                           GASNETE_COLL_EVERY_SYNC_FLAG,
+                                           GASNET_COLL_SRC_IN_SEGMENT | GASNET_COLL_SINGLE, 0,
+                                           MIN(gasnete_coll_p2p_eager_scale, gasnet_AMMaxMedium()), 0, 0,
+                                           0,NULL,gasnete_coll_gath_SNEager, "GATHER_SN_EAGER");
+#endif
   
   info->collective_algorithms[GASNET_COLL_GATHERM_OP] = gasneti_malloc(sizeof(gasnete_coll_algorithm_t)*GASNETE_COLL_GATHERM_NUM_ALGS);
   
@@ -911,6 +954,26 @@ void gasnete_coll_register_exchange_collectives(gasnete_coll_autotune_info_t* in
                                              GASNETE_COLL_MAX_BYTES, 0, 0,
                                              0, NULL,  gasnete_coll_exchg_Gath, "EXCHANGE_GATH");
   }
+#if GASNET_PSHM
+  {
+    /*each eager message carries a block for every member of the largest supernode*/
+    size_t max_size = MIN(gasnete_coll_p2p_eager_scale, gasnet_AMMaxMedium())/info->team->supernode_grps.max_count;
+    info->collective_algorithms[GASNET_COLL_EXCHANGE_OP][GASNETE_COLL_EXCHANGE_SN_EAGER] =
+    gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_EXCHANGE_OP,
+                                             GASNETE_COLL_EVERY_SYNC_FLAG,
+                                             GASNET_COLL_SRC_IN_SEGMENT|GASNET_COLL_DST_IN_SEGMENT|GASNET_COLL_SINGLE, 0, 
+                                             max_size, 0, 0,
+                                             0, NULL,  gasnete_coll_exchg_SNEager, "EXCHANGE_SN_EAGER");
+  }
+  {
+    info->collective_algorithms[GASNET_COLL_EXCHANGE_OP][GASNETE_COLL_EXCHANGE_SMP_PSHM_PUT] =
+    gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_EXCHANGE_OP,
+                                             (info->team->smp_pshm.region ? GASNETE_COLL_EVERY_SYNC_FLAG : 0),
+                                             GASNET_COLL_DST_IN_SEGMENT|GASNET_COLL_SINGLE, 0, 
+                                             GASNETE_COLL_MAX_BYTES, 0, 0,
+                                             0, NULL,  gasnete_coll_exchg_SMPPut, "EXCHANGE_SMP_PSHM_PUT");
+  }
+#endif
   
   
   info->collective_algorithms[GASNET_COLL_EXCHANGEM_OP] = gasneti_malloc(sizeof(gasnete_coll_algorithm_t)*GASNETE_COLL_EXCHANGEM_NUM_ALGS);
@@ -1141,6 +1204,14 @@ void gasnete_coll_register_reduce_collectives(gasnete_coll_autotune_info_t* info
                                              smallest_seg_size, 1,
                                              1,tuning_params,gasnete_coll_reduce_TreePutSeg, "REDUCE_TREE_PUT_SEG");
   }
+#if GASNET_PSHM
+  info->collective_algorithms[GASNET_COLL_REDUCE_OP][GASNETE_COLL_REDUCE_SN_EAGER] = 
+  gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_REDUCE_OP, 
+                                           GASNETE_COLL_EVERY_SYNC_FLAG,
+                                           GASNET_COLL_SRC_IN_SEGMENT | GASNET_COLL_SINGLE, 0,
+                                           MIN(gasnete_coll_p2p_eager_scale, gasnet_AMMaxMedium()), 0, 0,
+                                           0,NULL,gasnete_coll_reduce_SNEager, "REDUCE_SN_EAGER");
+#endif
   
   
   info->collective_algorithms[GASNET_COLL_REDUCEM_OP] = gasneti_malloc(sizeof(gasnete_coll_algorithm_t)*GASNETE_COLL_REDUCEM_NUM_ALGS);
@@ -1184,6 +1255,97 @@ void gasnete_coll_register_reduce_collectives(gasnete_coll_autotune_info_t* info
 }
 
 
+/* The butterfly algorithms need one image per node and a commutative function
+   (and RecHalv additionally a power of two number of nodes)*/
+static int gasnete_coll_reduce_butterfly_ok(gasnete_coll_team_t team, gasnet_coll_fn_handle_t func, int need_pof2) {
+  if(team->total_images != team->total_ranks) return 0;
+  if(gasnete_coll_fn_lookup(func)->flags & GASNET_COLL_NONCOMM) return 0;
+  if(need_pof2 && (team->total_ranks & (team->total_ranks-1))) return 0;
+  return 1;
+}
+
+void gasnete_coll_register_reduce_all_collectives(gasnete_coll_autotune_info_t* info, size_t smallest_scratch) {
+  /* the butterflies keep the whole vector twice plus the incoming slots in the scratch space*/
+  size_t phases = 0;
+  while((2u << phases) <= info->team->total_ranks) phases++;
+  
+  info->collective_algorithms[GASNET_COLL_REDUCE_ALL_OP] = gasneti_malloc(sizeof(gasnete_coll_algorithm_t)*GASNETE_COLL_REDUCE_ALL_NUM_ALGS);
+  
+  info->collective_algorithms[GASNET_COLL_REDUCE_ALL_OP][GASNETE_COLL_REDUCE_ALL_RED_BCAST] = 
+  gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_REDUCE_ALL_OP, 
+                                           GASNETE_COLL_EVERY_SYNC_FLAG,
+                                           0, 0,
+                                           GASNETE_COLL_MAX_BYTES, 0, 0,
+                                           0,NULL,gasnete_coll_reduce_all_RedBcast, "REDUCE_ALL_RED_BCAST");
+  
+  info->collective_algorithms[GASNET_COLL_REDUCE_ALL_OP][GASNETE_COLL_REDUCE_ALL_REC_DBL] = 
+  gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_REDUCE_ALL_OP, 
+                                           GASNETE_COLL_EVERY_SYNC_FLAG,
+                                           0, 0,
+                                           smallest_scratch/(2+phases), 0, 0,
+                                           0,NULL,gasnete_coll_reduce_all_RecDbl, "REDUCE_ALL_REC_DBL");
+  
+  /* 2*nbytes for ACC/FOLD plus just under 2*nbytes of halving slots (block rounding aside)*/
+  info->collective_algorithms[GASNET_COLL_REDUCE_ALL_OP][GASNETE_COLL_REDUCE_ALL_RABENSEIFNER] = 
+  gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_REDUCE_ALL_OP, 
+                                           GASNETE_COLL_EVERY_SYNC_FLAG,
+                                           0, 0,
+                                           smallest_scratch/5, 0, 0,
+                                           0,NULL,gasnete_coll_reduce_all_Rabenseifner, "REDUCE_ALL_RABENSEIFNER");
+  
+  /* sizes for reduce_scatter are per-image blocks */
+  info->collective_algorithms[GASNET_COLL_REDUCE_SCATTER_OP] = gasneti_malloc(sizeof(gasnete_coll_algorithm_t)*GASNETE_COLL_REDUCE_SCATTER_NUM_ALGS);
+  
+  info->collective_algorithms[GASNET_COLL_REDUCE_SCATTER_OP][GASNETE_COLL_REDUCE_SCATTER_RED_SCAT] = 
+  gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_REDUCE_SCATTER_OP, 
+                                           GASNETE_COLL_EVERY_SYNC_FLAG,
+                                           0, 0,
+                                           GASNETE_COLL_MAX_BYTES, 0, 0,
+                                           0,NULL,gasnete_coll_reduce_scatter_RedScat, "REDUCE_SCATTER_RED_SCAT");
+  
+  info->collective_algorithms[GASNET_COLL_REDUCE_SCATTER_OP][GASNETE_COLL_REDUCE_SCATTER_REC_DBL] = 
+  gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_REDUCE_SCATTER_OP, 
+                                           GASNETE_COLL_EVERY_SYNC_FLAG,
+                                           0, 0,
+                                           smallest_scratch/(info->team->total_ranks*(2+phases)), 0, 0,
+                                           0,NULL,gasnete_coll_reduce_scatter_RecDbl, "REDUCE_SCATTER_REC_DBL");
+  
+  info->collective_algorithms[GASNET_COLL_REDUCE_SCATTER_OP][GASNETE_COLL_REDUCE_SCATTER_REC_HALV] = 
+  gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_REDUCE_SCATTER_OP, 
+                                           GASNETE_COLL_EVERY_SYNC_FLAG,
+                                           0, 0,
+                                           smallest_scratch/(info->team->total_ranks*4), 0, 0,
+                                           0,NULL,gasnete_coll_reduce_scatter_RecHalv, "REDUCE_SCATTER_REC_HALV");
+}
+
+void gasnete_coll_register_exchangev_collectives(gasnete_coll_autotune_info_t* info, size_t smallest_scratch) {
+  /* sizes for exchangev are the single-valued max_nbytes bound on the blocks */
+  const size_t dissem_max = gasnete_coll_exchgv_dissem_max_nbytes(info->team, gasnete_coll_fetch_dissemination(2, info->team), 
+                                                                  smallest_scratch);
+  info->collective_algorithms[GASNET_COLL_EXCHANGEV_OP] = gasneti_malloc(sizeof(gasnete_coll_algorithm_t)*GASNETE_COLL_EXCHANGEV_NUM_ALGS);
+  
+  info->collective_algorithms[GASNET_COLL_EXCHANGEV_OP][GASNETE_COLL_EXCHANGEV_DISSEM] = 
+  gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_EXCHANGEV_OP, 
+                                           GASNETE_COLL_EVERY_SYNC_FLAG,
+                                           0, 0,
+                                           dissem_max, 0, 0,
+                                           0,NULL,gasnete_coll_exchgv_Dissem, "EXCHANGEV_DISSEM");
+  
+  info->collective_algorithms[GASNET_COLL_EXCHANGEV_OP][GASNETE_COLL_EXCHANGEV_CHUNKED] = 
+  gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_EXCHANGEV_OP, 
+                                           GASNETE_COLL_EVERY_SYNC_FLAG,
+                                           0, 0,
+                                           (dissem_max ? GASNETE_COLL_MAX_BYTES : 0), 0, 0,
+                                           0,NULL,gasnete_coll_exchgv_Chunked, "EXCHANGEV_CHUNKED");
+  
+  info->collective_algorithms[GASNET_COLL_EXCHANGEV_OP][GASNETE_COLL_EXCHANGEV_PUT] = 
+  gasnete_coll_autotune_register_algorithm(info->team, GASNET_COLL_EXCHANGEV_OP, 
+                                           GASNETE_COLL_EVERY_SYNC_FLAG,
+                                           GASNET_COLL_DST_IN_SEGMENT, 0,
+                                           GASNETE_COLL_MAX_BYTES, 0, 0,
+                                           0,NULL,gasnete_coll_exchgv_Put, "EXCHANGEV_PUT");
+}
+
 void gasnete_coll_register_collectives(gasnete_coll_autotune_info_t* info, size_t smallest_scratch) {
   gasnete_coll_register_broadcast_collectives(info, smallest_scratch);
   gasnete_coll_register_scatter_collectives(info, smallest_scratch);
@@ -1191,6 +1353,8 @@ void gasnete_coll_register_collectives(gasnete_coll_autotune_info_t* info, size_
   gasnete_coll_register_gather_all_collectives(info, smallest_scratch);
   gasnete_coll_register_exchange_collectives(info, smallest_scratch);
   gasnete_coll_register_reduce_collectives(info, smallest_scratch);
+  gasnete_coll_register_reduce_all_collectives(info, smallest_scratch);
+  gasnete_coll_register_exchangev_collectives(info, smallest_scratch);
 
 }
 
@@ -1222,6 +1386,12 @@ void gasnete_coll_free_autotune_tree_node(gasnete_coll_autotune_tree_node_t *in)
 static int allow_conduit_collectives=1;
 #endif
 static char* gasnete_coll_team_all_tuning_file;
+/* Tuning cache (GASNET_COLL_TUNING_CACHE): loaded if present and written
+   through by TEAM_ALL's rank 0 each time a search adds an entry */
+static char* gasnete_coll_team_all_tuning_cache;
+static int gasnete_coll_team_all_cache_loaded;
+static void load_tuning_state(const char *filename, gasnete_coll_team_t team, int is_cache GASNETE_THREAD_FARG);
+static void save_tuning_cache(const char *filename, gasnete_coll_team_t team);
 gasnete_coll_autotune_info_t* gasnete_coll_autotune_init(gasnet_team_handle_t team, gasnet_node_t mynode, gasnet_node_t total_nodes,
                                                          gasnet_image_t my_images, gasnet_image_t total_images, size_t min_scratch_size GASNETE_THREAD_FARG) {
 
@@ -1320,11 +1490,17 @@ gasnete_coll_autotune_info_t* gasnete_coll_autotune_init(gasnet_team_handle_t te
 
   if(team == GASNET_TEAM_ALL){
     gasnete_coll_team_all_tuning_file = gasneti_getenv_withdefault("GASNET_COLL_TUNING_FILE",NULL);
+    gasnete_coll_team_all_tuning_cache = gasneti_getenv_withdefault("GASNET_COLL_TUNING_CACHE",NULL);
+    if(gasnete_coll_team_all_tuning_file) {
+      /* an explicit tuning file takes precedence */
+      gasnete_coll_team_all_tuning_cache = NULL;
+    }
     gasnete_coll_print_autotuner_timers = gasneti_getenv_yesno_withdefault("GASNET_COLL_PRINT_AUTOTUNE_TIMER", GASNETE_COLL_PRINT_TIMERS);
     gasnete_coll_print_coll_alg = gasneti_getenv_yesno_withdefault("GASNET_COLL_PRINT_COLL_ALG", 0);
   }
   
   ret->autotuner_defaults = NULL;
+  ret->tuning_table = NULL;
   ret->search_enabled = gasneti_getenv_yesno_withdefault("GASNET_COLL_ENABLE_SEARCH", 0);
   ret->profile_enabled = gasneti_getenv_yesno_withdefault("GASNET_COLL_ENABLE_PROFILE", 0);
   
@@ -1537,6 +1713,15 @@ static char* print_op_str(char *buf, gasnet_coll_optype_t op, int flags) {
     else
       strcpy(buf, "reduceM MULTI/");
     break;
+  case GASNET_COLL_REDUCE_ALL_OP:
+    strcpy(buf, "reduce_all SINGLE/");
+    break;
+  case GASNET_COLL_REDUCE_SCATTER_OP:
+    strcpy(buf, "reduce_scatter SINGLE/");
+    break;
+  case GASNET_COLL_EXCHANGEV_OP:
+    strcpy(buf, "exchangev SINGLE/");
+    break;
     
   default:
     strcpy(buf, "FILLIN");
@@ -1729,6 +1914,12 @@ static gasnet_coll_optype_t get_optype_from_str(char *str) {
     return GASNET_COLL_REDUCE_OP;
   else if(STRINGS_MATCH(str, "reduceM"))
     return GASNET_COLL_REDUCEM_OP;
+  else if(STRINGS_MATCH(str, "reduce_all"))
+    return GASNET_COLL_REDUCE_ALL_OP;
+  else if(STRINGS_MATCH(str, "reduce_scatter"))
+    return GASNET_COLL_REDUCE_SCATTER_OP;
+  else if(STRINGS_MATCH(str, "exchangev"))
+    return GASNET_COLL_EXCHANGEV_OP;
   
   else gasneti_fatalerror("op %s not yet supported\n", str);
   return (gasnet_coll_optype_t)(-1); /* NOT REACHED */
@@ -1761,10 +1952,10 @@ static char * optype_to_str(char *buffer, int op) {
       strcpy(buffer, "gather_allM");
       break;
     case GASNET_COLL_EXCHANGE_OP:
-      strcpy(buffer, "gather_all");
+      strcpy(buffer, "exchange");
       break;
     case GASNET_COLL_EXCHANGEM_OP:
-      strcpy(buffer, "gather_allM");
+      strcpy(buffer, "exchangeM");
       break;
     case GASNET_COLL_REDUCE_OP:
       strcpy(buffer, "reduce");
@@ -1773,6 +1964,15 @@ static char * optype_to_str(char *buffer, int op) {
     case GASNET_COLL_REDUCEM_OP:
       strcpy(buffer, "reduceM");
       break;
+    case GASNET_COLL_REDUCE_ALL_OP:
+      strcpy(buffer, "reduce_all");
+      break;
+    case GASNET_COLL_REDUCE_SCATTER_OP:
+      strcpy(buffer, "reduce_scatter");
+      break;
+    case GASNET_COLL_EXCHANGEV_OP:
+      strcpy(buffer, "exchangev");
+      break;
     default:
       gasneti_fatalerror("unknown op type");
   }
@@ -1818,6 +2018,8 @@ static gasnete_coll_autotune_index_entry_t *load_autotuner_defaults_helper(gasne
       
       temp->end = atoi(MYXML_VALUE(MYXML_CHILDREN(child_node)[0]));
       temp->impl = gasnete_coll_get_implementation();
+      temp->impl->team = info->team;
+      temp->impl->optype = optype;
       temp->impl->fn_ptr = info->collective_algorithms[optype][atoi(MYXML_VALUE(MYXML_CHILDREN(child_node)[0]))].fn_ptr.generic_coll_fn_ptr;
       temp->impl->fn_idx = atoi(MYXML_VALUE(MYXML_CHILDREN(child_node)[0]));
       if(strlen(MYXML_VALUE(MYXML_CHILDREN(child_node)[1])) > 0) {
@@ -1974,6 +2176,20 @@ static gasnett_tick_t run_collective_bench(gasnet_team_handle_t team, gasnet_col
         if(fnptr) (*fnptr)(sample_work_arg);
         gasnete_coll_wait_sync(handle GASNETE_THREAD_PASS);
         break; 
+      case GASNET_COLL_REDUCE_ALL_OP:
+        handle = (*((gasnete_coll_reduce_all_fn_ptr_t) (impl->fn_ptr)))(team, coll_args.dst[0], coll_args.src[0],
+                                                                        coll_args.elem_size, coll_args.nbytes/coll_args.elem_size,
+                                                                        coll_args.func, coll_args.func_arg, flags, impl, 0 GASNETE_THREAD_PASS);
+        if(fnptr) (*fnptr)(sample_work_arg);
+        gasnete_coll_wait_sync(handle GASNETE_THREAD_PASS);
+        break; 
+      case GASNET_COLL_REDUCE_SCATTER_OP:
+        handle = (*((gasnete_coll_reduce_scatter_fn_ptr_t) (impl->fn_ptr)))(team, coll_args.dst[0], coll_args.src[0],
+                                                                            coll_args.elem_size, coll_args.nbytes/coll_args.elem_size,
+                                                                            coll_args.func, coll_args.func_arg, flags, impl, 0 GASNETE_THREAD_PASS);
+        if(fnptr) (*fnptr)(sample_work_arg);
+        gasnete_coll_wait_sync(handle GASNETE_THREAD_PASS);
+        break; 
         
       default:
         gasneti_fatalerror("collective not yet implemented");  
@@ -2066,6 +2282,20 @@ static gasnett_tick_t run_collective_bench(gasnet_team_handle_t team, gasnet_col
         if(fnptr) (*fnptr)(sample_work_arg);
         gasnete_coll_wait_sync(handle GASNETE_THREAD_PASS);
         break; 
+      case GASNET_COLL_REDUCE_ALL_OP:
+        handle = (*((gasnete_coll_reduce_all_fn_ptr_t) (impl->fn_ptr)))(team, coll_args.dst[0], coll_args.src[0],
+                                                                        coll_args.elem_size, coll_args.nbytes/coll_args.elem_size,
+                                                                        coll_args.func, coll_args.func_arg, flags, impl, 0 GASNETE_THREAD_PASS);
+        if(fnptr) (*fnptr)(sample_work_arg);
+        gasnete_coll_wait_sync(handle GASNETE_THREAD_PASS);
+        break; 
+      case GASNET_COLL_REDUCE_SCATTER_OP:
+        handle = (*((gasnete_coll_reduce_scatter_fn_ptr_t) (impl->fn_ptr)))(team, coll_args.dst[0], coll_args.src[0],
+                                                                            coll_args.elem_size, coll_args.nbytes/coll_args.elem_size,
+                                                                            coll_args.func, coll_args.func_arg, flags, impl, 0 GASNETE_THREAD_PASS);
+        if(fnptr) (*fnptr)(sample_work_arg);
+        gasnete_coll_wait_sync(handle GASNETE_THREAD_PASS);
+        break; 
       default:
         gasneti_fatalerror("collective not yet implemented");  
     }    
@@ -2255,6 +2485,15 @@ void gasnete_coll_tune_generic_op(gasnet_team_handle_t team, gasnet_coll_optype_
     case GASNET_COLL_REDUCEM_OP:
       num_algs = GASNETE_COLL_REDUCEM_NUM_ALGS;
       break;
+    case GASNET_COLL_REDUCE_ALL_OP:
+      num_algs = GASNETE_COLL_REDUCE_ALL_NUM_ALGS;
+      break;
+    case GASNET_COLL_REDUCE_SCATTER_OP:
+      num_algs = GASNETE_COLL_REDUCE_SCATTER_NUM_ALGS;
+      break;
+    case GASNET_COLL_EXCHANGEV_OP:
+      num_algs = GASNETE_COLL_EXCHANGEV_NUM_ALGS;
+      break;
     default:
       num_algs = 0; /* warning suppression */
       gasneti_fatalerror("not yet supported");
@@ -2291,6 +2530,10 @@ void gasnete_coll_tune_generic_op(gasnet_team_handle_t team, gasnet_coll_optype_
         (op == GASNET_COLL_GATHER_ALLM_OP && algidx == GASNETE_COLL_GATHER_ALLM_GATH)) continue;
      if((op == GASNET_COLL_SCATTERM_OP && algidx ==   GASNETE_COLL_SCATTERM_TREE_PUT_SEG) ||
 	(op == GASNET_COLL_GATHERM_OP && algidx ==   GASNETE_COLL_GATHERM_TREE_PUT_SEG)) continue;
+     if((op == GASNET_COLL_REDUCE_ALL_OP && algidx != GASNETE_COLL_REDUCE_ALL_RED_BCAST &&
+         !gasnete_coll_reduce_butterfly_ok(team, coll_args.func, 0)) ||
+        (op == GASNET_COLL_REDUCE_SCATTER_OP && algidx != GASNETE_COLL_REDUCE_SCATTER_RED_SCAT &&
+         !gasnete_coll_reduce_butterfly_ok(team, coll_args.func, algidx == GASNETE_COLL_REDUCE_SCATTER_REC_HALV))) continue;
 	
     alg_best_time = curr_best_time;
 
@@ -2353,41 +2596,123 @@ gasnete_coll_autotune_index_entry_t *search_intervals(gasnete_coll_autotune_inde
   return NULL;
 }
 
-static
-gasnete_coll_implementation_t search_index(gasnet_coll_optype_t op, gasnete_coll_team_t team, uint32_t flags, size_t nbytes, gasnet_image_t rootimg, int exact_match) {
+/* Index of the last of the n sorted entries with a key no greater than key, or -1 if there is none */
+GASNETI_INLINE(table_last_le)
+int table_last_le(const gasnete_coll_autotune_table_entry_t *entries, uint32_t n, uint64_t key) {
+  uint32_t base = 0;
 
-  gasnete_coll_autotune_index_entry_t *temp = team->autotune_info->autotuner_defaults;
-  if(!temp) return NULL;
+  if(!n || entries[0].key > key) return -1;
+  while(n > 1) { /* branch-free bisection */
+    const uint32_t half = n / 2;
+    base = (entries[base + half].key <= key) ? base + half : base;
+    n -= half;
+  }
+  return base;
+}
 
-  
-  /*first go through and pick out the right subtree for the threads per node*/
-  temp = search_intervals(temp, team->total_ranks, exact_match);
-  if(!temp) return NULL;
-  
-  temp = search_intervals(temp->subtree, team->my_images,exact_match);
-  if(!temp) return NULL;
-  
-  /*next get the sync mode (need to find an exact match)*/
-  temp = search_intervals(temp->subtree, get_syncmode_from_flags(flags),1);
-  if(!temp) return NULL;
-  
-  /*lookup the address mode (need to find an exact match)*/
-  temp = search_intervals(temp->subtree, get_addrmode_from_flags(flags),1);
-  if(!temp) return NULL;
-  
-  /*loookup the op (need to find an exact match)*/
-  temp = search_intervals(temp->subtree, op,1);
-  if(!temp) return NULL;
-  
-  /*loookup the root*/
-  temp = search_intervals(temp->subtree, rootimg,exact_match);
-  if(!temp) return NULL;
-  
-  /*approximate match for size is ok*/
-  temp = search_intervals(temp->subtree, nbytes,exact_match);
-  if(!temp) return NULL;
-  
-  return temp->impl;
+static int compare_table_entries(const void *a, const void *b) {
+  const uint64_t x = ((const gasnete_coll_autotune_table_entry_t *)a)->key;
+  const uint64_t y = ((const gasnete_coll_autotune_table_entry_t *)b)->key;
+  return (x > y) - (x < y);
+}
+
+/* Slot of a (sync mode, address mode, collective) in the tuning table, or -1 if out of range */
+GASNETI_INLINE(tuning_table_slot)
+int tuning_table_slot(int syncmode, int addrmode, int op) {
+  if((unsigned)syncmode >= GASNETE_COLL_NUM_SYNCMODES || (unsigned)addrmode >= GASNETE_COLL_NUM_ADDRMODES ||
+     (unsigned)op >= GASNET_COLL_NUM_COLL_OPTYPES) return -1;
+  return (syncmode*GASNETE_COLL_NUM_ADDRMODES + addrmode)*GASNET_COLL_NUM_COLL_OPTYPES + op;
+}
+
+/* Run body for each (slot, root, size) leaf under a threads_per_node entry */
+#define FOREACH_TUNING_LEAF(threads_entry, slot, root_entry, size_entry, body) do {                  \
+    gasnete_coll_autotune_index_entry_t *_s, *_a, *_o;                                              \
+    for(_s = (threads_entry)->subtree; _s; _s = _s->next_interval)                                  \
+      for(_a = _s->subtree; _a; _a = _a->next_interval)                                             \
+        for(_o = _a->subtree; _o; _o = _o->next_interval) {                                         \
+          const int slot = tuning_table_slot(_s->start, _a->start, _o->start);                      \
+          if(slot < 0) continue;                                                                    \
+          for(root_entry = _o->subtree; root_entry; root_entry = root_entry->next_interval)         \
+            for(size_entry = root_entry->subtree; size_entry; size_entry = size_entry->next_interval) \
+              if(size_entry->impl) { body; }                                                        \
+        }                                                                                           \
+  } while(0)
+
+/* (Re)build the lookup table from the autotuner_defaults tree.
+   Must be called whenever the tree changes, while no thread can be in search_index(). */
+static void compile_tuning_table(gasnete_coll_autotune_info_t *info) {
+  gasnete_coll_team_t team = info->team;
+  gasnete_coll_autotune_table_t *table = info->tuning_table;
+  gasnete_coll_autotune_index_entry_t *temp = info->autotuner_defaults;
+  gasnete_coll_autotune_index_entry_t *root_entry, *size_entry;
+  uint32_t fill[GASNETE_COLL_TUNING_TABLE_SLOTS];
+  int i;
+
+  if(table) {
+    gasneti_free(table->entries);
+  } else {
+    table = info->tuning_table = gasneti_malloc(sizeof(gasnete_coll_autotune_table_t));
+  }
+  memset(table->first, 0, sizeof(table->first));
+  table->entries = NULL;
+
+  /* the node and thread counts are matched as search_index() always has */
+  if(temp) temp = search_intervals(temp, team->total_ranks, info->search_enabled);
+  if(temp && temp->subtree) temp = search_intervals(temp->subtree, team->my_images, info->search_enabled);
+  else temp = NULL;
+  if(!temp) return;
+
+  /* count the entries of each slot, then place them */
+  FOREACH_TUNING_LEAF(temp, slot, root_entry, size_entry, table->first[slot+1]++);
+  for(i=0; i<GASNETE_COLL_TUNING_TABLE_SLOTS; i++) {
+    fill[i] = table->first[i];
+    table->first[i+1] += table->first[i];
+  }
+  if(!table->first[GASNETE_COLL_TUNING_TABLE_SLOTS]) return;
+  table->entries = gasneti_malloc(table->first[GASNETE_COLL_TUNING_TABLE_SLOTS]*sizeof(gasnete_coll_autotune_table_entry_t));
+  FOREACH_TUNING_LEAF(temp, slot, root_entry, size_entry, {
+      gasnete_coll_autotune_table_entry_t *e = &table->entries[fill[slot]++];
+      e->key = GASNETE_COLL_TUNING_TABLE_KEY(root_entry->start, size_entry->start);
+      e->impl = size_entry->impl;
+    });
+  for(i=0; i<GASNETE_COLL_TUNING_TABLE_SLOTS; i++) {
+    qsort(table->entries + table->first[i], table->first[i+1] - table->first[i],
+          sizeof(gasnete_coll_autotune_table_entry_t), compare_table_entries);
+  }
+}
+#undef FOREACH_TUNING_LEAF
+
+/* Find the implementation for a collective in the team's tuning table.
+   Without search, the closest root and then the closest size at or below the
+   requested one are used (or the smallest, if there are none below).  With search
+   enabled the match must be exact, so that new cases get searched. */
+static
+gasnete_coll_implementation_t search_index(gasnet_coll_optype_t op, gasnete_coll_team_t team, uint32_t flags, size_t nbytes, gasnet_image_t rootimg) {
+  const gasnete_coll_autotune_table_t *table = team->autotune_info->tuning_table;
+  const int exact_match = team->autotune_info->search_enabled;
+  const gasnete_coll_autotune_table_entry_t *entries;
+  const uint32_t size = (uint32_t)MIN(nbytes, (size_t)INT_MAX); /* sizes in the index are ints */
+  uint32_t root, n;
+  int slot, i;
+
+  if(!table) return NULL;
+  slot = tuning_table_slot(get_syncmode_from_flags(flags), get_addrmode_from_flags(flags), op);
+  if(slot < 0) return NULL;
+  entries = table->entries + table->first[slot];
+  n = table->first[slot+1] - table->first[slot];
+  if(!n) return NULL;
+
+  /*lookup the root: the last one not above rootimg, else the first*/
+  i = table_last_le(entries, n, GASNETE_COLL_TUNING_TABLE_KEY(rootimg, 0xFFFFFFFF));
+  root = (uint32_t)(entries[MAX(i,0)].key >> 32);
+  if(exact_match && root != rootimg) return NULL;
+
+  /*approximate match for size is ok: the last one not above nbytes, else the root's first*/
+  i = table_last_le(entries, n, GASNETE_COLL_TUNING_TABLE_KEY(root, size));
+  if(i < 0 || (uint32_t)(entries[i].key >> 32) != root) i++;
+  if(exact_match && entries[i].key != GASNETE_COLL_TUNING_TABLE_KEY(root, size)) return NULL;
+  
+  return entries[i].impl;
 }
 
 static
@@ -2520,6 +2845,7 @@ int verify_algorithm(gasnete_coll_team_t team, gasnet_coll_optype_t op, uint32_t
 static gasnete_coll_implementation_t autotune_op(gasnet_team_handle_t team, gasnet_coll_optype_t op, gasnet_coll_args_t args, int flags GASNETE_THREAD_FARG) {
   gasnete_coll_implementation_t ret;
   gasnete_coll_threaddata_t *td = GASNETE_COLL_MYTHREAD;
+  size_t key_nbytes = args.nbytes;
   
   /* explicit request to not tune */
   if(flags & GASNET_COLL_DISABLE_AUTOTUNE) return NULL;
@@ -2535,6 +2861,14 @@ static gasnete_coll_implementation_t autotune_op(gasnet_team_handle_t team, gasn
   if(team == GASNET_TEAM_ALL && gasnete_coll_team_all_tuning_file && !team->autotune_info->autotuner_defaults) {
     gasnete_coll_loadTuningState(gasnete_coll_team_all_tuning_file, team GASNETE_THREAD_PASS);
   }
+  /*likewise for the tuning cache, which need not exist yet*/
+  if(team == GASNET_TEAM_ALL && gasnete_coll_team_all_tuning_cache) {
+    if(!gasnete_coll_team_all_cache_loaded) {
+      load_tuning_state(gasnete_coll_team_all_tuning_cache, team, 1 GASNETE_THREAD_PASS);
+    }
+    /*the cache is indexed by power-of-two size buckets, to bound the number of searches*/
+    key_nbytes = gasnete_coll_nextpower2(args.nbytes);
+  }
   
   if(td->my_local_image == 0  && team->autotune_info->profile_enabled) {
     gasnete_coll_autotune_index_entry_t *idx;
@@ -2543,7 +2877,7 @@ static gasnete_coll_implementation_t autotune_op(gasnet_team_handle_t team, gasn
   }
   
   if(team->autotune_info->autotuner_defaults  || team->autotune_info->search_enabled) {
-    ret = search_index(op, team, flags, args.nbytes, args.rootimg, team->autotune_info->search_enabled);  
+    ret = search_index(op, team, flags, key_nbytes, args.rootimg);  
     /*make sure the returned algortithm can handle the cases*/
     if(verify_algorithm(team, op, flags, args.nbytes, ret)) {
       if (ret->team == NULL) {
@@ -2623,8 +2957,12 @@ static gasnete_coll_implementation_t autotune_op(gasnet_team_handle_t team, gasn
     /*insert ret into the search index*/
     PTHREAD_BARRIER(team, team->my_images); 
     if(td->my_local_image == 0) {
-      idx = add_to_index(op, team, flags, args.nbytes, args.rootimg, 0);
+      idx = add_to_index(op, team, flags, key_nbytes, args.rootimg, 0);
       idx->impl = ret;
+      compile_tuning_table(team->autotune_info);
+      if(gasnete_coll_team_all_tuning_cache && team->myrank == 0) {
+        save_tuning_cache(gasnete_coll_team_all_tuning_cache, team);
+      }
     }
     
     PTHREAD_BARRIER(team, team->my_images); 
@@ -2700,6 +3038,12 @@ gasnete_coll_implementation_t gasnete_coll_autotune_get_bcast_algorithm(gasnet_t
         ret->fn_ptr = team->autotune_info->collective_algorithms[GASNET_COLL_BROADCAST_OP][GASNETE_COLL_BROADCAST_TREE_PUT].fn_ptr.bcast_fn;
         ret->fn_idx = GASNETE_COLL_BROADCAST_TREE_PUT;
       }
+    } else if(flags & GASNET_COLL_SINGLE) {
+      /* a single op pipelines the segments down the tree*/
+      ret->num_params = 1;
+      ret->param_list[0] = gasnete_coll_get_pipe_seg_size(team->autotune_info, GASNET_COLL_BROADCAST_OP, flags);  
+      ret->fn_ptr = team->autotune_info->collective_algorithms[GASNET_COLL_BROADCAST_OP][GASNETE_COLL_BROADCAST_TREE_PIPE].fn_ptr.bcast_fn;
+      ret->fn_idx = GASNETE_COLL_BROADCAST_TREE_PIPE;
     } else if(nbytes<=team->autotune_info->collective_algorithms[GASNET_COLL_BROADCAST_OP][GASNETE_COLL_BROADCAST_TREE_PUT_SEG].max_num_bytes) {
       ret->num_params = 1;
       ret->param_list[0] = gasnete_coll_get_pipe_seg_size(team->autotune_info, GASNET_COLL_BROADCAST_OP, flags);  
@@ -3477,6 +3821,144 @@ gasnete_coll_implementation_t gasnete_coll_autotune_get_reduceM_algorithm(gasnet
   return ret;
 }
 
+gasnete_coll_implementation_t gasnete_coll_autotune_get_reduce_all_algorithm(gasnet_team_handle_t team, void *dst, void *src,
+                                                                             size_t elem_size, size_t elem_count,
+                                                                             gasnet_coll_fn_handle_t func, int func_arg,
+                                                                             uint32_t flags GASNETE_THREAD_FARG){
+  gasnete_coll_implementation_t ret;
+  gasnete_coll_threaddata_t *td = GASNETE_COLL_MYTHREAD;
+  const size_t nbytes = elem_count * elem_size;
+  const int bfly_ok = gasnete_coll_reduce_butterfly_ok(team, func, 0);
+
+  {
+    gasnet_coll_args_t args = GASNET_COLL_ARGS_INITIALIZER;
+    args.dst = (uint8_t**)&dst;
+    args.src = (uint8_t**)&src;
+    args.rootimg = 0;
+    args.elem_size = elem_size;
+    args.nbytes = nbytes;
+    args.func = func;
+    args.func_arg = func_arg;
+    
+    /*first try to search our gasnet autotuner index to see if we have anything for it*/
+    ret = autotune_op(team, GASNET_COLL_REDUCE_ALL_OP, args, flags GASNETE_THREAD_PASS);
+    /*a tuned butterfly may not be valid for this reduction function*/
+    if(ret && (bfly_ok || ret->fn_idx == GASNETE_COLL_REDUCE_ALL_RED_BCAST)) return ret;
+    if(ret && ret->need_to_free) gasnete_coll_free_implementation(ret);
+  }
+  
+  ret = gasnete_coll_get_implementation();
+  ret->need_to_free = 1;
+  ret->num_params =0;
+  ret->team = team;
+  ret->flags = flags;
+  ret->optype = GASNET_COLL_REDUCE_ALL_OP;
+  
+  if(bfly_ok && nbytes <= GASNET_COLL_MIN_PIPE_SEG_SIZE && 
+     nbytes <= team->autotune_info->collective_algorithms[GASNET_COLL_REDUCE_ALL_OP][GASNETE_COLL_REDUCE_ALL_REC_DBL].max_num_bytes) {
+    ret->fn_idx = GASNETE_COLL_REDUCE_ALL_REC_DBL;
+  } else if(bfly_ok && 
+            nbytes <= team->autotune_info->collective_algorithms[GASNET_COLL_REDUCE_ALL_OP][GASNETE_COLL_REDUCE_ALL_RABENSEIFNER].max_num_bytes) {
+    ret->fn_idx = GASNETE_COLL_REDUCE_ALL_RABENSEIFNER;
+  } else {
+    ret->fn_idx = GASNETE_COLL_REDUCE_ALL_RED_BCAST;
+  }
+  ret->fn_ptr = team->autotune_info->collective_algorithms[GASNET_COLL_REDUCE_ALL_OP][ret->fn_idx].fn_ptr.reduce_all_fn;
+
+  if (gasnete_coll_print_coll_alg && td->my_image == 0) {
+    fprintf(stderr, "The algorithm for reduce_all is selected by the default logic.\n");
+    gasnete_coll_implementation_print(ret, stderr);
+  }
+  
+  return ret;
+}
+
+gasnete_coll_implementation_t gasnete_coll_autotune_get_reduce_scatter_algorithm(gasnet_team_handle_t team, void *dst, void *src,
+                                                                                 size_t elem_size, size_t elem_count,
+                                                                                 gasnet_coll_fn_handle_t func, int func_arg,
+                                                                                 uint32_t flags GASNETE_THREAD_FARG){
+  gasnete_coll_implementation_t ret;
+  gasnete_coll_threaddata_t *td = GASNETE_COLL_MYTHREAD;
+  const size_t nbytes = elem_count * elem_size;
+  const int bfly_ok = gasnete_coll_reduce_butterfly_ok(team, func, 0);
+  const int halv_ok = gasnete_coll_reduce_butterfly_ok(team, func, 1);
+
+  {
+    gasnet_coll_args_t args = GASNET_COLL_ARGS_INITIALIZER;
+    args.dst = (uint8_t**)&dst;
+    args.src = (uint8_t**)&src;
+    args.rootimg = 0;
+    args.elem_size = elem_size;
+    args.nbytes = nbytes;
+    args.func = func;
+    args.func_arg = func_arg;
+    
+    /*first try to search our gasnet autotuner index to see if we have anything for it*/
+    ret = autotune_op(team, GASNET_COLL_REDUCE_SCATTER_OP, args, flags GASNETE_THREAD_PASS);
+    /*a tuned butterfly may not be valid for this reduction function*/
+    if(ret && (ret->fn_idx == GASNETE_COLL_REDUCE_SCATTER_RED_SCAT ||
+               (ret->fn_idx == GASNETE_COLL_REDUCE_SCATTER_REC_HALV ? halv_ok : bfly_ok))) return ret;
+    if(ret && ret->need_to_free) gasnete_coll_free_implementation(ret);
+  }
+  
+  ret = gasnete_coll_get_implementation();
+  ret->need_to_free = 1;
+  ret->num_params =0;
+  ret->team = team;
+  ret->flags = flags;
+  ret->optype = GASNET_COLL_REDUCE_SCATTER_OP;
+  
+  if(halv_ok && 
+     nbytes <= team->autotune_info->collective_algorithms[GASNET_COLL_REDUCE_SCATTER_OP][GASNETE_COLL_REDUCE_SCATTER_REC_HALV].max_num_bytes) {
+    ret->fn_idx = GASNETE_COLL_REDUCE_SCATTER_REC_HALV;
+  } else if(bfly_ok && nbytes*team->total_ranks <= GASNET_COLL_MIN_PIPE_SEG_SIZE &&
+            nbytes <= team->autotune_info->collective_algorithms[GASNET_COLL_REDUCE_SCATTER_OP][GASNETE_COLL_REDUCE_SCATTER_REC_DBL].max_num_bytes) {
+    ret->fn_idx = GASNETE_COLL_REDUCE_SCATTER_REC_DBL;
+  } else {
+    ret->fn_idx = GASNETE_COLL_REDUCE_SCATTER_RED_SCAT;
+  }
+  ret->fn_ptr = team->autotune_info->collective_algorithms[GASNET_COLL_REDUCE_SCATTER_OP][ret->fn_idx].fn_ptr.reduce_scatter_fn;
+
+  if (gasnete_coll_print_coll_alg && td->my_image == 0) {
+    fprintf(stderr, "The algorithm for reduce_scatter is selected by the default logic.\n");
+    gasnete_coll_implementation_print(ret, stderr);
+  }
+  
+  return ret;
+}
+
+gasnete_coll_implementation_t gasnete_coll_autotune_get_exchangev_algorithm(gasnet_team_handle_t team, void *dst, void *src,
+                                                                            size_t max_nbytes, uint32_t flags GASNETE_THREAD_FARG){
+  gasnete_coll_implementation_t ret;
+  gasnete_coll_threaddata_t *td = GASNETE_COLL_MYTHREAD;
+  
+  /* exchangev is not searched by the autotuner: a tuning run would have to
+     invent the per-image counts, so the default logic below always applies*/
+  ret = gasnete_coll_get_implementation();
+  ret->need_to_free = 1;
+  ret->num_params =0;
+  ret->team = team;
+  ret->flags = flags;
+  ret->optype = GASNET_COLL_EXCHANGEV_OP;
+  
+  if(max_nbytes <= gasnete_coll_get_dissem_limit(team->autotune_info, GASNET_COLL_EXCHANGE_OP, flags) &&
+     max_nbytes <= team->autotune_info->collective_algorithms[GASNET_COLL_EXCHANGEV_OP][GASNETE_COLL_EXCHANGEV_DISSEM].max_num_bytes) {
+    ret->fn_idx = GASNETE_COLL_EXCHANGEV_DISSEM;
+  } else if(flags & GASNET_COLL_DST_IN_SEGMENT) {
+    ret->fn_idx = GASNETE_COLL_EXCHANGEV_PUT;
+  } else {
+    ret->fn_idx = GASNETE_COLL_EXCHANGEV_CHUNKED;
+  }
+  ret->fn_ptr = team->autotune_info->collective_algorithms[GASNET_COLL_EXCHANGEV_OP][ret->fn_idx].fn_ptr.exchangev_fn;
+
+  if (gasnete_coll_print_coll_alg && td->my_image == 0) {
+    fprintf(stderr, "The algorithm for exchangev is selected by the default logic.\n");
+    gasnete_coll_implementation_print(ret, stderr);
+  }
+  
+  return ret;
+}
+
 
 static void dump_tuning_state_helper(myxml_node_t *parent, gasnete_coll_autotune_index_entry_t *tuning_root) {
   gasnete_coll_autotune_index_entry_t *temp=tuning_root;
@@ -3504,7 +3986,12 @@ static void dump_tuning_state_helper(myxml_node_t *parent, gasnete_coll_autotune
       gasnete_coll_implementation_t impl = temp->impl;
       
       gasneti_assert(impl);
-      gasnete_coll_tree_type_to_str(buffer, impl->tree_type);
+      /* algorithms without a tree shape parameter have no tree_type */
+      if(impl->tree_type) {
+        gasnete_coll_tree_type_to_str(buffer, impl->tree_type);
+      } else {
+        buffer[0] = '\0';
+      }
       /* fn_idx number goes first so that a later atoi() when reading the xml file would work. */
       sprintf(tempbuffer, "%d (%s)", impl->fn_idx,
               impl->team->autotune_info->collective_algorithms[impl->optype][impl->fn_idx].name_str);
@@ -3527,14 +4014,18 @@ static void dump_tuning_state_helper(myxml_node_t *parent, gasnete_coll_autotune
 }
 
 
+static void dump_tuning_state(FILE *outstream, gasnete_coll_team_t team) {
+  myxml_node_t *node = myxml_createNode(NULL, (char*) "machine", (char*)"CONFIG", (char*) GASNET_CONFIG_STRING, NULL);
+  dump_tuning_state_helper(node, team->autotune_info->autotuner_defaults);
+  myxml_printTreeBIN(outstream, node);
+}
+
 void gasnete_coll_dumpTuningState(char *filename, gasnete_coll_team_t team GASNETE_THREAD_FARG) {
-  myxml_node_t *node;
   gasnete_coll_threaddata_t *td = GASNETE_COLL_MYTHREAD;
   gasnet_image_t myrank = (team == GASNET_TEAM_ALL ? td->my_image : team->myrank);
 
   if(myrank==0 && team->autotune_info->search_enabled) {
     FILE *outstream;
-    node = myxml_createNode(NULL, (char*) "machine", (char*)"CONFIG", (char*) GASNET_CONFIG_STRING, NULL);
     
     if(!filename) {
       if(team!=GASNET_TEAM_ALL) {fprintf(stderr, "WARNING: printing tuning output to default filename is not recommended for non-TEAM-ALL teams\n");}
@@ -3547,12 +4038,32 @@ void gasnete_coll_dumpTuningState(char *filename, gasnete_coll_team_t team GASNE
                          filename ? filename : "gasnet_coll_tuning_defaults.bin");
     }
 
-    dump_tuning_state_helper(node, team->autotune_info->autotuner_defaults);
-    myxml_printTreeBIN(outstream, node);
+    dump_tuning_state(outstream, team);
     fclose(outstream);
   }
 }
 
+/* Rewrite the tuning cache.  Since jobs may share a cache, it is written to a
+ * temporary file and renamed into place, so readers never see a partial file.
+ * Failure is not fatal: the job just runs without persisting its results. */
+static void save_tuning_cache(const char *filename, gasnete_coll_team_t team) {
+  char *tmpname = gasneti_malloc(strlen(filename) + 32);
+  FILE *outstream;
+
+  sprintf(tmpname, "%s.tmp%lu", filename, (unsigned long)getpid());
+  outstream = fopen(tmpname, "wb");
+  if (outstream == NULL) {
+    GASNETI_TRACE_PRINTF(C,("unable to write collective tuning cache %s: %s", tmpname, strerror(errno)));
+  } else {
+    dump_tuning_state(outstream, team);
+    if (fclose(outstream) || rename(tmpname, filename)) {
+      GASNETI_TRACE_PRINTF(C,("unable to update collective tuning cache %s: %s", filename, strerror(errno)));
+      (void)unlink(tmpname);
+    }
+  }
+  gasneti_free(tmpname);
+}
+
 static void dump_profile_helper(myxml_node_t *parent, gasnete_coll_autotune_index_entry_t *tuning_root) {
   gasnete_coll_autotune_index_entry_t *temp=tuning_root;
   while(temp!=NULL) {
@@ -3604,13 +4115,19 @@ void gasnete_coll_dumpProfile(char *filename, gasnete_coll_team_t team GASNETE_T
   }
 }
 
-void gasnete_coll_loadTuningState(char *filename, gasnete_coll_team_t team GASNETE_THREAD_FARG) {
+/* Collectively load tuning data, which rank 0 reads from the file and broadcasts.
+ * A missing, empty or foreign (written by a different GASNet configuration)
+ * tuning cache is not an error: the team just starts with no tuning data. */
+static void load_tuning_state(const char *filename, gasnete_coll_team_t team, int is_cache GASNETE_THREAD_FARG) {
   gasnete_coll_threaddata_t *td = GASNETE_COLL_MYTHREAD;
   myxml_node_t *nodes;
   gasnet_image_t myrank = team->myrank;
   
   PTHREAD_BARRIER(team, team->my_images);
   if(td->my_local_image == 0) {
+    size_t nbytes;
+    char *buffer;
+
     if(myrank == 0) {
       FILE *instream;
       myxml_bytestream_t file_content;
@@ -3623,33 +4140,55 @@ void gasnete_coll_loadTuningState(char *filename, gasnete_coll_team_t team GASNE
       }
       
       /*load the tuning file into a bytestream*/
-      if(instream == NULL) {
+      if(instream != NULL) {
+        file_content = myxml_loadFile_into_bytestream(instream);
+        fclose(instream);
+      } else if(is_cache) {
+        file_content.bytes = NULL;
+        file_content.size = 0;
+      } else {
         gasneti_fatalerror("gasnete_coll_loadTuningState() failed to open the tuning file %s!\n",
                            filename ? filename : "gasnet_coll_tuning_defaults.bin");
       }
-      file_content = myxml_loadFile_into_bytestream(instream);
+      nbytes = file_content.size;
+      buffer = file_content.bytes;
       
       /*initiate a broadcast to all the other nodes*/
-      gasnete_coll_safe_broadcast(team, &file_content.size, &file_content.size, 0, sizeof(size_t), 1 GASNETE_THREAD_PASS);
-      gasnete_coll_safe_broadcast(team, file_content.bytes, file_content.bytes, 0, file_content.size, 1 GASNETE_THREAD_PASS);
-      nodes = myxml_loadTreeBYTESTREAM(file_content.bytes, file_content.size);
-      team->autotune_info->autotuner_defaults = gasnete_coll_load_autotuner_defaults(team->autotune_info, nodes);
+      gasnete_coll_safe_broadcast(team, &nbytes, &nbytes, 0, sizeof(size_t), 1 GASNETE_THREAD_PASS);
+      if(nbytes) {
+        gasnete_coll_safe_broadcast(team, buffer, buffer, 0, nbytes, 1 GASNETE_THREAD_PASS);
+      }
     } else {
-      size_t nbytes;
-      char *buffer;
       /*receive the file size*/
       gasnete_coll_safe_broadcast(team, &nbytes, NULL, 0, sizeof(size_t), 1 GASNETE_THREAD_PASS);
       buffer = gasneti_malloc(sizeof(char)*nbytes);
       /*receive the file contents*/
-      gasnete_coll_safe_broadcast(team, buffer, NULL, 0, sizeof(char)*nbytes, 1 GASNETE_THREAD_PASS);
+      if(nbytes) {
+        gasnete_coll_safe_broadcast(team, buffer, NULL, 0, sizeof(char)*nbytes, 1 GASNETE_THREAD_PASS);
+      }
+    }
+
+    if(nbytes) {
       nodes = myxml_loadTreeBYTESTREAM(buffer, nbytes);
-      team->autotune_info->autotuner_defaults = gasnete_coll_load_autotuner_defaults(team->autotune_info, nodes);
+      if(is_cache && !(STRINGS_MATCH(MYXML_TAG(nodes), "machine") &&
+                       STRINGS_MATCH(MYXML_ATTRIBUTES(nodes)[0].attribute_value, GASNET_CONFIG_STRING))) {
+        /* results from another conduit or build are not reused, and will be overwritten */
+        GASNETI_TRACE_PRINTF(C,("ignoring collective tuning cache %s from another GASNet configuration", filename));
+      } else {
+        team->autotune_info->autotuner_defaults = gasnete_coll_load_autotuner_defaults(team->autotune_info, nodes);
+        compile_tuning_table(team->autotune_info);
+      }
     }
+    if(is_cache) gasnete_coll_team_all_cache_loaded = 1;
   }
   PTHREAD_BARRIER(team, team->my_images);
   
 }
 
+void gasnete_coll_loadTuningState(char *filename, gasnete_coll_team_t team GASNETE_THREAD_FARG) {
+  load_tuning_state(filename, team, 0 GASNETE_THREAD_PASS);
+}
+
 void gasnete_coll_implementation_print(gasnete_coll_implementation_t impl, FILE *fp)
 {
   int i;
@@ -137,6 +137,15 @@ typedef gasnet_coll_handle_t
                                     uint32_t sequence
                                     GASNETE_THREAD_FARG);
 
+typedef gasnet_coll_handle_t
+(*gasnete_coll_exchangev_fn_ptr_t)(gasnet_team_handle_t team,
+                                   void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                                   void *src, const size_t src_counts[], const size_t src_offsets[],
+                                   size_t max_nbytes, int flags, 
+                                   gasnete_coll_implementation_t coll_params,
+                                   uint32_t sequence
+                                   GASNETE_THREAD_FARG);
+
 typedef gasnet_coll_handle_t
 (*gasnete_coll_exchangeM_fn_ptr_t)(gasnet_team_handle_t team,
                                    void * const dstlist[], void * const srclist[],
@@ -167,6 +176,26 @@ typedef gasnet_coll_handle_t
                                   uint32_t sequence
                                   GASNETE_THREAD_FARG);
 
+typedef gasnet_coll_handle_t 
+(*gasnete_coll_reduce_all_fn_ptr_t)(gasnet_team_handle_t team,
+                                    void *dst, void *src,
+                                    size_t elem_size, size_t elem_count,
+                                    gasnet_coll_fn_handle_t func, int func_arg,
+                                    int flags, 
+                                    gasnete_coll_implementation_t coll_params,
+                                    uint32_t sequence
+                                    GASNETE_THREAD_FARG);
+
+typedef gasnet_coll_handle_t 
+(*gasnete_coll_reduce_scatter_fn_ptr_t)(gasnet_team_handle_t team,
+                                        void *dst, void *src,
+                                        size_t elem_size, size_t elem_count,
+                                        gasnet_coll_fn_handle_t func, int func_arg,
+                                        int flags, 
+                                        gasnete_coll_implementation_t coll_params,
+                                        uint32_t sequence
+                                        GASNETE_THREAD_FARG);
+
 typedef enum {GASNETE_COLL_BROADCAST_GET=0, 
   GASNETE_COLL_BROADCAST_PUT,
   GASNETE_COLL_BROADCAST_TREE_PUT,
@@ -178,6 +207,11 @@ typedef enum {GASNETE_COLL_BROADCAST_GET=0,
   GASNETE_COLL_BROADCAST_RVOUS,
   GASNETE_COLL_BROADCAST_RVGET,
   GASNETE_COLL_BROADCAST_TREE_RVGET,
+  GASNETE_COLL_BROADCAST_TREE_PIPE,
+#if GASNET_PSHM
+  GASNETE_COLL_BROADCAST_SN_PUT,
+  GASNETE_COLL_BROADCAST_SMP_PSHM_TREE_FLAG,
+#endif
 #ifdef GASNETE_COLL_CONDUIT_BROADCAST_OPS
   /*check to see if the conduits have defined any new ops*/
   GASNETE_COLL_CONDUIT_BROADCAST_OPS ,
@@ -242,6 +276,9 @@ typedef enum {
   GASNETE_COLL_GATHER_EAGER,
   GASNETE_COLL_GATHER_RVPUT,
   GASNETE_COLL_GATHER_RVOUS,
+#if GASNET_PSHM
+  GASNETE_COLL_GATHER_SN_EAGER,
+#endif
 #ifdef GASNETE_COLL_CONDUIT_GATHER_OPS
   GASNETE_COLL_CONDUIT_GATHER_OPS ,
 #endif
@@ -296,11 +333,24 @@ typedef enum {
   GASNETE_COLL_EXCHANGE_PUT,
   GASNETE_COLL_EXCHANGE_RVPUT,
   GASNETE_COLL_EXCHANGE_GATH,
+#if GASNET_PSHM
+  GASNETE_COLL_EXCHANGE_SN_EAGER,
+  GASNETE_COLL_EXCHANGE_SMP_PSHM_PUT,
+#endif
 #ifdef GASNETE_COLL_CONDUIT_EXCHANGE_OPS
   GASNETE_COLL_CONDUIT_EXCHANGE_OPS ,
 #endif
   GASNETE_COLL_EXCHANGE_NUM_ALGS} gasnete_coll_exchange_alg_types_t;
 
+typedef enum {
+  GASNETE_COLL_EXCHANGEV_DISSEM=0,
+  GASNETE_COLL_EXCHANGEV_CHUNKED,
+  GASNETE_COLL_EXCHANGEV_PUT,
+#ifdef GASNETE_COLL_CONDUIT_EXCHANGEV_OPS
+  GASNETE_COLL_CONDUIT_EXCHANGEV_OPS ,
+#endif
+  GASNETE_COLL_EXCHANGEV_NUM_ALGS} gasnete_coll_exchangev_alg_types_t;
+
 typedef enum {
   GASNETE_COLL_EXCHANGEM_DISSEM2=0,
   GASNETE_COLL_EXCHANGEM_DISSEM3,
@@ -326,6 +376,9 @@ typedef enum {
   GASNETE_COLL_REDUCE_TREE_PUT,
   GASNETE_COLL_REDUCE_TREE_PUT_SEG,
   GASNETE_COLL_REDUCE_TREE_GET,
+#if GASNET_PSHM
+  GASNETE_COLL_REDUCE_SN_EAGER,
+#endif
 #ifdef GASNETE_COLL_CONDUIT_REDUCE_OPS
   GASNETE_COLL_CONDUIT_REDUCE_OPS ,
 #endif
@@ -343,6 +396,26 @@ typedef enum {
   
   GASNETE_COLL_REDUCEM_NUM_ALGS} gasnete_coll_reduceM_alg_types_t;
 
+typedef enum {
+  GASNETE_COLL_REDUCE_ALL_RED_BCAST=0,
+  GASNETE_COLL_REDUCE_ALL_REC_DBL,
+  GASNETE_COLL_REDUCE_ALL_RABENSEIFNER,
+#ifdef GASNETE_COLL_CONDUIT_REDUCE_ALL_OPS
+  GASNETE_COLL_CONDUIT_REDUCE_ALL_OPS ,
+#endif
+  
+  GASNETE_COLL_REDUCE_ALL_NUM_ALGS} gasnete_coll_reduce_all_alg_types_t;
+
+typedef enum {
+  GASNETE_COLL_REDUCE_SCATTER_RED_SCAT=0,
+  GASNETE_COLL_REDUCE_SCATTER_REC_DBL,
+  GASNETE_COLL_REDUCE_SCATTER_REC_HALV,
+#ifdef GASNETE_COLL_CONDUIT_REDUCE_SCATTER_OPS
+  GASNETE_COLL_CONDUIT_REDUCE_SCATTER_OPS ,
+#endif
+  
+  GASNETE_COLL_REDUCE_SCATTER_NUM_ALGS} gasnete_coll_reduce_scatter_alg_types_t;
+
 #ifndef GASNET_COLL_MIN_PIPE_SEG_SIZE
 #define GASNET_COLL_MIN_PIPE_SEG_SIZE 8192
 #endif
@@ -424,8 +497,11 @@ typedef struct gasnete_coll_allgorithm_t_ {
     gasnete_coll_gather_allM_fn_ptr_t gather_allM_fn;
     gasnete_coll_exchange_fn_ptr_t exchange_fn;
     gasnete_coll_exchangeM_fn_ptr_t exchangeM_fn;
+    gasnete_coll_exchangev_fn_ptr_t exchangev_fn;
     gasnete_coll_reduce_fn_ptr_t reduce_fn;
     gasnete_coll_reduceM_fn_ptr_t reduceM_fn;
+    gasnete_coll_reduce_all_fn_ptr_t reduce_all_fn;
+    gasnete_coll_reduce_scatter_fn_ptr_t reduce_scatter_fn;
   } fn_ptr;
   
   const char *name_str;
@@ -452,6 +528,23 @@ struct gasnete_coll_autotune_index_entry_t_ {
 
 typedef struct gasnete_coll_autotune_index_entry_t_ gasnete_coll_autotune_index_entry_t;
 
+/* Lookup table compiled from autotuner_defaults for one team.  The node and
+   thread counts are fixed for a team and are resolved when the table is built.
+   The remaining exact-match levels (sync mode, address mode, collective) index
+   directly into slots.  The entries of slot i are entries[first[i]..first[i+1]),
+   sorted by (root, size). */
+#define GASNETE_COLL_TUNING_TABLE_SLOTS (GASNETE_COLL_NUM_SYNCMODES*GASNETE_COLL_NUM_ADDRMODES*GASNET_COLL_NUM_COLL_OPTYPES)
+#define GASNETE_COLL_TUNING_TABLE_KEY(root, size) (((uint64_t)(uint32_t)(root) << 32) | (uint32_t)(size))
+typedef struct {
+  uint64_t key; /* GASNETE_COLL_TUNING_TABLE_KEY(root, size) */
+  gasnete_coll_implementation_t impl;
+} gasnete_coll_autotune_table_entry_t;
+
+typedef struct {
+  uint32_t first[GASNETE_COLL_TUNING_TABLE_SLOTS+1];
+  gasnete_coll_autotune_table_entry_t *entries;
+} gasnete_coll_autotune_table_t;
+
 struct gasnete_coll_autotune_info_t_ {
   gasnete_coll_tree_type_t bcast_tree_type;
   gasnete_coll_tree_type_t scatter_tree_type;
@@ -473,6 +566,8 @@ struct gasnete_coll_autotune_info_t_ {
   gasnete_coll_algorithm_t *collective_algorithms[GASNET_COLL_NUM_COLL_OPTYPES];
   gasnete_coll_autotune_index_entry_t *autotuner_defaults;
   gasnete_coll_autotune_index_entry_t *collective_profile;
+  /* autotuner_defaults compiled for lookup, rebuilt whenever it changes */
+  gasnete_coll_autotune_table_t *tuning_table;
   gasnete_coll_team_t team;
   int search_enabled;
   int profile_enabled;
@@ -548,6 +643,10 @@ gasnete_coll_implementation_t
 gasnete_coll_autotune_get_exchange_algorithm(gasnet_team_handle_t team, void *dst, void *src, 
                                              size_t nbytes, uint32_t flags  GASNETE_THREAD_FARG);
 
+gasnete_coll_implementation_t 
+gasnete_coll_autotune_get_exchangev_algorithm(gasnet_team_handle_t team, void *dst, void *src, 
+                                              size_t max_nbytes, uint32_t flags  GASNETE_THREAD_FARG);
+
 gasnete_coll_implementation_t 
 gasnete_coll_autotune_get_exchangeM_algorithm(gasnet_team_handle_t team, void * const dstlist[], void * const srclist[], 
                                               size_t nbytes, uint32_t flags  GASNETE_THREAD_FARG);
@@ -566,6 +665,18 @@ gasnete_coll_autotune_get_reduceM_algorithm(gasnet_team_handle_t team, gasnet_im
                                             gasnet_coll_fn_handle_t func, int func_arg,
                                             uint32_t flags GASNETE_THREAD_FARG);
 
+gasnete_coll_implementation_t
+gasnete_coll_autotune_get_reduce_all_algorithm(gasnet_team_handle_t team, void *dst, void *src,
+                                               size_t elem_size, size_t elem_count,
+                                               gasnet_coll_fn_handle_t func, int func_arg,
+                                               uint32_t flags GASNETE_THREAD_FARG);
+
+gasnete_coll_implementation_t
+gasnete_coll_autotune_get_reduce_scatter_algorithm(gasnet_team_handle_t team, void *dst, void *src,
+                                                   size_t elem_size, size_t elem_count,
+                                                   gasnet_coll_fn_handle_t func, int func_arg,
+                                                   uint32_t flags GASNETE_THREAD_FARG);
+
 
 
 gasnete_coll_implementation_t gasnete_coll_lookup_implementation(gasnete_coll_autotune_info_t* autotune_info, 
@@ -855,6 +855,127 @@ GASNETE_COLL_DECLARE_GATHER_ALG(TreeEager)
 }
 
 
+#if GASNET_PSHM
+/* gath SNEager: hierarchical eager gather over supernodes */
+/* Every rank signals the "head" of its supernode (the root in the root's supernode,
+   otherwise the leader) on entry.  The head reads the members' src directly through
+   the cross-mapped segments and sends them to the root in one eager put per
+   supernode, after which it releases the members (whose src has then been read). */
+/* Valid for SINGLE with SRC_IN_SEGMENT, size <= available eager buffer space */
+/* Requires GASNETE_COLL_GENERIC_OPT_P2P on all nodes */
+static int gasnete_coll_pf_gath_SNEager(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  const gasnete_coll_gather_args_t *args = GASNETE_COLL_GENERIC_ARGS(data, gather);
+  const gasnet_node_t * const ranks = op->team->supernode_grps.ranks;
+  const gasnet_node_t * const first = op->team->supernode_grps.first;
+  const gasnet_node_t mygrp = op->team->supernode_grps.grp_of[op->team->myrank];
+  const gasnet_node_t head = (mygrp == op->team->supernode_grps.grp_of[args->dstnode])
+                                ? args->dstnode : ranks[first[mygrp]];
+  const int member_count = first[mygrp+1] - first[mygrp];
+  int result = 0;
+  
+  switch (data->state) {
+    case 0:	/* Optional IN barrier */
+      if (!gasnete_coll_generic_all_threads(data) ||
+          !gasnete_coll_generic_insync(op->team, data)) {
+        break;
+      }
+      if (op->team->myrank != head) {
+        gasnete_coll_p2p_advance(op, GASNETE_COLL_REL2ACT(op->team, head), 0);
+      }
+      data->state = 1;
+      
+    case 1:	/* Collect the contributions of my supernode */
+      if (op->team->myrank == head) {
+        size_t nbytes = args->nbytes;
+        int i;
+        
+        if (gasneti_weakatomic_read(&data->p2p->counter[0], 0) != (member_count - 1)) {
+          break;
+        }
+        gasneti_sync_reads();
+        if (op->team->myrank == args->dstnode) {
+          for (i = first[mygrp]; i < first[mygrp+1]; ++i) {
+            const gasnet_node_t node = GASNETE_COLL_REL2ACT(op->team, ranks[i]);
+            GASNETE_FAST_UNALIGNED_MEMCPY_CHECK(gasnete_coll_scale_ptr(args->dst, ranks[i], nbytes),
+                                                gasneti_pshm_addr2local(node, args->src), nbytes);
+            data->p2p->state[i] = 2;
+          }
+        } else {
+          uint8_t *tmp = gasneti_malloc(member_count * nbytes);
+          for (i = first[mygrp]; i < first[mygrp+1]; ++i) {
+            const gasnet_node_t node = GASNETE_COLL_REL2ACT(op->team, ranks[i]);
+            GASNETE_FAST_UNALIGNED_MEMCPY(tmp + (i - first[mygrp]) * nbytes,
+                                          gasneti_pshm_addr2local(node, args->src), nbytes);
+          }
+          gasnete_coll_p2p_eager_putM(op, GASNETE_COLL_REL2ACT(op->team, args->dstnode), tmp,
+                                      member_count, nbytes, first[mygrp], 1);
+          gasneti_free(tmp);
+        }
+        for (i = first[mygrp]; i < first[mygrp+1]; ++i) {
+          if (ranks[i] == op->team->myrank) continue;
+          gasnete_coll_p2p_advance(op, GASNETE_COLL_REL2ACT(op->team, ranks[i]), 1);
+        }
+      }
+      data->state = 2;
+      
+    case 2:	/* Complete data movement */
+      if (op->team->myrank == args->dstnode) {
+        volatile uint32_t *state = data->p2p->state;
+        uintptr_t src_addr = (uintptr_t)(data->p2p->data);
+        size_t nbytes = args->nbytes;
+        int i, done = 1;
+        
+        for (i = 0; i < op->team->total_ranks; ++i, src_addr += nbytes) {
+          uint32_t s = state[i];
+          
+          if (s == 0) {
+            /* Nothing received yet */
+            done = 0;
+          } else if (s == 1) {
+            /* Received but not yet copied into place */
+            gasneti_sync_reads();
+            GASNETE_FAST_UNALIGNED_MEMCPY(gasnete_coll_scale_ptr(args->dst, ranks[i], nbytes),
+                                          (void *)src_addr, nbytes);
+            state[i] = 2;
+          }
+        }
+        
+        if (!done) { break; }
+      } else if (op->team->myrank != head) {
+        /* Wait until the head has read my src */
+        if (gasneti_weakatomic_read(&data->p2p->counter[1], 0) == 0) {
+          break;
+        }
+      }
+      data->state = 3;
+      
+    case 3:	/* Optional OUT barrier */
+      if (!gasnete_coll_generic_outsync(op->team, data)) {
+        break;
+      }
+      
+      gasnete_coll_generic_free(op->team, data GASNETE_THREAD_PASS);
+      result = (GASNETE_COLL_OP_COMPLETE | GASNETE_COLL_OP_INACTIVE);
+  }
+  
+  return result;
+}
+
+GASNETE_COLL_DECLARE_GATHER_ALG(SNEager)
+{
+  int options = GASNETE_COLL_GENERIC_OPT_INSYNC_IF (flags & GASNET_COLL_IN_ALLSYNC) |
+  GASNETE_COLL_GENERIC_OPT_OUTSYNC_IF(flags & GASNET_COLL_OUT_ALLSYNC)|
+  GASNETE_COLL_GENERIC_OPT_P2P;
+  
+  gasneti_assert(flags & GASNET_COLL_SINGLE);
+  gasneti_assert(flags & GASNET_COLL_SRC_IN_SEGMENT);
+  return gasnete_coll_generic_gather_nb(team, dstimage, dst, src, nbytes, dist, flags,
+                                        &gasnete_coll_pf_gath_SNEager, options,
+                                        NULL, sequence, coll_params->num_params, coll_params->param_list GASNETE_THREAD_PASS);
+}
+#endif
+
 /*---------------------------------------------------------------------------------*/
 /* gasnete_coll_gatherM_nb() */
 
@@ -1409,6 +1530,151 @@ GASNETE_COLL_DECLARE_GATHER_ALLM_ALG(EagerDissem)
 /*---------------------------------------------------------------------------------*/
 /* gasnete_coll_exchange_nb() */
 
+#if GASNET_PSHM
+/* exchg SNEager: hierarchical eager exchange over supernodes */
+/* Every rank signals the leader of its supernode on entry.  The leader then moves
+   the blocks exchanged within its supernode directly through the cross-mapped
+   segments, and sends each other leader one eager put holding, for each of its
+   members, the blocks destined to that supernode.  Blocks received this way are
+   copied into the members' dst before the leader releases them. */
+/* Valid for SINGLE with SRC_IN_SEGMENT and DST_IN_SEGMENT, */
+/* size * (largest supernode) <= available eager buffer space */
+/* Requires GASNETE_COLL_GENERIC_OPT_P2P on all nodes */
+static int gasnete_coll_pf_exchg_SNEager(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  const gasnete_coll_exchange_args_t *args = GASNETE_COLL_GENERIC_ARGS(data, exchange);
+  const gasnet_node_t * const ranks = op->team->supernode_grps.ranks;
+  const gasnet_node_t * const first = op->team->supernode_grps.first;
+  const gasnet_node_t mygrp = op->team->supernode_grps.grp_of[op->team->myrank];
+  const gasnet_node_t leader = ranks[first[mygrp]];
+  const int member_count = first[mygrp+1] - first[mygrp];
+  int result = 0;
+  
+  switch (data->state) {
+    case 0:	/* Optional IN barrier */
+      if (!gasnete_coll_generic_all_threads(data) ||
+          !gasnete_coll_generic_insync(op->team, data)) {
+        break;
+      }
+      if (op->team->myrank != leader) {
+        gasnete_coll_p2p_advance(op, GASNETE_COLL_REL2ACT(op->team, leader), 0);
+      }
+      data->state = 1;
+      
+    case 1:	/* Initiate data movement */
+      if (op->team->myrank == leader) {
+        size_t nbytes = args->nbytes;
+        uint8_t *tmp;
+        int g, i, j;
+        
+        if (gasneti_weakatomic_read(&data->p2p->counter[0], 0) != (member_count - 1)) {
+          break;
+        }
+        gasneti_sync_reads();
+        
+        /* Exchange within my supernode */
+        for (i = first[mygrp]; i < first[mygrp+1]; ++i) {
+          const gasnet_node_t src_node = GASNETE_COLL_REL2ACT(op->team, ranks[i]);
+          for (j = first[mygrp]; j < first[mygrp+1]; ++j) {
+            const gasnet_node_t dst_node = GASNETE_COLL_REL2ACT(op->team, ranks[j]);
+            GASNETE_FAST_UNALIGNED_MEMCPY_CHECK(
+                gasneti_pshm_addr2local(dst_node, gasnete_coll_scale_ptr(args->dst, ranks[i], nbytes)),
+                gasneti_pshm_addr2local(src_node, gasnete_coll_scale_ptr(args->src, ranks[j], nbytes)),
+                nbytes);
+          }
+        }
+        
+        /* One row per member of my supernode for each of the others */
+        tmp = gasneti_malloc(member_count * op->team->supernode_grps.max_count * nbytes);
+        for (g = 0; g < op->team->supernode.grp_count; ++g) {
+          const int count = first[g+1] - first[g];
+          uint8_t *p = tmp;
+          if (g == mygrp) continue;
+          for (i = first[mygrp]; i < first[mygrp+1]; ++i) {
+            const gasnet_node_t src_node = GASNETE_COLL_REL2ACT(op->team, ranks[i]);
+            for (j = first[g]; j < first[g+1]; ++j, p += nbytes) {
+              GASNETE_FAST_UNALIGNED_MEMCPY(p,
+                  gasneti_pshm_addr2local(src_node, gasnete_coll_scale_ptr(args->src, ranks[j], nbytes)),
+                  nbytes);
+            }
+          }
+          gasnete_coll_p2p_eager_putM(op, GASNETE_COLL_REL2ACT(op->team, ranks[first[g]]), tmp,
+                                      member_count, count * nbytes, first[mygrp], 1);
+        }
+        gasneti_free(tmp);
+      }
+      data->state = 2;
+      
+    case 2:	/* Complete data movement */
+      if (op->team->myrank == leader) {
+        volatile uint32_t *state = data->p2p->state;
+        const size_t nbytes = args->nbytes;
+        const size_t row_size = member_count * nbytes;
+        int i, j, done = 1;
+        
+        for (i = 0; i < op->team->total_ranks; ++i) {
+          if ((i >= first[mygrp]) && (i < first[mygrp+1])) {
+            /* My own supernode was handled directly */
+            continue;
+          }
+          if (state[i] == 0) {
+            /* Nothing received yet */
+            done = 0;
+          } else if (state[i] == 1) {
+            /* Received but not yet copied into place */
+            const uint8_t *row = (uint8_t *)data->p2p->data + i * row_size;
+            gasneti_sync_reads();
+            for (j = first[mygrp]; j < first[mygrp+1]; ++j, row += nbytes) {
+              const gasnet_node_t dst_node = GASNETE_COLL_REL2ACT(op->team, ranks[j]);
+              GASNETE_FAST_UNALIGNED_MEMCPY(
+                  gasneti_pshm_addr2local(dst_node, gasnete_coll_scale_ptr(args->dst, ranks[i], nbytes)),
+                  row, nbytes);
+            }
+            state[i] = 2;
+          }
+        }
+        
+        if (!done) { break; }
+        gasneti_sync_writes();
+        for (j = first[mygrp] + 1; j < first[mygrp+1]; ++j) {
+          gasnete_coll_p2p_advance(op, GASNETE_COLL_REL2ACT(op->team, ranks[j]), 1);
+        }
+      } else {
+        /* Wait until the leader has read my src and filled my dst */
+        if (gasneti_weakatomic_read(&data->p2p->counter[1], 0) == 0) {
+          break;
+        }
+        gasneti_sync_reads();
+      }
+      data->state = 3;
+      
+    case 3:	/* Optional OUT barrier */
+      if (!gasnete_coll_generic_outsync(op->team, data)) {
+        break;
+      }
+      
+      gasnete_coll_generic_free(op->team, data GASNETE_THREAD_PASS);
+      result = (GASNETE_COLL_OP_COMPLETE | GASNETE_COLL_OP_INACTIVE);
+  }
+  
+  return result;
+}
+
+GASNETE_COLL_DECLARE_EXCHANGE_ALG(SNEager)
+{
+  int options = GASNETE_COLL_GENERIC_OPT_INSYNC_IF (flags & GASNET_COLL_IN_ALLSYNC) |
+  GASNETE_COLL_GENERIC_OPT_OUTSYNC_IF(flags & GASNET_COLL_OUT_ALLSYNC)|
+  GASNETE_COLL_GENERIC_OPT_P2P;
+  
+  gasneti_assert(flags & GASNET_COLL_SINGLE);
+  gasneti_assert(flags & GASNET_COLL_SRC_IN_SEGMENT);
+  gasneti_assert(flags & GASNET_COLL_DST_IN_SEGMENT);
+  return gasnete_coll_generic_exchange_nb(team, dst, src, nbytes, flags,
+                                          &gasnete_coll_pf_exchg_SNEager, options,
+                                          NULL, NULL, sequence, coll_params->num_params, coll_params->param_list GASNETE_THREAD_PASS);
+}
+#endif
+
 /*---------------------------------------------------------------------------------*/
 /* gasnete_coll_exchangeM_nb() */
 
@@ -1441,8 +1707,9 @@ static int gasnete_coll_pf_reduce_Eager(gasnete_coll_op_t *op GASNETE_THREAD_FAR
         uintptr_t dst_addr, src_addr;
         size_t nbytes = args->nbytes;
         int i, done;
-        gasnet_coll_reduce_fn_t reduce_fn = gasnete_coll_fn_tbl[args->func].fnptr;
-        uint32_t red_fn_flags = gasnete_coll_fn_tbl[args->func].flags;
+        const gasnet_coll_fn_entry_t *reduce_ent = gasnete_coll_fn_lookup(args->func);
+        gasnet_coll_reduce_fn_t reduce_fn = reduce_ent->fnptr;
+        uint32_t red_fn_flags = reduce_ent->flags;
         uint32_t reduce_args = args->func_arg;
         static int first=1;
         
@@ -1505,6 +1772,125 @@ GASNETE_COLL_DECLARE_REDUCE_ALG(Eager)
                                         NULL, sequence, 0, NULL, NULL GASNETE_THREAD_PASS);
 }
 
+#if GASNET_PSHM
+/* reduce SNEager: hierarchical eager reduction over supernodes */
+/* Every rank signals the "head" of its supernode (the root in the root's supernode,
+   otherwise the leader) on entry.  The head combines the members' src, read directly
+   through the cross-mapped segments, and sends the partial result to the root in one
+   eager put per supernode, after which it releases the members. */
+/* Valid for SINGLE with SRC_IN_SEGMENT, size <= eager_scale */
+/* Requires GASNETE_COLL_GENERIC_OPT_P2P on all nodes */
+static int gasnete_coll_pf_reduce_SNEager(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  const gasnete_coll_reduce_args_t *args = GASNETE_COLL_GENERIC_ARGS(data, reduce);
+  const gasnet_node_t * const ranks = op->team->supernode_grps.ranks;
+  const gasnet_node_t * const first = op->team->supernode_grps.first;
+  const gasnet_node_t mygrp = op->team->supernode_grps.grp_of[op->team->myrank];
+  const gasnet_node_t head = (mygrp == op->team->supernode_grps.grp_of[args->dstnode])
+                                ? args->dstnode : ranks[first[mygrp]];
+  const int member_count = first[mygrp+1] - first[mygrp];
+  int result = 0;
+  
+  switch (data->state) {
+    case 0:	/* Optional IN barrier */
+      if (!gasnete_coll_generic_all_threads(data) ||
+          !gasnete_coll_generic_insync(op->team, data)) {
+        break;
+      }
+      if (op->team->myrank != head) {
+        gasnete_coll_p2p_advance(op, GASNETE_COLL_REL2ACT(op->team, head), 0);
+      }
+      data->state = 1;
+      
+    case 1:	/* Combine the contributions of my supernode */
+      if (op->team->myrank == head) {
+        const gasnet_coll_fn_entry_t *reduce_ent = gasnete_coll_fn_lookup(args->func);
+        gasnet_coll_reduce_fn_t reduce_fn = reduce_ent->fnptr;
+        void *acc = (op->team->myrank == args->dstnode) ? args->dst : data->p2p->data;
+        int i;
+        
+        if (gasneti_weakatomic_read(&data->p2p->counter[0], 0) != (member_count - 1)) {
+          break;
+        }
+        gasneti_sync_reads();
+        GASNETE_FAST_UNALIGNED_MEMCPY_CHECK(acc, args->src, args->nbytes);
+        for (i = first[mygrp]; i < first[mygrp+1]; ++i) {
+          const gasnet_node_t node = GASNETE_COLL_REL2ACT(op->team, ranks[i]);
+          if (ranks[i] == op->team->myrank) continue;
+          (*reduce_fn)(acc, args->elem_count, acc, args->elem_count,
+                       gasneti_pshm_addr2local(node, args->src), args->elem_size,
+                       reduce_ent->flags, args->func_arg);
+        }
+        if (op->team->myrank != args->dstnode) {
+          gasnete_coll_p2p_eager_put(op, GASNETE_COLL_REL2ACT(op->team, args->dstnode), acc,
+                                     args->nbytes, mygrp, 1);
+        }
+        for (i = first[mygrp]; i < first[mygrp+1]; ++i) {
+          if (ranks[i] == op->team->myrank) continue;
+          gasnete_coll_p2p_advance(op, GASNETE_COLL_REL2ACT(op->team, ranks[i]), 1);
+        }
+      }
+      data->state = 2;
+      
+    case 2:	/* Complete data movement */
+      if (op->team->myrank == args->dstnode) {
+        const gasnet_coll_fn_entry_t *reduce_ent = gasnete_coll_fn_lookup(args->func);
+        gasnet_coll_reduce_fn_t reduce_fn = reduce_ent->fnptr;
+        volatile uint32_t *state = data->p2p->state;
+        uintptr_t src_addr = (uintptr_t)(data->p2p->data);
+        int g, done = 1;
+        
+        for (g = 0; g < op->team->supernode.grp_count; ++g, src_addr += args->nbytes) {
+          if (g == mygrp) continue;
+          if (state[g] == 0) {
+            /* Nothing received yet */
+            done = 0;
+          } else if (state[g] == 1) {
+            /* Received but not yet applied */
+            gasneti_sync_reads();
+            (*reduce_fn)(args->dst, args->elem_count, args->dst, args->elem_count,
+                         (void *)src_addr, args->elem_size, reduce_ent->flags, args->func_arg);
+            state[g] = 2;
+          }
+        }
+        
+        if (!done) { break; }
+      } else if (op->team->myrank != head) {
+        /* Wait until the head has read my src */
+        if (gasneti_weakatomic_read(&data->p2p->counter[1], 0) == 0) {
+          break;
+        }
+      }
+      data->state = 3;
+      
+    case 3:	/* Optional OUT barrier */
+      if (!gasnete_coll_generic_outsync(op->team, data)) {
+        break;
+      }
+      
+      gasnete_coll_generic_free(op->team, data GASNETE_THREAD_PASS);
+      result = (GASNETE_COLL_OP_COMPLETE | GASNETE_COLL_OP_INACTIVE);
+  }
+  
+  return result;
+}
+
+GASNETE_COLL_DECLARE_REDUCE_ALG(SNEager)
+{
+  int options = GASNETE_COLL_GENERIC_OPT_INSYNC_IF (flags & GASNET_COLL_IN_ALLSYNC) |
+  GASNETE_COLL_GENERIC_OPT_OUTSYNC_IF(flags & GASNET_COLL_OUT_ALLSYNC)|
+  GASNETE_COLL_GENERIC_OPT_P2P;
+  
+  gasneti_assert(flags & GASNET_COLL_SINGLE);
+  gasneti_assert(flags & GASNET_COLL_SRC_IN_SEGMENT);
+  gasneti_assert(gasnete_coll_p2p_eager_scale >= elem_size*elem_count);
+  return gasnete_coll_generic_reduce_nb(team, dstimage, dst, src, src_blksz, src_offset,
+                                        elem_size, elem_count, func, func_arg, flags, 
+                                        &gasnete_coll_pf_reduce_SNEager, options,
+                                        NULL, sequence, 0, NULL, NULL GASNETE_THREAD_PASS);
+}
+#endif
+
 static int gasnete_coll_pf_reduce_TreeEager(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
   gasnete_coll_generic_data_t *data = op->data;
   gasnete_coll_tree_data_t *tree = data->tree_info;
@@ -1534,8 +1920,9 @@ static int gasnete_coll_pf_reduce_TreeEager(gasnete_coll_op_t *op GASNETE_THREAD
         volatile uint32_t *state;
         size_t nbytes = args->nbytes;
         int i, done;
-        gasnet_coll_reduce_fn_t reduce_fn = gasnete_coll_fn_tbl[args->func].fnptr;
-        uint32_t red_fn_flags = gasnete_coll_fn_tbl[args->func].flags;
+        const gasnet_coll_fn_entry_t *reduce_ent = gasnete_coll_fn_lookup(args->func);
+        gasnet_coll_reduce_fn_t reduce_fn = reduce_ent->fnptr;
+        uint32_t red_fn_flags = reduce_ent->flags;
         uint32_t reduce_args = args->func_arg;
         
         gasneti_assert(p2p != NULL);
@@ -1656,8 +2043,9 @@ static int gasnete_coll_pf_reduceM_TreeEager(gasnete_coll_op_t *op GASNETE_THREA
         volatile uint32_t *state;
         size_t nbytes = args->nbytes;
         int i, done;
-        gasnet_coll_reduce_fn_t reduce_fn = gasnete_coll_fn_tbl[args->func].fnptr;
-        uint32_t red_fn_flags = gasnete_coll_fn_tbl[args->func].flags;
+        const gasnet_coll_fn_entry_t *reduce_ent = gasnete_coll_fn_lookup(args->func);
+        gasnet_coll_reduce_fn_t reduce_fn = reduce_ent->fnptr;
+        uint32_t red_fn_flags = reduce_ent->flags;
         uint32_t reduce_args = args->func_arg;
         
         gasneti_assert(p2p != NULL);
@@ -85,6 +85,9 @@ typedef struct gasnete_coll_dissem_vector_t_ gasnete_coll_dissem_vector_t;
 struct gasnete_coll_dissem_info_t_;
 typedef struct gasnete_coll_dissem_info_t_ gasnete_coll_dissem_info_t;
 
+struct gasnete_coll_butterfly_info_t_;
+typedef struct gasnete_coll_butterfly_info_t_ gasnete_coll_butterfly_info_t;
+
 struct gasnete_coll_op_status_t_;
 typedef struct gasnete_coll_op_status_t_ gasnete_coll_op_status_t;
 
@@ -260,6 +263,9 @@ struct gasnete_coll_team_t_ {
   gasnete_coll_dissem_info_t *dissem_cache_head;
   gasnete_coll_dissem_info_t *dissem_cache_tail;
   gasneti_mutex_t dissem_cache_lock;
+
+  /*pairwise exchange (recursive doubling/halving) partners, built on first use*/
+  gasnete_coll_butterfly_info_t *butterfly_info;
   
   /*my relative node id in this team*/
   gasnet_node_t myrank;
@@ -284,6 +290,24 @@ struct gasnete_coll_team_t_ {
   } supernode;
   /* supernode-reps in the team at distances +/- powers of two in supernode space */
   gasnete_coll_peer_list_t supernode_peers;
+  /* Team ranks grouped by supernode, for the hierarchical collectives.
+   * Group g is ranks[first[g]] ... ranks[first[g+1]-1] in increasing order,
+   * and its first (lowest) rank is the group's leader.
+   */
+  struct {
+    gasnet_node_t *ranks;
+    gasnet_node_t *first;     /* grp_count+1 entries */
+    gasnet_node_t *grp_of;    /* group index of each team rank */
+    gasnet_node_t max_count;  /* size of the largest group */
+  } supernode_grps;
+  /* Teams contained in one supernode run the smp_coll algorithms across processes,
+   * with flags in a region reserved at the tail of rank 0's scratch space.
+   */
+  struct {
+    void *region;                  /* local mapping of rank 0's reserved tail */
+    gasnet_seginfo_t *scratch_segs; /* trimmed copy of the scratch segments */
+    smp_coll_t handle;             /* built on first use */
+  } smp_pshm;
 #endif
 
   /* scratch segments allocated on team creation*/
@@ -331,16 +355,23 @@ struct gasnete_coll_team_t_ {
   gasnete_all_barrier barrier;
   gasnete_all_barrier_result barrier_result;
   gasneti_progressfn_t barrier_pf;
+
+  /* Thread currently polling this team's ops (see gasnete_coll_poll) */
+  /* Protected by gasnete_coll_active_lock */
+  const void *poller;
   
 #ifndef GASNETE_COLL_P2P_OVERRIDE
   /* Default implementation of point-to-point syncs */
   #ifndef GASNETE_COLL_P2P_TABLE_SIZE
-    #define GASNETE_COLL_P2P_TABLE_SIZE 16
+    #define GASNETE_COLL_P2P_TABLE_SIZE 64
   #endif
 
-  gasnet_hsl_t p2p_lock; /* Protects freelist and table */
-  gasnete_coll_p2p_t *p2p_freelist;
-  gasnete_coll_p2p_t *p2p_table[GASNETE_COLL_P2P_TABLE_SIZE];
+  /* Hashed by sequence number, so concurrent ops rarely share a slot */
+  struct {
+    gasnet_hsl_t lock;                   /* Protects insertion, removal and freelist */
+    gasnete_coll_p2p_t * volatile head;  /* Unsorted, and may be searched w/o the lock */
+    gasnete_coll_p2p_t *freelist;        /* Recycled entries for this slot */
+  } p2p_table[GASNETE_COLL_P2P_TABLE_SIZE];
 #endif
   
   /* Hook for conduit-specific extensions/overrides */
@@ -361,6 +392,10 @@ extern int gasnete_coll_team_node2rank(gasnete_coll_team_t team, gasnet_node_t n
 
 extern gasnet_node_t gasnete_coll_team_size(gasnete_coll_team_t team);
 
+#if GASNET_PSHM
+extern smp_coll_t gasnete_coll_smp_pshm_handle(gasnete_coll_team_t team);
+#endif
+
 #if 0
 gasnete_coll_team_t gasnete_coll_make_team(int allocating_team_all, 
                                            const gasnet_image_t images[], gasnet_node_t myrank, gasnet_node_t num_members, 
@@ -488,6 +523,11 @@ extern void gasnete_coll_p2p_signalling_put(gasnete_coll_op_t *op, gasnet_node_t
                                             void *src, size_t nbytes, uint32_t pos, uint32_t state);
 extern void gasnete_coll_p2p_signalling_putAsync(gasnete_coll_op_t *op, gasnet_node_t dstnode, void *dst,
 						 void *src, size_t nbytes, uint32_t pos, uint32_t state);
+extern void gasnete_coll_p2p_sig_seg_put(gasnete_coll_op_t *op, gasnet_node_t dstnode, void *dst,
+                                         void *src, size_t nbytes, size_t seg_id);
+extern void gasnete_coll_p2p_sig_seg_putAsync(gasnete_coll_op_t *op, gasnet_node_t dstnode, void *dst,
+                                              void *src, size_t nbytes, size_t seg_id);
+extern uint32_t gasnete_coll_p2p_next_seg_interval(gasnete_coll_p2p_t *p2p);
 extern void gasnete_coll_p2p_change_states(gasnete_coll_op_t *op, gasnet_node_t dstnode,
                                            uint32_t count, uint32_t offset, uint32_t state);
 extern void gasnete_coll_p2p_advance(gasnete_coll_op_t *op, gasnet_node_t dstnode, uint32_t idx);
@@ -623,6 +663,44 @@ gasnete_coll_p2p_change_states(op, dstnode, 1, offset, state)
 extern gasnet_coll_fn_entry_t *gasnete_coll_fn_tbl;
 extern size_t gasnete_coll_fn_count;
 
+/* Predefined (GASNET_COLL_FN_*) reduction operators live in a separate
+   table indexed by the low bits of the handle */
+extern const gasnet_coll_fn_entry_t gasnete_coll_builtin_fn_tbl[GASNET_COLL_FN_OP_COUNT*GASNET_COLL_FN_TYPE_COUNT];
+extern const size_t gasnete_coll_builtin_elem_size[GASNET_COLL_FN_TYPE_COUNT];
+
+#define GASNETE_COLL_FN_IS_BUILTIN(func) ((func) & GASNET_COLL_FN_BUILTIN_BIT)
+
+GASNETI_INLINE(gasnete_coll_fn_lookup)
+const gasnet_coll_fn_entry_t *gasnete_coll_fn_lookup(gasnet_coll_fn_handle_t func) {
+  if (GASNETE_COLL_FN_IS_BUILTIN(func)) {
+    const unsigned int idx = func & ~GASNET_COLL_FN_BUILTIN_BIT;
+    gasneti_assert(idx < GASNET_COLL_FN_OP_COUNT*GASNET_COLL_FN_TYPE_COUNT);
+    return &gasnete_coll_builtin_fn_tbl[idx];
+  }
+  gasneti_assert(gasnete_coll_fn_tbl);
+  gasneti_assert(func < gasnete_coll_fn_count);
+  return &gasnete_coll_fn_tbl[func];
+}
+
+/* Debug check that a reduction handle is usable with the given element size */
+#if GASNET_DEBUG
+#define gasnete_coll_fn_check(func, elem_size) do {                                    \
+    gasnet_coll_fn_handle_t _func = (func);                                           \
+    if (GASNETE_COLL_FN_IS_BUILTIN(_func)) {                                           \
+      gasneti_assert((_func & ~GASNET_COLL_FN_BUILTIN_BIT) <                           \
+                     GASNET_COLL_FN_OP_COUNT*GASNET_COLL_FN_TYPE_COUNT);               \
+      gasneti_assert((elem_size) == gasnete_coll_builtin_elem_size[                    \
+                       (_func & ~GASNET_COLL_FN_BUILTIN_BIT) % GASNET_COLL_FN_TYPE_COUNT]); \
+    } else {                                                                           \
+      gasneti_assert(gasnete_coll_fn_tbl);                                             \
+      gasneti_assert(_func < gasnete_coll_fn_count);                                   \
+      gasneti_assert(gasnete_coll_fn_tbl[_func].fnptr);                                \
+    }                                                                                  \
+  } while (0)
+#else
+#define gasnete_coll_fn_check(func, elem_size) ((void)0)
+#endif
+
 #define GASNETE_COLL_1ST_IMAGE(TEAM,LIST,NODE)              \
 (((void * const *)(LIST))[(TEAM)->all_offset[(NODE)]])
 #define GASNETE_COLL_MY_1ST_IMAGE(TEAM,LIST,FLAGS)                      \
@@ -708,8 +786,9 @@ void gasnete_coll_local_gather(size_t count, void * dst, void * const srclist[],
 
 GASNETI_INLINE(gasnete_coll_local_reduce)
 void gasnete_coll_local_reduce(size_t count, void * dst, void * const srclist[], size_t elem_size, size_t elem_count, gasnet_coll_fn_handle_t func, int func_arg) {
-  gasnet_coll_reduce_fn_t reduce_fn = gasnete_coll_fn_tbl[func].fnptr;
-  uint32_t red_fn_flags = gasnete_coll_fn_tbl[func].flags;
+  const gasnet_coll_fn_entry_t *reduce_ent = gasnete_coll_fn_lookup(func);
+  gasnet_coll_reduce_fn_t reduce_fn = reduce_ent->fnptr;
+  uint32_t red_fn_flags = reduce_ent->flags;
   uint32_t reduce_args = func_arg;
   size_t nbytes = elem_size*elem_count;
   int i;
@@ -852,8 +931,11 @@ GASNETE_COLL_VALIDATE(T,(gasnet_image_t)(-1),D,(N)*gasneti_nodes,0,(gasnet_image
 GASNETE_COLL_VALIDATE(T,(gasnet_image_t)(-1),D,(N)*gasneti_nodes,1,(gasnet_image_t)(-1),S,(N)*gasneti_nodes,1,F)
 
 /* XXX: following arg validations unimplemented */
+#define GASNETE_COLL_VALIDATE_EXCHANGEV(T,D,DC,DO,S,SC,SO,N,F)
 #define GASNETE_COLL_VALIDATE_REDUCE(T,DI,D,S,SB,SO,ES,EC,FN,FA,F)
 #define GASNETE_COLL_VALIDATE_REDUCE_M(T,DI,D,SL,SB,SO,ES,EC,FN,FA,F)
+#define GASNETE_COLL_VALIDATE_REDUCE_ALL(T,D,S,ES,EC,FN,FA,F)
+#define GASNETE_COLL_VALIDATE_REDUCE_SCATTER(T,D,S,ES,EC,FN,FA,F)
 #define GASNETE_COLL_VALIDATE_SCAN(T,D,DB,DO,S,SB,SO,ES,EC,FN,FA,F)
 #define GASNETE_COLL_VALIDATE_SCAN_M(T,DL,DB,DO,SL,SB,SO,ES,EC,FN,FA,F)
 
@@ -1177,6 +1259,17 @@ typedef struct {
   size_t nbytes;
 } gasnete_coll_exchangeM_args_t;
 
+/* the count/offset arrays are the caller's and are indexed by image*/
+typedef struct {
+  void *dst;
+  const size_t *dst_counts;
+  const size_t *dst_offsets;
+  void *src;
+  const size_t *src_counts;
+  const size_t *src_offsets;
+  size_t max_nbytes;
+} gasnete_coll_exchangev_args_t;
+
 typedef struct {
 #if !GASNET_SEQ
   gasnet_image_t dstimage;
@@ -1207,6 +1300,19 @@ typedef struct {
   gasnet_coll_fn_handle_t func; int func_arg;
 } gasnete_coll_reduceM_args_t;
 
+/* shared by reduce_all and reduce_scatter: for reduce_scatter elem_count is the
+   per-image block and src holds elem_count*total_images elements */
+typedef struct {
+  void *dst;
+  void *src;
+  size_t elem_size; 
+  size_t elem_count;
+  size_t nbytes;
+  gasnet_coll_fn_handle_t func; int func_arg;
+} gasnete_coll_reduce_all_args_t;
+
+typedef gasnete_coll_reduce_all_args_t gasnete_coll_reduce_scatter_args_t;
+
 /* Options for gasnete_coll_generic_* */
 #define GASNETE_COLL_GENERIC_OPT_INSYNC		0x0001
 #define GASNETE_COLL_GENERIC_OPT_OUTSYNC	0x0002
@@ -1232,7 +1338,10 @@ struct gasnete_coll_generic_data_t_ {
     GASNETE_COLL_GENERIC_TAG(gather),
     GASNETE_COLL_GENERIC_TAG(gather_all),
     GASNETE_COLL_GENERIC_TAG(exchange),
+    GASNETE_COLL_GENERIC_TAG(exchangev),
     GASNETE_COLL_GENERIC_TAG(reduce),
+    GASNETE_COLL_GENERIC_TAG(reduce_all),
+    GASNETE_COLL_GENERIC_TAG(reduce_scatter),
     /* Multiple-address interfaces: */
     GASNETE_COLL_GENERIC_TAG(broadcastM),
     GASNETE_COLL_GENERIC_TAG(scatterM),
@@ -1293,7 +1402,10 @@ struct gasnete_coll_generic_data_t_ {
       gasnete_coll_gather_args_t		gather;
       gasnete_coll_gather_all_args_t		gather_all;
       gasnete_coll_exchange_args_t		exchange;
+      gasnete_coll_exchangev_args_t		exchangev;
       gasnete_coll_reduce_args_t reduce;
+      gasnete_coll_reduce_all_args_t		reduce_all;
+      gasnete_coll_reduce_scatter_args_t	reduce_scatter;
 
       /* Multiple-address interfaces: */
       gasnete_coll_broadcastM_args_t		broadcastM;
@@ -1518,6 +1630,16 @@ gasnete_coll_generic_exchange_nb(gasnet_team_handle_t team,
                                  int num_params, uint32_t *param_list
                                  GASNETE_THREAD_FARG);
 
+extern gasnet_coll_handle_t
+gasnete_coll_generic_exchangev_nb(gasnet_team_handle_t team,
+                                  void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                                  void *src, const size_t src_counts[], const size_t src_offsets[],
+                                  size_t max_nbytes, int flags,
+                                  gasnete_coll_poll_fn poll_fn, int options,
+                                  void *private_data, gasnete_coll_dissem_info_t *dissem, uint32_t sequence,
+                                  int num_params, uint32_t *param_list, gasnete_coll_scratch_req_t *scratch_req
+                                  GASNETE_THREAD_FARG);
+
 extern gasnet_coll_handle_t
 gasnete_coll_generic_exchangeM_nb(gasnet_team_handle_t team,
                                   void * const dstlist[], void * const srclist[],
@@ -1549,7 +1671,25 @@ gasnete_coll_generic_reduceM_nb(gasnet_team_handle_t team,
                                int num_params, uint32_t *param_list, gasnete_coll_scratch_req_t *scratch_req
                                GASNETE_THREAD_FARG);
 
+extern gasnet_coll_handle_t
+gasnete_coll_generic_reduce_all_nb(gasnet_team_handle_t team,
+                                   void *dst, void *src,
+                                   size_t elem_size, size_t elem_count, 
+                                   gasnet_coll_fn_handle_t func, int func_arg, int flags,
+                                   gasnete_coll_poll_fn poll_fn, int options,
+                                   void *private_data, uint32_t sequence,
+                                   int num_params, uint32_t *param_list, gasnete_coll_scratch_req_t *scratch_req
+                                   GASNETE_THREAD_FARG);
 
+extern gasnet_coll_handle_t
+gasnete_coll_generic_reduce_scatter_nb(gasnet_team_handle_t team,
+                                       void *dst, void *src,
+                                       size_t elem_size, size_t elem_count, 
+                                       gasnet_coll_fn_handle_t func, int func_arg, int flags,
+                                       gasnete_coll_poll_fn poll_fn, int options,
+                                       void *private_data, uint32_t sequence,
+                                       int num_params, uint32_t *param_list, gasnete_coll_scratch_req_t *scratch_req
+                                       GASNETE_THREAD_FARG);
 
 extern gasnet_coll_handle_t
 gasnete_coll_broadcast_nb_default(gasnet_team_handle_t team,
@@ -1610,6 +1750,13 @@ gasnete_coll_exchangeM_nb_default(gasnet_team_handle_t team,
                                   size_t nbytes, int flags, uint32_t sequence
                                   GASNETE_THREAD_FARG);
 
+extern gasnet_coll_handle_t
+gasnete_coll_exchangev_nb_default(gasnet_team_handle_t team,
+                                  void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                                  void *src, const size_t src_counts[], const size_t src_offsets[],
+                                  size_t max_nbytes, int flags, uint32_t sequence
+                                  GASNETE_THREAD_FARG);
+
 
 extern gasnete_coll_tree_data_t *gasnete_coll_tree_init(gasnete_coll_tree_type_t tree_type, gasnet_node_t rootnode, gasnete_coll_team_t team GASNETE_THREAD_FARG);
 extern void gasnete_coll_tree_free(gasnete_coll_tree_data_t *tree GASNETE_THREAD_FARG);
@@ -1637,8 +1784,13 @@ GASNETE_COLL_DECLARE_BCAST_ALG(RVous);
 GASNETE_COLL_DECLARE_BCAST_ALG(TreePut);
 GASNETE_COLL_DECLARE_BCAST_ALG(TreePutScratch);
 GASNETE_COLL_DECLARE_BCAST_ALG(TreePutSeg);
+GASNETE_COLL_DECLARE_BCAST_ALG(TreePipe);
 GASNETE_COLL_DECLARE_BCAST_ALG(ScatterAllgather);
 GASNETE_COLL_DECLARE_BCAST_ALG(TreeEager);
+#if GASNET_PSHM
+GASNETE_COLL_DECLARE_BCAST_ALG(SNPut);
+GASNETE_COLL_DECLARE_BCAST_ALG(SMPTreeFlag);
+#endif
 
 /*---------------------------------------------------------------------------------*/
 
@@ -1730,6 +1882,9 @@ GASNETE_COLL_DECLARE_GATHER_ALG(TreeEager);
 GASNETE_COLL_DECLARE_GATHER_ALG(Eager);
 GASNETE_COLL_DECLARE_GATHER_ALG(RVPut);
 GASNETE_COLL_DECLARE_GATHER_ALG(RVous);
+#if GASNET_PSHM
+GASNETE_COLL_DECLARE_GATHER_ALG(SNEager);
+#endif
 
 /*---------------------------------------------------------------------------------*/
 
@@ -1805,6 +1960,27 @@ GASNETE_COLL_DECLARE_EXCHANGE_ALG(FlatScratch);
 GASNETE_COLL_DECLARE_EXCHANGE_ALG(Gath);
 GASNETE_COLL_DECLARE_EXCHANGE_ALG(Put);
 GASNETE_COLL_DECLARE_EXCHANGE_ALG(RVPut);
+#if GASNET_PSHM
+GASNETE_COLL_DECLARE_EXCHANGE_ALG(SNEager);
+GASNETE_COLL_DECLARE_EXCHANGE_ALG(SMPPut);
+#endif
+
+/*---------------------------------------------------------------------------------*/
+
+#define GASNETE_COLL_DECLARE_EXCHANGEV_ALG(FUNC_EXT)\
+extern gasnet_coll_handle_t \
+gasnete_coll_exchgv_##FUNC_EXT(gasnet_team_handle_t team,\
+                               void *dst, const size_t dst_counts[], const size_t dst_offsets[],\
+                               void *src, const size_t src_counts[], const size_t src_offsets[],\
+                               size_t max_nbytes, int flags, gasnete_coll_implementation_t coll_params, uint32_t sequence\
+                               GASNETE_THREAD_FARG)
+
+GASNETE_COLL_DECLARE_EXCHANGEV_ALG(Dissem);
+GASNETE_COLL_DECLARE_EXCHANGEV_ALG(Chunked);
+GASNETE_COLL_DECLARE_EXCHANGEV_ALG(Put);
+
+/* largest max_nbytes that exchgv_Dissem can move through the scratch space in one pass*/
+extern size_t gasnete_coll_exchgv_dissem_max_nbytes(gasnete_coll_team_t team, gasnete_coll_dissem_info_t *dissem, size_t smallest_scratch);
 
 /*---------------------------------------------------------------------------------*/
 
@@ -1848,6 +2024,9 @@ GASNETE_COLL_DECLARE_REDUCE_ALG(TreeEager);
 GASNETE_COLL_DECLARE_REDUCE_ALG(TreePut);
 GASNETE_COLL_DECLARE_REDUCE_ALG(TreePutSeg);
 GASNETE_COLL_DECLARE_REDUCE_ALG(TreeGet);
+#if GASNET_PSHM
+GASNETE_COLL_DECLARE_REDUCE_ALG(SNEager);
+#endif
 
 /*#undef GASNETI_COLL_FN_HEADER*/
 
@@ -1869,6 +2048,40 @@ GASNETE_COLL_DECLARE_REDUCEM_ALG(TreePut);
 GASNETE_COLL_DECLARE_REDUCEM_ALG(TreePutSeg);
 GASNETE_COLL_DECLARE_REDUCEM_ALG(TreeGet);
 
+/*---------------------------------------------------------------------------------*/
+
+#define GASNETE_COLL_DECLARE_REDUCE_ALL_ALG(FUNC_EXT) \
+extern gasnet_coll_handle_t \
+gasnete_coll_reduce_all_##FUNC_EXT(gasnet_team_handle_t team,\
+                                   void *dst, void *src,\
+                                   size_t elem_size, size_t elem_count,\
+                                   gasnet_coll_fn_handle_t func, int func_arg,\
+                                   int flags, \
+                                   gasnete_coll_implementation_t coll_params,\
+                                   uint32_t sequence\
+                                   GASNETE_THREAD_FARG)
+
+GASNETE_COLL_DECLARE_REDUCE_ALL_ALG(RedBcast);
+GASNETE_COLL_DECLARE_REDUCE_ALL_ALG(RecDbl);
+GASNETE_COLL_DECLARE_REDUCE_ALL_ALG(Rabenseifner);
+
+/*---------------------------------------------------------------------------------*/
+
+#define GASNETE_COLL_DECLARE_REDUCE_SCATTER_ALG(FUNC_EXT) \
+extern gasnet_coll_handle_t \
+gasnete_coll_reduce_scatter_##FUNC_EXT(gasnet_team_handle_t team,\
+                                       void *dst, void *src,\
+                                       size_t elem_size, size_t elem_count,\
+                                       gasnet_coll_fn_handle_t func, int func_arg,\
+                                       int flags, \
+                                       gasnete_coll_implementation_t coll_params,\
+                                       uint32_t sequence\
+                                       GASNETE_THREAD_FARG)
+
+GASNETE_COLL_DECLARE_REDUCE_SCATTER_ALG(RedScat);
+GASNETE_COLL_DECLARE_REDUCE_SCATTER_ALG(RecDbl);
+GASNETE_COLL_DECLARE_REDUCE_SCATTER_ALG(RecHalv);
+
 /*---------------------------------------------------------------------------------*/
 /* Conduit specific extension hooks: */
 /* These may be unused, but there is no harm in prototyping them. */
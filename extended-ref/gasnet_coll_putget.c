@@ -168,6 +168,180 @@ gasnete_coll_bcast_Put(gasnet_team_handle_t team,
 }
 
 
+#if GASNET_PSHM
+/* bcast SNPut: hierarchical Put over supernodes */
+/* The root puts to the leader of each other supernode, and writes directly to the
+   dst of the members of its own supernode through the cross-mapped segments.
+   Each leader then copies the data to the members of its supernode the same way.
+   Thus only one network transfer is made per supernode. */
+/* For IN_MYSYNC each rank signals the rank that writes its dst on entry (counter 1),
+   rather than waiting on a barrier.  Data arrival is signaled on counter 0. */
+/* Valid for SINGLE with DST_IN_SEGMENT */
+/* Requires GASNETE_COLL_GENERIC_OPT_P2P on all nodes */
+static int gasnete_coll_pf_bcast_SNPut(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  const gasnete_coll_broadcast_args_t *args = GASNETE_COLL_GENERIC_ARGS(data, broadcast);
+  const gasnet_node_t * const ranks = op->team->supernode_grps.ranks;
+  const gasnet_node_t * const first = op->team->supernode_grps.first;
+  const gasnet_node_t grp_count = op->team->supernode.grp_count;
+  const gasnet_node_t mygrp = op->team->supernode_grps.grp_of[op->team->myrank];
+  const gasnet_node_t rootgrp = op->team->supernode_grps.grp_of[args->srcnode];
+  const int is_leader = (mygrp != rootgrp) && (ranks[first[mygrp]] == op->team->myrank);
+  const int member_count = first[mygrp+1] - first[mygrp];
+  int result = 0;
+
+  switch (data->state) {
+    case 0:	/* Optional IN barrier */
+      if (!gasnete_coll_generic_all_threads(data) ||
+          !gasnete_coll_generic_insync(op->team, data)) {
+        break;
+      }
+      if ((op->flags & GASNET_COLL_IN_MYSYNC) && (op->team->myrank != args->srcnode)) {
+        /* Tell whoever writes my dst that I have arrived */
+        const gasnet_node_t writer = (is_leader || (mygrp == rootgrp)) ? args->srcnode : ranks[first[mygrp]];
+        gasnete_coll_p2p_advance(op, GASNETE_COLL_REL2ACT(op->team, writer), 1);
+      }
+      data->state = 1;
+
+      case 1:	/* Initiate data movement */
+      if (op->team->myrank == args->srcnode) {
+        void   *src   = args->src;
+        void   *dst   = args->dst;
+        size_t nbytes = args->nbytes;
+        int g, i;
+        if ((op->flags & GASNET_COLL_IN_MYSYNC) &&
+            (gasneti_weakatomic_read(&data->p2p->counter[1], 0) != (member_count - 1) + (grp_count - 1))) {
+          break;
+        }
+        if (!GASNETE_COLL_MAY_INIT_FOR(op)) break;
+
+        /* Queue PUTS to the leaders of the other supernodes in an NBI access region */
+        gasnete_begin_nbi_accessregion(1 GASNETE_THREAD_PASS);
+        for (g = 0; g < grp_count; ++g) {
+          if (g == mygrp) continue;
+          gasnete_put_nbi_bulk(GASNETE_COLL_REL2ACT(op->team, ranks[first[g]]), dst, src, nbytes GASNETE_THREAD_PASS);
+        }
+        data->handle = gasnete_end_nbi_accessregion(GASNETE_THREAD_PASS_ALONE);
+        gasnete_coll_save_handle(&data->handle GASNETE_THREAD_PASS);
+
+        /* Copy to my own supernode, overlapping with communication */
+        for (i = first[mygrp]; i < first[mygrp+1]; ++i) {
+          const gasnet_node_t node = GASNETE_COLL_REL2ACT(op->team, ranks[i]);
+          GASNETE_FAST_UNALIGNED_MEMCPY_CHECK(gasneti_pshm_addr2local(node, dst), src, nbytes);
+        }
+        gasneti_sync_writes();
+        for (i = first[mygrp]; i < first[mygrp+1]; ++i) {
+          if (ranks[i] == op->team->myrank) continue;
+          gasnete_coll_p2p_advance(op, GASNETE_COLL_REL2ACT(op->team, ranks[i]), 0);
+        }
+      }
+      data->state = 2;
+
+      case 2:	/* Sync data movement */
+      if (op->team->myrank == args->srcnode) {
+        int g;
+        if (data->handle != GASNET_INVALID_HANDLE) {
+          break;
+        }
+        /* Signal the leaders that their data has arrived */
+        for (g = 0; g < grp_count; ++g) {
+          if (g == mygrp) continue;
+          gasnete_coll_p2p_advance(op, GASNETE_COLL_REL2ACT(op->team, ranks[first[g]]), 0);
+        }
+      } else {
+        if (gasneti_weakatomic_read(&data->p2p->counter[0], 0) == 0) {
+          break;
+        }
+        if (is_leader) {
+          /* Leader of a remote supernode: forward to my members */
+          void   *dst   = args->dst;
+          size_t nbytes = args->nbytes;
+          int i;
+          if ((op->flags & GASNET_COLL_IN_MYSYNC) &&
+              (gasneti_weakatomic_read(&data->p2p->counter[1], 0) != (member_count - 1))) {
+            break;
+          }
+          gasneti_sync_reads();
+          for (i = first[mygrp] + 1; i < first[mygrp+1]; ++i) {
+            const gasnet_node_t node = GASNETE_COLL_REL2ACT(op->team, ranks[i]);
+            GASNETE_FAST_UNALIGNED_MEMCPY(gasneti_pshm_addr2local(node, dst), dst, nbytes);
+          }
+          gasneti_sync_writes();
+          for (i = first[mygrp] + 1; i < first[mygrp+1]; ++i) {
+            gasnete_coll_p2p_advance(op, GASNETE_COLL_REL2ACT(op->team, ranks[i]), 0);
+          }
+        }
+        gasneti_sync_reads();
+      }
+      data->state = 3;
+
+      case 3:	/* Optional OUT barrier */
+      if (!gasnete_coll_generic_outsync(op->team, data)) {
+        break;
+      }
+
+      gasnete_coll_generic_free(op->team, data GASNETE_THREAD_PASS);
+      result = (GASNETE_COLL_OP_COMPLETE | GASNETE_COLL_OP_INACTIVE);
+  }
+
+  return result;
+}
+extern gasnet_coll_handle_t
+gasnete_coll_bcast_SNPut(gasnet_team_handle_t team,
+                         void * dst,
+                         gasnet_image_t srcimage, void *src,
+                         size_t nbytes, int flags,
+                         gasnete_coll_implementation_t coll_params,
+                         uint32_t sequence
+                         GASNETE_THREAD_FARG)
+{
+  int options = GASNETE_COLL_GENERIC_OPT_INSYNC_IF (flags & GASNET_COLL_IN_ALLSYNC) |
+  GASNETE_COLL_GENERIC_OPT_OUTSYNC_IF(flags & GASNET_COLL_OUT_ALLSYNC) |
+  GASNETE_COLL_GENERIC_OPT_P2P;
+
+  gasneti_assert(flags & GASNET_COLL_SINGLE);
+  gasneti_assert(flags & GASNET_COLL_DST_IN_SEGMENT);
+  return gasnete_coll_generic_broadcast_nb(team, dst, srcimage, src, nbytes, flags,
+                                           &gasnete_coll_pf_bcast_SNPut, options,
+                                           NULL, sequence, coll_params->num_params, coll_params->param_list GASNETE_THREAD_PASS);
+}
+
+/* bcast SMPTreeFlag: smp_coll tree broadcast over the team's shared-memory flags */
+/* Requires a team within one supernode (team->smp_pshm.region) */
+/* Completes before returning, polling while it waits on the other members */
+/* Rank 0 reads the root's src, so src must be in-segment and single-valued */
+extern gasnet_coll_handle_t
+gasnete_coll_bcast_SMPTreeFlag(gasnet_team_handle_t team,
+                               void * dst,
+                               gasnet_image_t srcimage, void *src,
+                               size_t nbytes, int flags,
+                               gasnete_coll_implementation_t coll_params,
+                               uint32_t sequence
+                               GASNETE_THREAD_FARG)
+{
+  smp_coll_t handle = gasnete_coll_smp_pshm_handle(team);
+  void **dstlist;
+  gasnet_node_t i;
+
+  gasneti_assert(coll_params->num_params >= 1);
+  gasneti_assert(flags & GASNET_COLL_SINGLE);
+  gasneti_assert(!(flags & GASNETE_COLL_THREAD_LOCAL));
+
+  dstlist = handle->tempaddrs;
+  for (i = 0; i < team->total_ranks; ++i) {
+    dstlist[i] = gasneti_pshm_addr2local(GASNETE_COLL_REL2ACT(team, i), dst);
+  }
+  src = gasneti_pshm_addr2local(GASNETE_COLL_REL2ACT(team, gasnete_coll_image_node(team, srcimage)), src);
+
+  if (!(flags & GASNET_COLL_IN_NOSYNC)) smp_coll_barrier(handle, 0);
+  smp_coll_broadcast_tree_flag(handle, team->total_ranks, dstlist, src, 
+                               nbytes, 0, coll_params->param_list[0]);
+  if (!(flags & GASNET_COLL_OUT_NOSYNC)) smp_coll_barrier(handle, 0);
+  return GASNET_COLL_INVALID_HANDLE;
+}
+#endif
+
+
 /* TreePut: COLL_SINGLE IN_NO/ALL_SYNC/OUT_* */
 /* TreePutScratch: COLL_LOCAL (all sync variations) and COLL_SINGLE IN_MYSYNC/OUT_* */
 /* bcast TreePut */
@@ -533,6 +707,110 @@ gasnete_coll_bcast_TreePutSeg(gasnet_team_handle_t team,
                                            GASNETE_THREAD_PASS);
 }
 
+/* bcast TreePipe: pipelined tree broadcast in a single op */
+/* The payload is cut into param_list[0]-byte segments.  The root pushes every
+   segment down the tree and each internal node forwards segment k to its children
+   as soon as it arrives, while later segments are still in flight.  Arrivals are
+   tracked by the p2p segment intervals so segments are forwarded in the order they
+   land.  Unlike TreePutSeg there is no op per segment and no cap on their number.
+   Requires GASNET_COLL_SINGLE and GASNET_COLL_DST_IN_SEGMENT (puts straight into
+   dst on the children) and GASNETE_COLL_GENERIC_OPT_P2P.
+   Naturally OUT_MYSYNC, since every node waits for all of its segments */
+static int gasnete_coll_pf_bcast_TreePipe(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  gasnete_coll_tree_data_t *tree = data->tree_info;
+  const gasnete_coll_broadcast_args_t *args = GASNETE_COLL_GENERIC_ARGS(data, broadcast);
+  gasnet_node_t * const children = GASNETE_COLL_TREE_GEOM_CHILDREN(tree->geom);
+  const int child_count = GASNETE_COLL_TREE_GEOM_CHILD_COUNT(tree->geom);
+  const size_t seg_size = (size_t) op->param_list[0];
+  const uint32_t num_segs = (args->nbytes + seg_size - 1)/seg_size;
+  int result = 0;
+  int child;
+  
+  switch (data->state) {
+    case 0:	/* Optional IN barrier */
+      if (!gasnete_coll_generic_all_threads(data) ||
+          !gasnete_coll_generic_insync(op->team, data)) {
+        break;
+      }
+      data->state = 1;
+      
+    case 1:	/* root pushes all the segments */
+      if (!GASNETE_COLL_MAY_INIT_FOR(op)) break;
+      if (op->team->myrank == args->srcnode) {
+        uint32_t seg;
+        for (seg = 0; seg < num_segs; seg++) {
+          const size_t offset = seg*seg_size;
+          const size_t len = MIN(seg_size, args->nbytes - offset);
+          for (child = 0; child < child_count; child++) {
+            gasnete_coll_p2p_sig_seg_put(op, GASNETE_COLL_REL2ACT(op->team, children[child]), 
+                                         (int8_t*)args->dst + offset, (int8_t*)args->src + offset, len, seg);
+          }
+        }
+        GASNETE_FAST_UNALIGNED_MEMCPY_CHECK(args->dst, args->src, args->nbytes);
+      }
+      data->state = 2;
+      
+    case 2:	/* non-root nodes forward the segments that have arrived so far */
+      if (op->team->myrank != args->srcnode) {
+        while (data->p2p->num_segs_processed < gasneti_weakatomic_read(&data->p2p->counter[0], 0)) {
+          /* every arrival adds its interval before bumping the counter*/
+          const uint32_t seg = gasnete_coll_p2p_next_seg_interval(data->p2p);
+          const size_t offset = seg*seg_size;
+          const size_t len = MIN(seg_size, args->nbytes - offset);
+          gasneti_sync_reads();
+          for (child = 0; child < child_count; child++) {
+            gasnete_coll_p2p_sig_seg_put(op, GASNETE_COLL_REL2ACT(op->team, children[child]), 
+                                         (int8_t*)args->dst + offset, (int8_t*)args->dst + offset, len, seg);
+          }
+          data->p2p->num_segs_processed++;
+        }
+        if (data->p2p->num_segs_processed != num_segs) {
+          break;	/* waiting for parent to push more segments */
+        }
+      }
+      data->state = 3;
+      
+    case 3:	/* Optional OUT barrier */
+      if (!gasnete_coll_generic_outsync(op->team, data)) {
+        break;
+      }
+      
+      gasnete_coll_generic_free(op->team, data GASNETE_THREAD_PASS);
+      result = (GASNETE_COLL_OP_COMPLETE | GASNETE_COLL_OP_INACTIVE);
+  }
+  
+  return result;
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_bcast_TreePipe(gasnet_team_handle_t team,
+                            void *dst,
+                            gasnet_image_t srcimage, void *src,
+                            size_t nbytes, int flags,
+                            gasnete_coll_implementation_t coll_params,
+                            uint32_t sequence
+                            GASNETE_THREAD_FARG)
+{
+  int options =
+  GASNETE_COLL_GENERIC_OPT_INSYNC_IF (!(flags & GASNET_COLL_IN_NOSYNC)) |
+  GASNETE_COLL_GENERIC_OPT_OUTSYNC_IF (flags & GASNET_COLL_OUT_ALLSYNC) |
+  GASNETE_COLL_GENERIC_OPT_P2P;
+  
+  gasneti_assert(flags & GASNET_COLL_SINGLE);
+  gasneti_assert(flags & GASNET_COLL_DST_IN_SEGMENT);
+  gasneti_assert(coll_params->num_params >= 1);
+  gasneti_assert(coll_params->param_list[0] > 0 && coll_params->param_list[0] <= gasnet_AMMaxLongRequest());
+  
+  return gasnete_coll_generic_broadcast_nb(team, dst, srcimage, src, nbytes, flags,
+                                           &gasnete_coll_pf_bcast_TreePipe, options,
+                                           gasnete_coll_tree_init(coll_params->tree_type, 
+                                                                  gasnete_coll_image_node(team,srcimage), team
+                                                                  GASNETE_THREAD_PASS),
+                                           sequence, coll_params->num_params, coll_params->param_list
+                                           GASNETE_THREAD_PASS);
+}
+
 static int gasnete_coll_pf_bcast_ScatterAllgather(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
   gasnete_coll_generic_data_t *data = op->data;
   const gasnete_coll_broadcast_args_t *args = GASNETE_COLL_GENERIC_ARGS(data, broadcast);
@@ -5229,6 +5507,378 @@ gasnete_coll_exchg_Put(gasnet_team_handle_t team,
                                           &gasnete_coll_pf_exchg_Put, options,
                                           NULL, NULL, sequence, coll_params->num_params, coll_params->param_list GASNETE_THREAD_PASS);
 }
+
+#if GASNET_PSHM
+/* exchg SMPPut: each member copies its blocks straight into the others' dst */
+/* Requires a team within one supernode (team->smp_pshm.region) */
+/* Synchronized by the smp_coll barrier over the team's shared-memory flags */
+extern gasnet_coll_handle_t
+gasnete_coll_exchg_SMPPut(gasnet_team_handle_t team,
+                          void *dst, void *src,
+                          size_t nbytes, int flags, gasnete_coll_implementation_t coll_params, uint32_t sequence
+                          GASNETE_THREAD_FARG)
+{
+  smp_coll_t handle = gasnete_coll_smp_pshm_handle(team);
+  const gasnet_node_t myrank = team->myrank;
+  gasnet_node_t i, peer;
+
+  gasneti_assert(flags & GASNET_COLL_SINGLE);
+  gasneti_assert(!(flags & GASNETE_COLL_THREAD_LOCAL));
+
+  if (!(flags & GASNET_COLL_IN_NOSYNC)) smp_coll_barrier(handle, 0);
+  /* Each member starts at its own rank to spread the writes over the members */
+  for (i = 0, peer = myrank; i < team->total_ranks; ++i) {
+    void *peer_dst = gasneti_pshm_addr2local(GASNETE_COLL_REL2ACT(team, peer),
+                                             gasnete_coll_scale_ptr(dst, myrank, nbytes));
+    GASNETE_FAST_UNALIGNED_MEMCPY_CHECK(peer_dst, gasnete_coll_scale_ptr(src, peer, nbytes), nbytes);
+    if (++peer == team->total_ranks) peer = 0;
+  }
+  if (!(flags & GASNET_COLL_OUT_NOSYNC)) smp_coll_barrier(handle, 0);
+  return GASNET_COLL_INVALID_HANDLE;
+}
+#endif
+/*---------------------------------------------------------------------------------*/
+/* gasnete_coll_exchangev_nb() */
+
+/* exchgv Dissem: the Bruck exchange above with a length for every block */
+/* Each message starts with a header holding the lengths of the blocks it carries:
+   [size_t lens[max_dissem_blocks]][block data, packed back to back]
+   The rotated working copy of the blocks (max_nbytes apart) follows the receive
+   slots in the scratch space and the current block lengths live in private_data.
+   Every message has to fit in a single AMLong (see gasnete_coll_exchgv_dissem_max_nbytes).
+   This algorithm only writes into the remote scratch space so it is valid for
+   COLL_SINGLE and COLL_LOCAL
+ */
+#define GASNETE_COLL_EXCHGV_SLOT_SIZE(DISSEM, MAX_NBYTES) \
+  (GASNETE_COLL_DISSEM_MAX_BLOCKS(DISSEM)*(sizeof(size_t)+(MAX_NBYTES)))
+
+size_t gasnete_coll_exchgv_dissem_max_nbytes(gasnete_coll_team_t team, gasnete_coll_dissem_info_t *dissem, size_t smallest_scratch) {
+  const size_t max_blocks = GASNETE_COLL_DISSEM_MAX_BLOCKS(dissem);
+  const size_t num_slots = 2*(dissem->dissemination_radix-1);
+  const size_t hdr_size = max_blocks*sizeof(size_t);
+  
+  /* total_ranks*M + num_slots*(hdr_size + max_blocks*M) <= smallest_scratch and
+     hdr_size + max_blocks*M <= gasnet_AMMaxLongRequest()*/
+  if(smallest_scratch < num_slots*hdr_size || gasnet_AMMaxLongRequest() < hdr_size) return 0;
+  return MIN((smallest_scratch - num_slots*hdr_size)/(team->total_ranks + num_slots*max_blocks),
+             (gasnet_AMMaxLongRequest() - hdr_size)/max_blocks);
+}
+
+/* pack the blocks whose digit_th radix-r digit is j into msg and return the message length*/
+static size_t gasnete_coll_exchgv_pack_msg(int8_t *msg, const int8_t *blocks, const size_t *lens, size_t stride,
+                                           int max_blocks, int digit, int radix, int j, int total_ranks) {
+  const int pow = gasnete_coll_mypow(radix, digit);
+  int8_t *msg_data = msg + max_blocks*sizeof(size_t);
+  size_t data_len = 0;
+  int i_idx, blk_count=0;
+  
+  for(i_idx=0; i_idx<total_ranks; i_idx++) {
+    if(((i_idx / pow) % radix) == j) {
+      GASNETE_FAST_UNALIGNED_MEMCPY(msg+blk_count*sizeof(size_t), &lens[i_idx], sizeof(size_t));
+      GASNETE_FAST_UNALIGNED_MEMCPY(msg_data+data_len, blocks+i_idx*stride, lens[i_idx]);
+      data_len += lens[i_idx];
+      blk_count++;
+    }
+  }
+  return max_blocks*sizeof(size_t) + data_len;
+}
+
+static void gasnete_coll_exchgv_unpack_msg(const int8_t *msg, int8_t *blocks, size_t *lens, size_t stride,
+                                           int max_blocks, int digit, int radix, int j, int total_ranks) {
+  const int pow = gasnete_coll_mypow(radix, digit);
+  const int8_t *msg_data = msg + max_blocks*sizeof(size_t);
+  size_t data_len = 0;
+  int i_idx, blk_count=0;
+  
+  for(i_idx=0; i_idx<total_ranks; i_idx++) {
+    if(((i_idx / pow) % radix) == j) {
+      GASNETE_FAST_UNALIGNED_MEMCPY(&lens[i_idx], msg+blk_count*sizeof(size_t), sizeof(size_t));
+      gasneti_assert(lens[i_idx] <= stride);
+      GASNETE_FAST_UNALIGNED_MEMCPY(blocks+i_idx*stride, msg_data+data_len, lens[i_idx]);
+      data_len += lens[i_idx];
+      blk_count++;
+    }
+  }
+}
+
+static int gasnete_coll_pf_exchgv_Dissem(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  gasnete_coll_dissem_info_t *dissem = data->dissem_info;
+  const gasnete_coll_exchangev_args_t *args = GASNETE_COLL_GENERIC_ARGS(data, exchangev);
+  const int total_ranks = op->team->total_ranks;
+  const int myrank = op->team->myrank;
+  const size_t slot_size = GASNETE_COLL_EXCHGV_SLOT_SIZE(dissem, args->max_nbytes);
+  size_t *lens = (size_t*) data->private_data;
+  int result = 0;
+  
+  int8_t *scratch2;
+  int8_t *scratch1;
+  
+  /*same state layout as gasnete_coll_pf_exchg_Dissem: 3 states per dissem phase*/
+  if(data->state == 0) {
+    if_pt(total_ranks != 1) 
+    if(!gasnete_coll_scratch_alloc_nb(op GASNETE_THREAD_PASS)) 
+      return 0;
+    data->state = 1;
+  } 
+  
+  scratch1 = (int8_t*)op->team->scratch_segs[myrank].addr + op->myscratchpos;
+  scratch2 = scratch1 + slot_size*((2)*(dissem->dissemination_radix-1));
+  
+  if(data->state == 1) {
+    int i;
+    if (!gasnete_coll_generic_all_threads(data) ||
+        !gasnete_coll_generic_insync(op->team, data)) {
+      return result;
+    }
+    
+    if(total_ranks == 1) {
+      gasneti_assert(args->src_counts[0] == args->dst_counts[0]);
+      GASNETE_FAST_UNALIGNED_MEMCPY_CHECK((int8_t*)args->dst+args->dst_offsets[0], 
+                                          (int8_t*)args->src+args->src_offsets[0], args->src_counts[0]);
+      data->state = dissem->dissemination_phases*3+3;
+      return 0; 
+    }    
+    /* local rotation: block i holds the data for rank myrank+i*/
+    lens = data->private_data = gasneti_malloc(sizeof(size_t)*total_ranks);
+    for(i=0; i<total_ranks; i++) {
+      int peer = (myrank + i) % total_ranks;
+      lens[i] = args->src_counts[peer];
+      gasneti_assert(lens[i] <= args->max_nbytes);
+      GASNETE_FAST_UNALIGNED_MEMCPY(scratch2+i*args->max_nbytes, (int8_t*)args->src+args->src_offsets[peer], lens[i]);
+    }
+    data->state = 2;
+  }
+  
+  if(data->state>=2 && data->state<=dissem->dissemination_phases*3+1) {
+    /*data transfer stages*/
+    gasnet_node_t* out_nodes, *in_nodes;
+    int phase = (data->state - 2)/3;
+    int h,j;
+    h = GASNETE_COLL_DISSEM_GET_PEER_COUNT_PHASE(dissem, phase);
+    out_nodes = GASNETE_COLL_DISSEM_GET_FRONT_PEERS_PHASE(dissem, phase);
+    in_nodes = GASNETE_COLL_DISSEM_GET_BEHIND_PEERS_PHASE(dissem, phase);
+#define IDX_EXPR (((phase%2)*(dissem->dissemination_radix-1) + (j))*slot_size)
+#define IDXP1_EXPR ((((phase+1)%2)*(dissem->dissemination_radix-1) + (j))*slot_size)
+    
+    if((data->state-2) % 3 == 0) {
+      /*send the ok to send signal*/
+      gasneti_sync_writes();
+      for(j=0; j<h; j++) {
+        gasnete_coll_p2p_advance(op, GASNETE_COLL_REL2ACT(op->team,in_nodes[j]), phase*2);
+      }
+      data->state++;
+    }
+    if((data->state-2) % 3 == 1) {
+      if_pf(gasneti_weakatomic_read(&(data->p2p->counter[phase*2]),0)!=h) return 0;
+      gasneti_sync_reads();
+      for(j=0; j<h; j++) {
+        gasnet_node_t destnode = out_nodes[j];
+        size_t msg_len = 
+        gasnete_coll_exchgv_pack_msg(scratch1+IDX_EXPR, scratch2, lens, args->max_nbytes, GASNETE_COLL_DISSEM_MAX_BLOCKS(dissem),
+                                     phase, dissem->dissemination_radix, j+1, total_ranks);
+        gasneti_assert(msg_len <= slot_size);
+        gasnete_coll_p2p_counting_put(op, GASNETE_COLL_REL2ACT(op->team,destnode), 
+                                      (int8_t*)op->team->scratch_segs[destnode].addr+op->scratchpos[0]+IDXP1_EXPR, scratch1+IDX_EXPR,
+                                      msg_len, phase*2+1);
+      }
+      data->state++;
+      return 0;
+    } 
+    if((data->state-2) % 3 == 2) { /*receive in odd sub phases*/
+      if(gasneti_weakatomic_read(&(data->p2p->counter[phase*2+1]),0) != h) return 0;
+      gasneti_sync_reads();
+      for(j=0; j<h; j++) {
+        gasnete_coll_exchgv_unpack_msg(scratch1+IDXP1_EXPR, scratch2, lens, args->max_nbytes, GASNETE_COLL_DISSEM_MAX_BLOCKS(dissem),
+                                       phase, dissem->dissemination_radix, j+1, total_ranks);
+      }			
+      data->state++;
+      return 0;
+    }
+    
+#undef IDX_EXPR
+#undef IDXP1_EXPR
+    
+  }
+  
+  if(data->state == dissem->dissemination_phases*3+2) {
+    /* block k now holds the data that came from rank myrank-k*/
+    int i;
+    for(i=0; i<total_ranks; i++) {
+      int srcblk = (myrank - i + total_ranks) % total_ranks;
+      gasneti_assert(lens[srcblk] == args->dst_counts[i]);
+      GASNETE_FAST_UNALIGNED_MEMCPY((int8_t*)args->dst+args->dst_offsets[i],
+                                    scratch2+srcblk*args->max_nbytes, lens[srcblk]);
+    }
+    data->state++;
+  }
+  if(data->state == dissem->dissemination_phases*3+3) {
+    if (!gasnete_coll_generic_outsync(op->team, data)) {
+      return 0;
+    }
+    
+    /*free up the scratch space used by this op*/
+    if(total_ranks != 1) {
+      gasnete_coll_free_scratch(op);    
+      gasneti_free(data->private_data);
+    }
+    gasnete_coll_generic_free(op->team, data GASNETE_THREAD_PASS);
+    result = (GASNETE_COLL_OP_COMPLETE | GASNETE_COLL_OP_INACTIVE);
+  }
+  
+  return result;
+}
+
+static gasnet_coll_handle_t
+gasnete_coll_exchgv_Dissem_start(gasnet_team_handle_t team,
+                                 void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                                 void *src, const size_t src_counts[], const size_t src_offsets[],
+                                 size_t max_nbytes, int flags, uint32_t sequence,
+                                 int num_params, uint32_t *param_list
+                                 GASNETE_THREAD_FARG)
+{
+  int options =  GASNETE_COLL_USE_SCRATCH | GASNETE_COLL_GENERIC_OPT_P2P | 
+  GASNETE_COLL_GENERIC_OPT_INSYNC_IF (!(flags & GASNET_COLL_IN_NOSYNC)) |
+  GASNETE_COLL_GENERIC_OPT_OUTSYNC_IF(!(flags & GASNET_COLL_OUT_NOSYNC));
+  gasnete_coll_dissem_info_t *dissem = gasnete_coll_fetch_dissemination(2, team);
+  gasnete_coll_scratch_req_t *scratch_req;
+  
+  gasneti_assert(team->total_images == team->total_ranks);
+  gasneti_assert(max_nbytes <= gasnete_coll_exchgv_dissem_max_nbytes(team, dissem, team->smallest_scratch_seg));
+  
+  /*fill out a scratch request form*/	
+  scratch_req = (gasnete_coll_scratch_req_t*) gasneti_calloc(1,sizeof(gasnete_coll_scratch_req_t));
+  scratch_req->op_type = GASNETE_COLL_DISSEM_OP;
+  scratch_req->team = team;
+  scratch_req->tree_dir = GASNETE_COLL_DOWN_TREE;
+  scratch_req->incoming_size = 
+    max_nbytes*team->total_ranks + GASNETE_COLL_EXCHGV_SLOT_SIZE(dissem, max_nbytes)*2*(dissem->dissemination_radix-1);
+  scratch_req->num_out_peers = scratch_req->num_in_peers = GASNETE_COLL_DISSEM_GET_PEER_COUNT(dissem);
+  scratch_req->out_peers = GASNETE_COLL_DISSEM_GET_FRONT_PEERS(dissem);
+  scratch_req->in_peers = GASNETE_COLL_DISSEM_GET_BEHIND_PEERS(dissem);
+  scratch_req->out_sizes = (uint64_t*) gasneti_malloc(sizeof(uint64_t)*1);
+  scratch_req->out_sizes[0] = scratch_req->incoming_size;
+  
+  return gasnete_coll_generic_exchangev_nb(team, dst, dst_counts, dst_offsets, src, src_counts, src_offsets,
+                                           max_nbytes, flags, &gasnete_coll_pf_exchgv_Dissem, options,
+                                           NULL, dissem, sequence, num_params, param_list, scratch_req GASNETE_THREAD_PASS);
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_exchgv_Dissem(gasnet_team_handle_t team,
+                           void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                           void *src, const size_t src_counts[], const size_t src_offsets[],
+                           size_t max_nbytes, int flags, gasnete_coll_implementation_t coll_params, uint32_t sequence
+                           GASNETE_THREAD_FARG)
+{
+  return gasnete_coll_exchgv_Dissem_start(team, dst, dst_counts, dst_offsets, src, src_counts, src_offsets,
+                                          max_nbytes, flags, sequence, coll_params->num_params, coll_params->param_list
+                                          GASNETE_THREAD_PASS);
+}
+
+/* exchgv Chunked: exchgv_Dissem run once for each chunk of the blocks */
+/* Chunk c carries bytes [c*chunk, (c+1)*chunk) of every block, where chunk is at
+   most what exchgv_Dissem can take in one pass, so any max_nbytes goes through the
+   scratch space.  The chunks run one after the other in subordinate ops.
+   Valid wherever exchgv_Dissem is valid */
+GASNETI_INLINE(gasnete_coll_exchgv_num_chunks)
+size_t gasnete_coll_exchgv_num_chunks(gasnete_coll_team_t team, size_t max_nbytes, size_t *chunk_size) {
+  size_t limit = gasnete_coll_exchgv_dissem_max_nbytes(team, gasnete_coll_fetch_dissemination(2, team), team->smallest_scratch_seg);
+  size_t num_chunks;
+  
+  if_pf(limit == 0) gasneti_fatalerror("gasnet_coll_exchangev(): collective scratch space is too small");
+  num_chunks = MAX(1, (max_nbytes+limit-1)/limit);
+  /* even out the chunks*/
+  *chunk_size = (max_nbytes+num_chunks-1)/num_chunks;
+  return num_chunks;
+}
+
+static int gasnete_coll_pf_exchgv_Chunked(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  const gasnete_coll_exchangev_args_t *args = GASNETE_COLL_GENERIC_ARGS(data, exchangev);
+  const int flags = GASNETE_COLL_FORWARD_FLAGS(op->flags)|GASNETE_COLL_NONROOT_SUBORDINATE|GASNET_COLL_DISABLE_AUTOTUNE;
+  const int total_ranks = op->team->total_ranks;
+  size_t chunk_size;
+  const size_t num_chunks = gasnete_coll_exchgv_num_chunks(op->team, args->max_nbytes, &chunk_size);
+  int result = 0;
+  
+  /*state 2+2*c starts chunk c and state 3+2*c waits for it*/
+  if(data->state == 0) {
+    if (!gasnete_coll_generic_all_threads(data) ||
+        !gasnete_coll_generic_insync(op->team, data)) {
+      return result;
+    }
+    data->state = 1;
+  }
+  
+  if(data->state == 1) {
+    if (!GASNETE_COLL_MAY_INIT_FOR(op)) return result;
+    /* dst_counts, dst_offsets, src_counts and src_offsets of the current chunk*/
+    data->private_data = gasneti_malloc(4*sizeof(size_t)*total_ranks);
+    data->state = 2;
+  }
+  
+  while(data->state >= 2 && data->state < 2+2*num_chunks) {
+    const size_t chunk = (data->state-2)/2;
+    const size_t chunk_off = chunk*chunk_size;
+    size_t *dst_counts = (size_t*) data->private_data;
+    size_t *dst_offsets = dst_counts + total_ranks;
+    size_t *src_counts = dst_offsets + total_ranks;
+    size_t *src_offsets = src_counts + total_ranks;
+    
+    if(data->state % 2 == 0) {
+      int i;
+      for(i=0; i<total_ranks; i++) {
+        dst_counts[i] = (args->dst_counts[i] > chunk_off ? MIN(chunk_size, args->dst_counts[i]-chunk_off) : 0);
+        dst_offsets[i] = args->dst_offsets[i] + (dst_counts[i] ? chunk_off : 0);
+        src_counts[i] = (args->src_counts[i] > chunk_off ? MIN(chunk_size, args->src_counts[i]-chunk_off) : 0);
+        src_offsets[i] = args->src_offsets[i] + (src_counts[i] ? chunk_off : 0);
+      }
+      data->coll_handle = gasnete_coll_exchgv_Dissem_start(op->team, args->dst, dst_counts, dst_offsets,
+                                                           args->src, src_counts, src_offsets, chunk_size, flags,
+                                                           op->sequence+chunk+1, 0, NULL GASNETE_THREAD_PASS);
+      gasnete_coll_save_coll_handle(&data->coll_handle GASNETE_THREAD_PASS);
+      data->state++;
+    }
+    if (!gasnete_coll_generic_coll_sync(&data->coll_handle, 1 GASNETE_THREAD_PASS)) {
+      return result;
+    }
+    data->state++;
+  }
+  
+  if(data->state == 2+2*num_chunks) {
+    if (!gasnete_coll_generic_outsync(op->team, data)) {
+      return result;
+    }
+    
+    gasneti_free(data->private_data);
+    gasnete_coll_generic_free(op->team, data GASNETE_THREAD_PASS);
+    result = (GASNETE_COLL_OP_COMPLETE | GASNETE_COLL_OP_INACTIVE);
+  }
+  
+  return result;
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_exchgv_Chunked(gasnet_team_handle_t team,
+                            void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                            void *src, const size_t src_counts[], const size_t src_offsets[],
+                            size_t max_nbytes, int flags, gasnete_coll_implementation_t coll_params, uint32_t sequence
+                            GASNETE_THREAD_FARG)
+{
+  int options = GASNETE_COLL_GENERIC_OPT_INSYNC_IF (!(flags & GASNET_COLL_IN_NOSYNC)) |
+		GASNETE_COLL_GENERIC_OPT_OUTSYNC_IF(!(flags & GASNET_COLL_OUT_NOSYNC));
+  size_t chunk_size;
+  size_t num_chunks = gasnete_coll_exchgv_num_chunks(team, max_nbytes, &chunk_size);
+  
+  gasneti_assert(team->total_images == team->total_ranks);
+  /* one subordinate op per chunk follows this one*/
+  return gasnete_coll_generic_exchangev_nb(team, dst, dst_counts, dst_offsets, src, src_counts, src_offsets,
+                                           max_nbytes, flags, &gasnete_coll_pf_exchgv_Chunked, options,
+                                           NULL, NULL, (flags & GASNETE_COLL_SUBORDINATE ? sequence : num_chunks),
+                                           coll_params->num_params, coll_params->param_list, NULL GASNETE_THREAD_PASS);
+}
+
 /*---------------------------------------------------------------------------------*/
 /* gasnete_coll_exchangeM_nb() */
 
@@ -5763,8 +6413,9 @@ static int gasnete_coll_pf_reduce_TreePut(gasnete_coll_op_t *op GASNETE_THREAD_F
        volatile uint32_t *state;
        size_t nbytes = args->nbytes;
        int i, done;
-       gasnet_coll_reduce_fn_t reduce_fn = gasnete_coll_fn_tbl[args->func].fnptr;
-       uint32_t red_fn_flags = gasnete_coll_fn_tbl[args->func].flags;
+       const gasnet_coll_fn_entry_t *reduce_ent = gasnete_coll_fn_lookup(args->func);
+       gasnet_coll_reduce_fn_t reduce_fn = reduce_ent->fnptr;
+       uint32_t red_fn_flags = reduce_ent->flags;
        uint32_t reduce_args = args->func_arg;
        
        gasneti_assert(data->p2p != NULL);
@@ -5943,8 +6594,9 @@ static int gasnete_coll_pf_reduce_TreeGet(gasnete_coll_op_t *op GASNETE_THREAD_F
         volatile uint32_t *state;
         size_t nbytes = args->nbytes;
         int i, done;
-        gasnet_coll_reduce_fn_t reduce_fn = gasnete_coll_fn_tbl[args->func].fnptr;
-        uint32_t red_fn_flags = gasnete_coll_fn_tbl[args->func].flags;
+        const gasnet_coll_fn_entry_t *reduce_ent = gasnete_coll_fn_lookup(args->func);
+        gasnet_coll_reduce_fn_t reduce_fn = reduce_ent->fnptr;
+        uint32_t red_fn_flags = reduce_ent->flags;
         uint32_t reduce_args = args->func_arg;
         gasneti_assert(data->p2p != NULL);
         gasneti_assert(data->p2p->state != NULL);
@@ -6287,8 +6939,9 @@ static int gasnete_coll_pf_reduceM_TreePut(gasnete_coll_op_t *op GASNETE_THREAD_
         volatile uint32_t *state;
         size_t nbytes = args->nbytes;
         int i, done;
-        gasnet_coll_reduce_fn_t reduce_fn = gasnete_coll_fn_tbl[args->func].fnptr;
-        uint32_t red_fn_flags = gasnete_coll_fn_tbl[args->func].flags;
+        const gasnet_coll_fn_entry_t *reduce_ent = gasnete_coll_fn_lookup(args->func);
+        gasnet_coll_reduce_fn_t reduce_fn = reduce_ent->fnptr;
+        uint32_t red_fn_flags = reduce_ent->flags;
         uint32_t reduce_args = args->func_arg;
         
         gasneti_assert(data->p2p != NULL);
@@ -6478,8 +7131,9 @@ static int gasnete_coll_pf_reduceM_TreeGet(gasnete_coll_op_t *op GASNETE_THREAD_
         volatile uint32_t *state;
         size_t nbytes = args->nbytes;
         int i, done;
-        gasnet_coll_reduce_fn_t reduce_fn = gasnete_coll_fn_tbl[args->func].fnptr;
-        uint32_t red_fn_flags = gasnete_coll_fn_tbl[args->func].flags;
+        const gasnet_coll_fn_entry_t *reduce_ent = gasnete_coll_fn_lookup(args->func);
+        gasnet_coll_reduce_fn_t reduce_fn = reduce_ent->fnptr;
+        uint32_t red_fn_flags = reduce_ent->flags;
         uint32_t reduce_args = args->func_arg;
         gasneti_assert(data->p2p != NULL);
         gasneti_assert(data->p2p->state != NULL);
@@ -6778,3 +7432,370 @@ gasnete_coll_reduceM_TreePutSeg(gasnet_team_handle_t team,
   
 }
 
+
+/*---------------------------------------------------------------------------------*/
+/* Reduce All / Reduce Scatter*/
+/* Butterfly algorithms over the pairing in gasnete_coll_butterfly_info_t.
+   All of them require one image per node and a commutative reduction function
+   (the order in which contributions get combined differs from rank to rank).
+   
+   Scratch layout (identical on every rank, N = elements in the full vector):
+   [ACC: N elems][FOLD: N elems][one incoming slot per exchange step]
+   RecDbl steps each receive the whole vector.  The halving steps of Rabenseifner
+   and RecHalv receive a range of blocks (bs = ceil(N/pof2) elements per block):
+   reduce-scatter step k gets pof2>>(k+1) blocks and allgather step j gets 1<<j.
+   
+   Counter indices: 0 for the fold, 1+step for each exchange step and 
+   1+num_steps for the result returned to a folded out rank.
+   Transfers larger than gasnet_AMMaxLongRequest() are sent in pieces that all 
+   advance the same counter.*/
+
+#define GASNETE_COLL_BFLY_FOLD_STATE 2
+#define GASNETE_COLL_BFLY_FIRST_STEP_STATE 3
+
+static void gasnete_coll_bfly_put(gasnete_coll_op_t *op, gasnet_node_t rank, 
+                                  int8_t *dst, int8_t *src, size_t nbytes, uint32_t idx) {
+  const size_t max_long = gasnet_AMMaxLongRequest();
+  gasnet_node_t node = GASNETE_COLL_REL2ACT(op->team, rank);
+  
+  if(nbytes == 0) {
+    gasnete_coll_p2p_advance(op, node, idx);
+    return;
+  }
+  while(nbytes > 0) {
+    size_t len = MIN(nbytes, max_long);
+    gasnete_coll_p2p_counting_put(op, node, dst, src, len, idx);
+    dst += len; src += len; nbytes -= len;
+  }
+}
+
+GASNETI_INLINE(gasnete_coll_bfly_arrived)
+int gasnete_coll_bfly_arrived(gasnete_coll_generic_data_t *data, size_t nbytes, uint32_t idx) {
+  const size_t max_long = gasnet_AMMaxLongRequest();
+  uint32_t expected = (nbytes == 0 ? 1 : (nbytes+max_long-1)/max_long);
+  
+  if(gasneti_weakatomic_read(&(data->p2p->counter[idx]), 0) < expected) return 0;
+  gasneti_sync_reads();
+  return 1;
+}
+
+/* offset (in elements) of block b for a vector of count elements cut into blocks of bs*/
+#define GASNETE_COLL_BFLY_BLK_OFF(B, BS, COUNT) MIN((size_t)(B)*(BS), (COUNT))
+
+/* Describes step s of a butterfly: which partner, which element ranges get 
+   sent and received and where the received range lands in the partner's scratch*/
+typedef struct {
+  int phase;             /*index into bfly->partners*/
+  size_t send_off, send_count;
+  size_t recv_off, recv_count;
+  size_t slot_off;       /*byte offset of this step's slot past ACC and FOLD*/
+  int reduce;            /*reduce the received range into ACC (else just copy it)*/
+} gasnete_coll_bfly_step_t;
+
+static void gasnete_coll_bfly_get_step(const gasnete_coll_butterfly_info_t *bfly, int halving, 
+                                       size_t count, size_t elem_size, int s, 
+                                       gasnete_coll_bfly_step_t *step) {
+  const int P = bfly->phases;
+  const int r = bfly->newrank;
+  
+  if(!halving) {
+    step->phase = s;
+    step->send_off = step->recv_off = 0;
+    step->send_count = step->recv_count = count;
+    step->slot_off = s*count*elem_size;
+    step->reduce = 1;
+  } else {
+    const size_t bs = (count + bfly->pof2 - 1)/bfly->pof2;
+    int mask, send_lo, recv_lo;
+    
+    if(s < P) {
+      /* reduce-scatter by recursive halving: keep the half of my current range 
+         that holds my own block and hand the other half to the partner*/
+      mask = bfly->pof2 >> (s+1);
+      step->phase = P-1-s;
+      recv_lo = (r & ~(2*mask-1)) + (r & mask);
+      send_lo = recv_lo ^ mask;
+      step->slot_off = (bfly->pof2 - (bfly->pof2 >> s))*bs*elem_size;
+      step->reduce = 1;
+    } else {
+      /* allgather by recursive doubling: swap the reduced ranges*/
+      int j = s-P;
+      mask = 1<<j;
+      step->phase = j;
+      send_lo = r & ~(mask-1);
+      recv_lo = send_lo ^ mask;
+      step->slot_off = ((bfly->pof2-1) + (mask-1))*bs*elem_size;
+      step->reduce = 0;
+    }
+    step->send_off = GASNETE_COLL_BFLY_BLK_OFF(send_lo, bs, count);
+    step->send_count = GASNETE_COLL_BFLY_BLK_OFF(send_lo+mask, bs, count) - step->send_off;
+    step->recv_off = GASNETE_COLL_BFLY_BLK_OFF(recv_lo, bs, count);
+    step->recv_count = GASNETE_COLL_BFLY_BLK_OFF(recv_lo+mask, bs, count) - step->recv_off;
+  }
+}
+
+/* Scratch space (per rank) needed to reduce count elements*/
+static size_t gasnete_coll_bfly_scratch_size(const gasnete_coll_butterfly_info_t *bfly, int halving,
+                                             int num_steps, size_t count, size_t elem_size) {
+  size_t nbytes = count*elem_size;
+  if(!halving) {
+    return nbytes*(2+num_steps);
+  } else {
+    const size_t bs = (count + bfly->pof2 - 1)/bfly->pof2;
+    return 2*nbytes + 2*(bfly->pof2-1)*bs*elem_size;
+  }
+}
+
+static gasnete_coll_scratch_req_t *gasnete_coll_bfly_scratch_req(gasnete_coll_team_t team,
+                                                                  const gasnete_coll_butterfly_info_t *bfly,
+                                                                  size_t incoming_size) {
+  gasnete_coll_scratch_req_t *scratch_req;
+  int i;
+  
+  scratch_req = (gasnete_coll_scratch_req_t*) gasneti_calloc(1,sizeof(gasnete_coll_scratch_req_t));
+  scratch_req->team = team;
+  scratch_req->op_type = GASNETE_COLL_BUTTERFLY_OP;
+  scratch_req->tree_dir = GASNETE_COLL_UP_TREE;
+  scratch_req->incoming_size = incoming_size;
+  scratch_req->num_in_peers = scratch_req->num_out_peers = bfly->num_peers;
+  if(bfly->num_peers > 0) {
+    scratch_req->in_peers = scratch_req->out_peers = bfly->peers;
+    scratch_req->out_sizes = (uint64_t*) gasneti_malloc(sizeof(uint64_t)*bfly->num_peers);
+    /* every rank asks for the same amount of space*/
+    for(i=0; i<bfly->num_peers; i++) scratch_req->out_sizes[i] = incoming_size;
+  } else {
+    scratch_req->in_peers = scratch_req->out_peers = NULL;
+    scratch_req->out_sizes = NULL;
+  }
+  return scratch_req;
+}
+
+/* Shared poll function body
+   halving: exchange halves (Rabenseifner/RecHalv) rather than whole vectors (RecDbl)
+   scatter: leave only my block (elem_count elements) of the result in dst
+   The number of steps is the number of phases for RecDbl and RecHalv (only the 
+   reduce-scatter half runs) and twice that for Rabenseifner*/
+static int gasnete_coll_bfly_reduce_poll(gasnete_coll_op_t *op, 
+                                         const gasnete_coll_reduce_all_args_t *args,
+                                         int halving, int num_steps, int scatter
+                                         GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  const gasnete_coll_butterfly_info_t *bfly = op->team->butterfly_info;
+  const size_t count = (scatter ? args->elem_count*op->team->total_ranks : args->elem_count);
+  const size_t elem_size = args->elem_size;
+  const size_t full_bytes = count*elem_size;
+  int8_t *acc = ((int8_t*)op->team->scratch_segs[op->team->myrank].addr)+op->myscratchpos;
+  int8_t *fold = acc + full_bytes;
+  int result = 0;
+  
+  gasneti_assert(bfly != NULL);
+  
+  switch (data->state) {
+    case 0: /*scratch alloc*/
+      if(!gasnete_coll_scratch_alloc_nb(op GASNETE_THREAD_PASS)) {
+        break;
+      }
+      data->state = 1;
+    case 1:	/* Optional IN barrier */
+      if (!gasnete_coll_generic_all_threads(data) ||
+          !gasnete_coll_generic_insync(op->team, data)) {
+        break;
+      }
+      /* refresh now that the scratch space has been assigned*/
+      acc = ((int8_t*)op->team->scratch_segs[op->team->myrank].addr)+op->myscratchpos;
+      fold = acc + full_bytes;
+      if(GASNETE_COLL_BUTTERFLY_FOLDED_OUT(bfly)) {
+        /* hand my contribution to the fold peer and wait for the result*/
+        int8_t *peer_fold = ((int8_t*)op->team->scratch_segs[bfly->fold_peer].addr) + 
+          op->scratchpos[GASNETE_COLL_BUTTERFLY_FOLD_IDX(bfly)] + full_bytes;
+        gasnete_coll_bfly_put(op, bfly->fold_peer, peer_fold, args->src, full_bytes, 0);
+        /* skip straight to waiting for the result*/
+        data->state = GASNETE_COLL_BFLY_FIRST_STEP_STATE + 2*num_steps;
+        break;
+      }
+      GASNETE_FAST_UNALIGNED_MEMCPY(acc, args->src, full_bytes);
+      data->state = GASNETE_COLL_BFLY_FOLD_STATE;
+    case GASNETE_COLL_BFLY_FOLD_STATE:
+      if(GASNETE_COLL_BUTTERFLY_HAS_FOLD(bfly)) {
+        const gasnet_coll_fn_entry_t *reduce_ent = gasnete_coll_fn_lookup(args->func);
+        if(!gasnete_coll_bfly_arrived(data, full_bytes, 0)) break;
+        (*reduce_ent->fnptr)(acc, count, acc, count, fold, elem_size, 
+                             reduce_ent->flags, args->func_arg);
+      }
+      data->state = GASNETE_COLL_BFLY_FIRST_STEP_STATE;
+    default:
+      /* two states per step: even ones send, odd ones wait and combine*/
+      while(data->state < GASNETE_COLL_BFLY_FIRST_STEP_STATE + 2*num_steps) {
+        const int s = (data->state - GASNETE_COLL_BFLY_FIRST_STEP_STATE)/2;
+        gasnete_coll_bfly_step_t step;
+        int8_t *slot;
+        
+        gasnete_coll_bfly_get_step(bfly, halving, count, elem_size, s, &step);
+        slot = fold + full_bytes + step.slot_off;
+        if((data->state - GASNETE_COLL_BFLY_FIRST_STEP_STATE)%2 == 0) {
+          const gasnet_node_t partner = bfly->partners[step.phase];
+          int8_t *remote_slot = ((int8_t*)op->team->scratch_segs[partner].addr) + 
+            op->scratchpos[GASNETE_COLL_BUTTERFLY_PARTNER_IDX(bfly, step.phase)] + 2*full_bytes + step.slot_off;
+          gasnete_coll_bfly_put(op, partner, remote_slot, acc + step.send_off*elem_size, 
+                                step.send_count*elem_size, 1+s);
+          data->state++;
+        } else {
+          int8_t *dst_range = acc + step.recv_off*elem_size;
+          if(!gasnete_coll_bfly_arrived(data, step.recv_count*elem_size, 1+s)) {
+            return result;
+          }
+          if(step.reduce) {
+            const gasnet_coll_fn_entry_t *reduce_ent = gasnete_coll_fn_lookup(args->func);
+            (*reduce_ent->fnptr)(dst_range, step.recv_count, dst_range, step.recv_count, 
+                                 slot, elem_size, reduce_ent->flags, args->func_arg);
+          } else {
+            GASNETE_FAST_UNALIGNED_MEMCPY(dst_range, slot, step.recv_count*elem_size);
+          }
+          data->state++;
+        }
+      }
+      
+      if(data->state == GASNETE_COLL_BFLY_FIRST_STEP_STATE + 2*num_steps) {
+        int8_t *res = acc;
+        if(GASNETE_COLL_BUTTERFLY_FOLDED_OUT(bfly)) {
+          if(!gasnete_coll_bfly_arrived(data, full_bytes, 1+num_steps)) {
+            break;
+          }
+          res = fold;
+        } else if(GASNETE_COLL_BUTTERFLY_HAS_FOLD(bfly)) {
+          int8_t *peer_fold = ((int8_t*)op->team->scratch_segs[bfly->fold_peer].addr) + 
+            op->scratchpos[GASNETE_COLL_BUTTERFLY_FOLD_IDX(bfly)] + full_bytes;
+          gasnete_coll_bfly_put(op, bfly->fold_peer, peer_fold, acc, full_bytes, 1+num_steps);
+        }
+        if(scatter) {
+          GASNETE_FAST_UNALIGNED_MEMCPY(args->dst, res + op->team->myrank*args->nbytes, args->nbytes);
+        } else {
+          GASNETE_FAST_UNALIGNED_MEMCPY(args->dst, res, full_bytes);
+        }
+        gasneti_sync_writes();
+        data->state++;
+      }
+      
+      if (!gasnete_coll_generic_outsync(op->team, data)) {
+        break;
+      }
+      gasnete_coll_generic_free(op->team, data GASNETE_THREAD_PASS);
+      result = (GASNETE_COLL_OP_COMPLETE | GASNETE_COLL_OP_INACTIVE);
+      gasnete_coll_free_scratch(op);
+  }
+  
+  return result;
+}
+
+static int gasnete_coll_pf_reduce_all_RecDbl(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  return gasnete_coll_bfly_reduce_poll(op, GASNETE_COLL_GENERIC_ARGS(data, reduce_all), 
+                                       0, op->team->butterfly_info->phases, 0 GASNETE_THREAD_PASS);
+}
+
+static int gasnete_coll_pf_reduce_all_Rabenseifner(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  return gasnete_coll_bfly_reduce_poll(op, GASNETE_COLL_GENERIC_ARGS(data, reduce_all), 
+                                       1, 2*op->team->butterfly_info->phases, 0 GASNETE_THREAD_PASS);
+}
+
+static int gasnete_coll_pf_reduce_scatter_RecDbl(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  return gasnete_coll_bfly_reduce_poll(op, GASNETE_COLL_GENERIC_ARGS(data, reduce_scatter), 
+                                       0, op->team->butterfly_info->phases, 1 GASNETE_THREAD_PASS);
+}
+
+static int gasnete_coll_pf_reduce_scatter_RecHalv(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  return gasnete_coll_bfly_reduce_poll(op, GASNETE_COLL_GENERIC_ARGS(data, reduce_scatter), 
+                                       1, op->team->butterfly_info->phases, 1 GASNETE_THREAD_PASS);
+}
+
+#define GASNETE_COLL_BFLY_OPTIONS(FLAGS) \
+  (GASNETE_COLL_GENERIC_OPT_INSYNC_IF (FLAGS & GASNET_COLL_IN_ALLSYNC) | \
+   GASNETE_COLL_GENERIC_OPT_OUTSYNC_IF(FLAGS & GASNET_COLL_OUT_ALLSYNC) | \
+   GASNETE_COLL_GENERIC_OPT_P2P_IF(1) | GASNETE_COLL_USE_SCRATCH)
+
+extern gasnet_coll_handle_t
+gasnete_coll_reduce_all_RecDbl(gasnet_team_handle_t team,
+                               void *dst, void *src,
+                               size_t elem_size, size_t elem_count,
+                               gasnet_coll_fn_handle_t func, int func_arg,
+                               int flags, 
+                               gasnete_coll_implementation_t coll_params,
+                               uint32_t sequence
+                               GASNETE_THREAD_FARG) {
+  gasnete_coll_butterfly_info_t *bfly = gasnete_coll_fetch_butterfly(team);
+  size_t incoming = gasnete_coll_bfly_scratch_size(bfly, 0, bfly->phases, elem_count, elem_size);
+  
+  gasneti_assert(team->total_images == team->total_ranks);
+  return gasnete_coll_generic_reduce_all_nb(team, dst, src, elem_size, elem_count, func, func_arg, flags,
+                                            &gasnete_coll_pf_reduce_all_RecDbl, GASNETE_COLL_BFLY_OPTIONS(flags),
+                                            NULL, sequence, coll_params->num_params, coll_params->param_list,
+                                            gasnete_coll_bfly_scratch_req(team, bfly, incoming)
+                                            GASNETE_THREAD_PASS);
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_reduce_all_Rabenseifner(gasnet_team_handle_t team,
+                                     void *dst, void *src,
+                                     size_t elem_size, size_t elem_count,
+                                     gasnet_coll_fn_handle_t func, int func_arg,
+                                     int flags, 
+                                     gasnete_coll_implementation_t coll_params,
+                                     uint32_t sequence
+                                     GASNETE_THREAD_FARG) {
+  gasnete_coll_butterfly_info_t *bfly = gasnete_coll_fetch_butterfly(team);
+  size_t incoming = gasnete_coll_bfly_scratch_size(bfly, 1, 2*bfly->phases, elem_count, elem_size);
+  
+  gasneti_assert(team->total_images == team->total_ranks);
+  return gasnete_coll_generic_reduce_all_nb(team, dst, src, elem_size, elem_count, func, func_arg, flags,
+                                            &gasnete_coll_pf_reduce_all_Rabenseifner, GASNETE_COLL_BFLY_OPTIONS(flags),
+                                            NULL, sequence, coll_params->num_params, coll_params->param_list,
+                                            gasnete_coll_bfly_scratch_req(team, bfly, incoming)
+                                            GASNETE_THREAD_PASS);
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_reduce_scatter_RecDbl(gasnet_team_handle_t team,
+                                   void *dst, void *src,
+                                   size_t elem_size, size_t elem_count,
+                                   gasnet_coll_fn_handle_t func, int func_arg,
+                                   int flags, 
+                                   gasnete_coll_implementation_t coll_params,
+                                   uint32_t sequence
+                                   GASNETE_THREAD_FARG) {
+  gasnete_coll_butterfly_info_t *bfly = gasnete_coll_fetch_butterfly(team);
+  size_t incoming = gasnete_coll_bfly_scratch_size(bfly, 0, bfly->phases, 
+                                                   elem_count*team->total_ranks, elem_size);
+  
+  gasneti_assert(team->total_images == team->total_ranks);
+  return gasnete_coll_generic_reduce_scatter_nb(team, dst, src, elem_size, elem_count, func, func_arg, flags,
+                                                &gasnete_coll_pf_reduce_scatter_RecDbl, GASNETE_COLL_BFLY_OPTIONS(flags),
+                                                NULL, sequence, coll_params->num_params, coll_params->param_list,
+                                                gasnete_coll_bfly_scratch_req(team, bfly, incoming)
+                                                GASNETE_THREAD_PASS);
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_reduce_scatter_RecHalv(gasnet_team_handle_t team,
+                                    void *dst, void *src,
+                                    size_t elem_size, size_t elem_count,
+                                    gasnet_coll_fn_handle_t func, int func_arg,
+                                    int flags, 
+                                    gasnete_coll_implementation_t coll_params,
+                                    uint32_t sequence
+                                    GASNETE_THREAD_FARG) {
+  gasnete_coll_butterfly_info_t *bfly = gasnete_coll_fetch_butterfly(team);
+  size_t incoming = gasnete_coll_bfly_scratch_size(bfly, 1, bfly->phases, 
+                                                   elem_count*team->total_ranks, elem_size);
+  
+  /* each rank's block must line up with a butterfly block*/
+  gasneti_assert(team->total_images == team->total_ranks);
+  gasneti_assert(bfly->pof2 == team->total_ranks);
+  return gasnete_coll_generic_reduce_scatter_nb(team, dst, src, elem_size, elem_count, func, func_arg, flags,
+                                                &gasnete_coll_pf_reduce_scatter_RecHalv, GASNETE_COLL_BFLY_OPTIONS(flags),
+                                                NULL, sequence, coll_params->num_params, coll_params->param_list,
+                                                gasnete_coll_bfly_scratch_req(team, bfly, incoming)
+                                                GASNETE_THREAD_PASS);
+}
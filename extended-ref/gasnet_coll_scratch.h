@@ -20,7 +20,9 @@ typedef struct gasnete_coll_node_scratch_status_t_ gasnete_coll_node_scratch_sta
 /* up tree means that we send to relative ranks that are lower than us*/
 typedef enum {GASNETE_COLL_UP_TREE=0, GASNETE_COLL_DOWN_TREE} gasnete_coll_tree_dir_t;
 
-typedef enum {GASNETE_COLL_DISSEM_OP=0, GASNETE_COLL_TREE_OP} gasnete_coll_op_type_t;
+/* butterfly ops have a fixed symmetric peer set (see gasnete_coll_butterfly_info_t)
+   and use out_sizes[i] per peer, like tree ops*/
+typedef enum {GASNETE_COLL_DISSEM_OP=0, GASNETE_COLL_TREE_OP, GASNETE_COLL_BUTTERFLY_OP} gasnete_coll_op_type_t;
 
 struct gasnete_coll_scratch_req_t_ {
   
@@ -129,6 +129,7 @@ static void initialize_team_fields(gasnete_coll_team_t team,
   team->dissem_cache_head = NULL;
   team->dissem_cache_tail = NULL;
   gasneti_mutex_init(&team->dissem_cache_lock);
+  team->butterfly_info = NULL;
   team->myrank = myrank;
   team->total_ranks = num_members;
   team->scratch_segs = scratch_segments;
@@ -138,6 +139,7 @@ static void initialize_team_fields(gasnete_coll_team_t team,
                                                    smallest_scratch_seg GASNETE_THREAD_PASS);
   team->consensus_issued_id = 0;
   team->consensus_id = 0;
+  team->poller = NULL;
   gasnete_coll_alloc_new_scratch_status(team);
   gasneti_weakatomic_set(&team->num_multi_addr_collectives_started, 0, GASNETT_ATOMIC_WMB_PRE);
   if(!team->fixed_image_count && team->myrank ==0) {
@@ -146,14 +148,47 @@ static void initialize_team_fields(gasnete_coll_team_t team,
   }
   
 #ifndef GASNETE_COLL_P2P_OVERRIDE
-  gasnet_hsl_init(&team->p2p_lock);
-  team->p2p_freelist = NULL;
   for (i = 0; i < GASNETE_COLL_P2P_TABLE_SIZE; ++i) {
-    team->p2p_table[i] = NULL;
+    gasnet_hsl_init(&team->p2p_table[i].lock);
+    team->p2p_table[i].head = NULL;
+    team->p2p_table[i].freelist = NULL;
   }
 #endif
 }
 
+#if GASNET_PSHM
+/* Setup barrier for a team's PSHM smp_coll handle */
+static void gasnete_coll_smp_pshm_bootstrap(smp_coll_t handle, int flags) {
+  gasnete_coll_team_t team = (gasnete_coll_team_t) smp_coll_bootstrap_arg(handle);
+  gasnete_coll_barrier(team, 0, GASNET_BARRIERFLAG_UNNAMED GASNETE_THREAD_GET);
+}
+
+/* Other members may be waiting on our progress while we spin on the shared flags */
+static void gasnete_coll_smp_pshm_poll(void) {
+  gasneti_AMPoll();
+  gasnete_coll_poll(GASNETE_THREAD_GET_ALONE);
+}
+
+/* Returns the team's PSHM smp_coll handle, building it on first use.
+ * Setup runs a barrier over the team, which is only safe once every member
+ * has finished creating the team, so it cannot be done in gasnete_coll_team_init().
+ * Must be called collectively (e.g. by every member running the same algorithm).
+ */
+smp_coll_t gasnete_coll_smp_pshm_handle(gasnete_coll_team_t team) {
+  gasneti_assert(team->smp_pshm.region != NULL);
+  if_pf (!team->smp_pshm.handle) {
+    int tune_barriers = gasneti_getenv_yesno_withdefault("GASNET_COLL_TUNE_SMP_BARRIER", 0);
+    smp_coll_t handle = smp_coll_init_pshm(team->smp_pshm.region,
+                                           (tune_barriers ? 0 : SMP_COLL_SKIP_TUNE_BARRIERS),
+                                           team->total_ranks, team->myrank,
+                                           &gasnete_coll_smp_pshm_bootstrap, team);
+    smp_coll_set_poll_fn(handle, &gasnete_coll_smp_pshm_poll);
+    team->smp_pshm.handle = handle;
+  }
+  return team->smp_pshm.handle;
+}
+#endif
+
 /* Helper for gasnete_coll_team_init() */
 static int gasnete_node_pair_sort_fn(const void *a_p, const void *b_p) {
   const int a0 = ((const gasnet_node_t *)a_p)[0];
@@ -190,7 +225,6 @@ void gasnete_coll_team_init(gasnet_team_handle_t team,
   
   gasnet_node_t *supernodes = NULL;
   uint32_t i;
-  initialize_team_fields(team, images, myrank, total_ranks, scratch_segs GASNETE_THREAD_PASS); 
   team->team_id = team_id;
   team->total_ranks = total_ranks;
   team->myrank = myrank;
@@ -277,8 +311,75 @@ void gasnete_coll_team_init(gasnet_team_handle_t team,
       }
     }
   }
+
+  /* Group the team's ranks by supernode (unless already constructed) */
+  if (!team->supernode_grps.ranks) {
+    gasnet_node_t *rank_vector = gasneti_malloc(2 * total_ranks * sizeof(gasnet_node_t));
+    gasnet_node_t *first = gasneti_malloc((total_ranks + 1) * sizeof(gasnet_node_t));
+    gasnet_node_t *ranks = gasneti_malloc(total_ranks * sizeof(gasnet_node_t));
+    gasnet_node_t *grp_of = gasneti_malloc(total_ranks * sizeof(gasnet_node_t));
+    gasnet_node_t count = 0;
+    gasnet_node_t max_count = 0;
+
+    /* Sort (supernode,rank) so that groups follow in supernode order */
+    for (i = 0; i < total_ranks; ++i) {
+      rank_vector[2*i+0] = gasneti_node2supernode(rel2act_map[i]);
+      rank_vector[2*i+1] = i;
+    }
+    qsort(rank_vector, total_ranks, 2*sizeof(gasnet_node_t), &gasnete_node_pair_sort_fn);
+
+    for (i = 0; i < total_ranks; ++i) {
+      if (!i || (rank_vector[2*i] != rank_vector[2*(i-1)])) {
+        first[count++] = i;
+      }
+      ranks[i] = rank_vector[2*i+1];
+      grp_of[ranks[i]] = count - 1;
+    }
+    gasneti_free(rank_vector);
+    gasneti_assert(count == team->supernode.grp_count);
+    first[count] = total_ranks;
+    for (i = 0; i < count; ++i) {
+      max_count = MAX(max_count, first[i+1] - first[i]);
+    }
+
+    team->supernode_grps.ranks = ranks;
+    team->supernode_grps.first = first;
+    team->supernode_grps.grp_of = grp_of;
+    team->supernode_grps.max_count = max_count;
+  }
+
+  /* Teams within one supernode reserve the tail of every member's scratch space
+   * (uniformly, to keep the sizes consistent) and use rank 0's tail for the flags
+   * of the cross-process smp_coll algorithms.  The handle itself is built on first
+   * use (see gasnete_coll_smp_pshm_handle()).  This must precede initialize_team_fields() which
+   * sizes the scratch space and registers the algorithms.
+   */
+  if (!team->smp_pshm.region && (total_ranks > 1) && (team->supernode.grp_count == 1) &&
+      gasneti_getenv_yesno_withdefault("GASNET_COLL_SMP_PSHM", 1)) {
+    const size_t len = GASNETI_ALIGNUP(smp_coll_pshm_region_size(total_ranks), GASNETI_CACHE_LINE_BYTES);
+    int ok = 1;
+    if (images) {
+      for (i = 0; i < total_ranks; ++i) ok &= (images[i] == 1);
+    }
+    for (i = 0; i < total_ranks; ++i) {
+      ok &= (scratch_segs[i].size >= len + GASNETE_COLL_MIN_SCRATCH_SIZE_DEFAULT);
+    }
+    if (ok) {
+      gasnet_seginfo_t *segs = gasneti_malloc(total_ranks * sizeof(gasnet_seginfo_t));
+      for (i = 0; i < total_ranks; ++i) {
+        segs[i].addr = scratch_segs[i].addr;
+        segs[i].size = scratch_segs[i].size - len;
+      }
+      team->smp_pshm.region = gasneti_pshm_addr2local(rel2act_map[0], (uint8_t *)segs[0].addr + segs[0].size);
+      team->smp_pshm.scratch_segs = segs;
+      scratch_segs = segs;
+    }
+  }
 #endif
 
+  /* Done after the supernode info is built, which the autotuner uses */
+  initialize_team_fields(team, images, myrank, total_ranks, scratch_segs GASNETE_THREAD_PASS); 
+
   /* lock the team directory (team_dir) */
   /* add the new team to the directory */
   if (team_dir == NULL) {
@@ -316,7 +417,16 @@ void gasnete_coll_team_fini(gasnet_team_handle_t team)
   gasneti_free(team->peers.fwd);
 #if GASNET_PSHM
   gasneti_free(team->supernode_peers.fwd);
+  gasneti_free(team->supernode_grps.ranks);
+  gasneti_free(team->supernode_grps.first);
+  gasneti_free(team->supernode_grps.grp_of);
+  if (team->smp_pshm.handle) smp_coll_fini(team->smp_pshm.handle);
+  gasneti_free(team->smp_pshm.scratch_segs);
 #endif
+  if (team->butterfly_info) {
+    gasneti_free(team->butterfly_info->peers);
+    gasneti_free(team->butterfly_info);
+  }
 
   gasneti_assert(team_dir != NULL);
   gasnete_hashtable_remove(team_dir, team->team_id, NULL);
@@ -324,7 +434,7 @@ void gasnete_coll_team_fini(gasnet_team_handle_t team)
 #if !defined(GASNETE_COLL_P2P_OVERRIDE) && GASNET_DEBUG
   for (i = 0; i < GASNETE_COLL_P2P_TABLE_SIZE; ++i) {
     /* Check that table is actually empty */
-    gasneti_assert(team->p2p_table[i] == NULL);
+    gasneti_assert(team->p2p_table[i].head == NULL);
   }
 #endif
 
@@ -1163,3 +1163,60 @@ gasnete_coll_dissem_info_t *gasnete_coll_fetch_dissemination(int radix, gasnete_
 void gasnete_coll_release_dissemination(gasnete_coll_dissem_info_t *obj, gasnete_coll_team_t team) {
   /* do nothing for now */
 }
+
+static
+gasnete_coll_butterfly_info_t *gasnete_coll_build_butterfly(gasnete_coll_team_t team) {
+  gasnete_coll_butterfly_info_t *ret;
+  const int n = team->total_ranks;
+  const int me = team->myrank;
+  int k;
+  
+  ret = (gasnete_coll_butterfly_info_t*) gasneti_calloc(1, sizeof(gasnete_coll_butterfly_info_t));
+  ret->pof2 = 1; ret->phases = 0;
+  while(ret->pof2*2 <= n) {
+    ret->pof2 *= 2;
+    ret->phases++;
+  }
+  ret->rem = n - ret->pof2;
+  
+  if(me < 2*ret->rem) {
+    if(me % 2 == 0) {
+      ret->newrank = -1;
+      ret->fold_peer = me+1;
+    } else {
+      ret->newrank = me/2;
+      ret->fold_peer = me-1;
+    }
+  } else {
+    ret->newrank = me - ret->rem;
+    ret->fold_peer = -1;
+  }
+  
+  ret->peers = (gasnet_node_t*) gasneti_malloc(sizeof(gasnet_node_t)*(ret->phases+1));
+  ret->num_peers = 0;
+  if(ret->fold_peer >= 0) ret->peers[ret->num_peers++] = ret->fold_peer;
+  if(ret->newrank >= 0) {
+    ret->partners = ret->peers + ret->num_peers;
+    for(k=0; k<ret->phases; k++) {
+      int peer = ret->newrank ^ (1<<k);
+      /* map the partner back to its team rank*/
+      ret->peers[ret->num_peers++] = (peer < ret->rem ? peer*2+1 : peer+ret->rem);
+    }
+  } else {
+    ret->partners = NULL;
+  }
+  
+  return ret;
+}
+
+gasnete_coll_butterfly_info_t *gasnete_coll_fetch_butterfly(gasnete_coll_team_t team) {
+  gasnete_coll_butterfly_info_t *ret;
+  
+  gasneti_mutex_lock(&team->dissem_cache_lock);
+  if(team->butterfly_info == NULL) {
+    team->butterfly_info = gasnete_coll_build_butterfly(team);
+  }
+  ret = team->butterfly_info;
+  gasneti_mutex_unlock(&team->dissem_cache_lock);
+  return ret;
+}
@@ -196,6 +196,34 @@ struct gasnete_coll_dissem_info_t_ {
 
 gasnete_coll_dissem_info_t *gasnete_coll_fetch_dissemination(int radix, gasnete_coll_team_t team);
 void gasnete_coll_release_dissemination(gasnete_coll_dissem_info_t* obj, gasnete_coll_team_t team);
+
+/******** Butterfly (Recursive Doubling/Halving) Pairing **********/
+/* Ranks are paired by XOR over the largest power of two (pof2) not exceeding the 
+   team size.  The first 2*rem ranks (rem = total_ranks - pof2) fold pairwise first: 
+   each even rank hands its contribution to the odd rank above it, sits out the 
+   exchange and receives the result back at the end.*/
+#define GASNETE_COLL_BUTTERFLY_FOLDED_OUT(BFLY) ((BFLY)->newrank < 0)
+#define GASNETE_COLL_BUTTERFLY_HAS_FOLD(BFLY) ((BFLY)->fold_peer >= 0)
+/* index of a peer in the scratch out_peers list (fold peer first)*/
+#define GASNETE_COLL_BUTTERFLY_FOLD_IDX(BFLY) 0
+#define GASNETE_COLL_BUTTERFLY_PARTNER_IDX(BFLY, PHASE) (GASNETE_COLL_BUTTERFLY_HAS_FOLD(BFLY) + (PHASE))
+
+struct gasnete_coll_butterfly_info_t_ {
+  int pof2;
+  int rem;
+  int phases;   /*log_2(pof2)*/
+  int newrank;  /*rank among the pof2 participants or -1 if folded out*/
+  int fold_peer; /*rank I fold with (or -1)*/
+  
+  /*partners[k] is the team rank of participant (newrank ^ (1<<k))*/
+  gasnet_node_t *partners;
+  /*fold peer (if any) followed by the partners; every pairing is symmetric 
+    so this serves as both the in and the out peer list of the scratch request*/
+  gasnet_node_t *peers;
+  int num_peers;
+};
+
+gasnete_coll_butterfly_info_t *gasnete_coll_fetch_butterfly(gasnete_coll_team_t team);
 /*****************************************/
 
 #endif
@@ -7,7 +7,7 @@
 #include <gasnet_internal.h>
 #include <gasnet_extended_internal.h>
 
-static const gasnete_eopaddr_t EOPADDR_NIL = { { 0xFF, 0xFF } };
+static const gasnete_eopaddr_t EOPADDR_NIL = { { 0xFFFF, 0xFF } };
 extern void _gasnete_iop_check(gasnete_iop_t *iop) { gasnete_iop_check(iop); }
 
 /* ------------------------------------------------------------------------------------ */
@@ -22,20 +22,26 @@ static void gasnete_eop_alloc(gasnete_threaddata_t * const thread)) {
     gasnete_eopaddr_t addr;
     int bufidx = thread->eop_num_bufs;
     gasnete_eop_t *buf;
-    int i;
+    int i, n;
     gasnete_threadidx_t threadidx = thread->threadidx;
-    if (bufidx == 256) gasneti_fatalerror("GASNet Extended API: Ran out of explicit handles (limit=65535)");
+    if (bufidx == GASNETE_EOP_MAXBUFS) {
+      unsigned long limit = 0;
+      for (i=0; i < GASNETE_EOP_MAXBUFS; i++) limit += GASNETE_EOP_BUFSZ(i);
+      gasneti_fatalerror("GASNet Extended API: Ran out of explicit handles (limit=%lu)", limit - 1);
+    }
+    n = GASNETE_EOP_BUFSZ(bufidx);
     thread->eop_num_bufs++;
-    buf = (gasnete_eop_t *)gasneti_calloc(256,sizeof(gasnete_eop_t));
+    buf = (gasnete_eop_t *)gasneti_calloc(n,sizeof(gasnete_eop_t));
     gasneti_leak(buf);
-    for (i=0; i < 256; i++) {
+    addr.fulladdr = 0; /* compaddr does not cover all the bits */
+    for (i=0; i < n; i++) {
       addr.bufferidx = bufidx;
       #if GASNETE_SCATTER_EOPS_ACROSS_CACHELINES
         #ifdef GASNETE_EOP_MOD
-          addr.eopidx = (i+32) % 255;
+          addr.eopidx = (i+32) % (n-1);
         #else
           { int k = i+32;
-            addr.eopidx = k > 255 ? k - 255 : k;
+            addr.eopidx = k > (n-1) ? k - (n-1) : k;
           }
         #endif
       #else
@@ -57,11 +63,11 @@ static void gasnete_eop_alloc(gasnete_threaddata_t * const thread)) {
      /*  add a list terminator */
     #if GASNETE_SCATTER_EOPS_ACROSS_CACHELINES
       #ifdef GASNETE_EOP_MOD
-        buf[223].addr.eopidx = 255; /* modular arithmetic messes up this one */
+        buf[n-33].addr.eopidx = n-1; /* modular arithmetic messes up this one */
       #endif
-      buf[255].addr = EOPADDR_NIL;
+      buf[n-1].addr = EOPADDR_NIL;
     #else
-      buf[255].addr = EOPADDR_NIL;
+      buf[n-1].addr = EOPADDR_NIL;
     #endif
     thread->eop_bufs[bufidx] = buf;
     addr.bufferidx = bufidx;
@@ -71,12 +77,12 @@ static void gasnete_eop_alloc(gasnete_threaddata_t * const thread)) {
     #if GASNET_DEBUG
     { /* verify new free list got built correctly */
       int i;
-      int seen[256];
+      char *seen = gasneti_calloc(n, 1);
       gasnete_eopaddr_t addr = thread->eop_free;
 
       #if 0
       if (gasneti_mynode == 0)
-        for (i=0;i<256;i++) {                                   
+        for (i=0;i<n;i++) {                                   
           fprintf(stderr,"%i:  %i: next=%i\n",gasneti_mynode,i,buf[i].addr.eopidx);
           fflush(stderr);
         }
@@ -84,8 +90,7 @@ static void gasnete_eop_alloc(gasnete_threaddata_t * const thread)) {
       #endif
 
       gasneti_memcheck(thread->eop_bufs[bufidx]);
-      memset(seen, 0, 256*sizeof(int));
-      for (i=0;i<(bufidx==255?255:256);i++) {                                   
+      for (i=0;i<(bufidx==GASNETE_EOP_MAXBUFS-1?n-1:n);i++) {                                   
         gasnete_eop_t *eop;                                   
         gasneti_assert(!gasnete_eopaddr_isnil(addr));                 
         eop = GASNETE_EOPADDR_TO_PTR(thread,addr);            
@@ -98,6 +103,7 @@ static void gasnete_eop_alloc(gasnete_threaddata_t * const thread)) {
         addr = eop->addr;                                     
       }                                                       
       gasneti_assert(gasnete_eopaddr_isnil(addr)); 
+      gasneti_free(seen);
     }
     #endif
 }
@@ -149,6 +155,7 @@ gasnete_eop_t *gasnete_eop_new(gasnete_threaddata_t * const thread) {
 #if GASNETE_EOP_COUNTED
   eop->initiated_cnt++;
 #endif
+  thread->op_live++;
   return eop;
 }
 
@@ -204,6 +211,7 @@ void gasnete_op_markdone(gasnete_op_t *op, int isget) {
     gasnete_iop_check(iop);
     if (isget) gasneti_weakatomic_increment(&(iop->completed_get_cnt), 0);
     else gasneti_weakatomic_increment(&(iop->completed_put_cnt), 0);
+    GASNETE_OP_DONE_NOTIFY(iop);
   }
 }
 
@@ -220,6 +228,7 @@ void gasnete_eop_free(gasnete_eop_t *eop) {
 #endif
   eop->addr = thread->eop_free;
   thread->eop_free = addr;
+  thread->op_live--;
 }
 
 /*  free an iop */
@@ -233,6 +242,7 @@ void gasnete_iop_free(gasnete_iop_t *iop) {
   gasneti_assert(iop->next == NULL);
   iop->next = thread->iop_free;
   thread->iop_free = iop;
+  thread->op_live--;
 }
 
 /* ------------------------------------------------------------------------------------ */
@@ -326,6 +336,7 @@ void gasneti_iop_markdone(gasneti_iop_t *iop, unsigned int noperations, int isge
       }
     #endif
   }
+  GASNETE_OP_DONE_NOTIFY(op);
   gasnete_iop_check(op);
 }
 
@@ -409,10 +420,50 @@ extern int  gasnete_try_syncnb(gasnet_handle_t handle) {
 }
 #endif
 
+/*  The sync_hint lets a repeated try_syncnb_{some,all}() which would again find
+ *  nothing newly complete return NOT_READY in O(1), instead of rescanning the
+ *  array.  Since every completion bumps op_done_cnt, an unchanged count means
+ *  that the witness handle (still at its index) remains incomplete, as does any
+ *  handle of ours when the previous scan found all op_live of them incomplete.
+ *  That holds even if the caller has since added or removed handles.
+ */
+#if GASNETE_EOP_COUNTED && !GASNETE_AMREF_USE_MARKDONE
+  /* amref completes counted eops without GASNETE_OP_DONE_NOTIFY() */
+  #define GASNETE_SYNC_HINT 0
+#else
+  #define GASNETE_SYNC_HINT 1
+#endif
+
+GASNETI_INLINE(gasnete_sync_hint_valid)
+int gasnete_sync_hint_valid(gasnete_threaddata_t * const mythread,
+                            gasnet_handle_t *phandle, size_t numhandles, int some) {
+#if GASNETE_SYNC_HINT
+  const size_t idx = mythread->sync_hint.idx;
+  return ((mythread->sync_hint.handle != GASNET_INVALID_HANDLE) &&
+          (idx < numhandles) && (phandle[idx] == mythread->sync_hint.handle) &&
+          (!some || mythread->sync_hint.some) &&
+          (gasneti_weakatomic_read(&mythread->op_done_cnt, 0) == mythread->sync_hint.done_cnt));
+#else
+  return 0;
+#endif
+}
+
+GASNETI_INLINE(gasnete_sync_hint_set)
+void gasnete_sync_hint_set(gasnete_threaddata_t * const mythread, gasneti_weakatomic_val_t done_cnt,
+                           gasnet_handle_t *phandle, size_t idx, size_t pending) {
+  mythread->sync_hint.done_cnt = done_cnt;
+  mythread->sync_hint.handle = phandle[idx];
+  mythread->sync_hint.idx = idx;
+  mythread->sync_hint.some = (pending == mythread->op_live);
+}
+
 #ifndef gasnete_try_syncnb_some
 extern int  gasnete_try_syncnb_some (gasnet_handle_t *phandle, size_t numhandles) {
+  gasnete_threaddata_t * const mythread = gasnete_mythread();
+  gasneti_weakatomic_val_t done_cnt;
+  size_t pending = 0;
+  size_t last = 0;
   int success = 0;
-  int empty = 1;
 #if 0
   /* polling for syncnb now happens in header file to avoid duplication */
   GASNETI_SAFE(gasneti_AMPoll());
@@ -420,22 +471,37 @@ extern int  gasnete_try_syncnb_some (gasnet_handle_t *phandle, size_t numhandles
 
   gasneti_assert(phandle);
 
-  { int i;
+  if (gasnete_sync_hint_valid(mythread, phandle, numhandles, 1)) return GASNET_ERR_NOT_READY;
+
+  /* sample before the scan, so a completion racing with it invalidates the hint */
+  done_cnt = gasneti_weakatomic_read(&mythread->op_done_cnt, GASNETI_ATOMIC_RMB_POST);
+
+  { size_t i;
     for (i = 0; i < numhandles; i++) {
       if (phandle[i] != GASNET_INVALID_HANDLE) {
-        empty = 0;
-        success |= gasnete_op_try_free_clear(&phandle[i]);
+        if (gasnete_op_try_free_clear(&phandle[i])) {
+          success = 1;
+        } else {
+          pending++;
+          last = i;
+        }
       }
     }
   }
 
-  return (success || empty) ? GASNET_OK : GASNET_ERR_NOT_READY;
+  if (success || !pending) return GASNET_OK;
+
+  gasnete_sync_hint_set(mythread, done_cnt, phandle, last, pending);
+  return GASNET_ERR_NOT_READY;
 }
 #endif
 
 #ifndef gasnete_try_syncnb_all
 extern int  gasnete_try_syncnb_all (gasnet_handle_t *phandle, size_t numhandles) {
-  int success = 1;
+  gasnete_threaddata_t * const mythread = gasnete_mythread();
+  gasneti_weakatomic_val_t done_cnt;
+  size_t pending = 0;
+  size_t last = 0;
 #if 0
   /* polling for syncnb now happens in header file to avoid duplication */
   GASNETI_SAFE(gasneti_AMPoll());
@@ -443,15 +509,64 @@ extern int  gasnete_try_syncnb_all (gasnet_handle_t *phandle, size_t numhandles)
 
   gasneti_assert(phandle);
 
-  { int i;
+  if (gasnete_sync_hint_valid(mythread, phandle, numhandles, 0)) return GASNET_ERR_NOT_READY;
+
+  /* sample before the scan, so a completion racing with it invalidates the hint */
+  done_cnt = gasneti_weakatomic_read(&mythread->op_done_cnt, GASNETI_ATOMIC_RMB_POST);
+
+  { size_t i;
     for (i = 0; i < numhandles; i++) {
-      if (phandle[i] != GASNET_INVALID_HANDLE) {
-        success &= gasnete_op_try_free_clear(&phandle[i]);
+      if ((phandle[i] != GASNET_INVALID_HANDLE) && !gasnete_op_try_free_clear(&phandle[i])) {
+        pending++;
+        last = i;
       }
     }
   }
 
-  return success ? GASNET_OK : GASNET_ERR_NOT_READY;
+  if (!pending) return GASNET_OK;
+
+  gasnete_sync_hint_set(mythread, done_cnt, phandle, last, pending);
+  return GASNET_ERR_NOT_READY;
+}
+#endif
+
+#if GASNETI_DIRECT_WAIT_SYNCNB_SOME
+/* Rescans the handles only after some op of this thread has completed,
+ * rather than on every poll as gasneti_pollwhile(gasnete_try_syncnb_some())
+ * would.  The snapshot of op_done_cnt must precede the scan, so that a
+ * completion racing with the scan forces another one. */
+extern void gasnete_wait_syncnb_some(gasnet_handle_t *phandle, size_t numhandles) {
+#if !GASNETE_SYNC_HINT
+  gasneti_AMPoll(); /* Ensure at least one poll */
+  gasneti_pollwhile(gasnete_try_syncnb_some(phandle, numhandles) == GASNET_ERR_NOT_READY);
+#else
+  gasneti_weakatomic_t * const pcnt = &gasnete_mythread()->op_done_cnt;
+
+  gasneti_AMPoll(); /* Ensure at least one poll */
+  for (;;) {
+    const gasneti_weakatomic_val_t cnt = gasneti_weakatomic_read(pcnt, GASNETI_ATOMIC_RMB_POST);
+    if (gasnete_try_syncnb_some(phandle, numhandles) == GASNET_OK) break;
+    gasneti_pollwhile(gasneti_weakatomic_read(pcnt, 0) == cnt);
+  }
+#endif
+}
+#endif
+
+#if GASNETI_DIRECT_WAIT_SYNCNB_ALL
+/* Waits on each handle in turn, so each poll examines only the first
+ * incomplete handle rather than rescanning the entire array. */
+extern void gasnete_wait_syncnb_all(gasnet_handle_t *phandle, size_t numhandles) {
+  size_t i;
+
+  gasneti_assert(phandle);
+
+  gasneti_AMPoll(); /* Ensure at least one poll */
+  for (i = 0; i < numhandles; i++) {
+    if (phandle[i] != GASNET_INVALID_HANDLE) {
+      gasneti_pollwhile(!gasnete_op_try_free(phandle[i]));
+      phandle[i] = GASNET_INVALID_HANDLE;
+    }
+  }
 }
 #endif
 
@@ -543,6 +658,7 @@ extern void            gasnete_begin_nbi_accessregion(int allowrecursion GASNETE
   #endif
   iop->next = mythread->current_iop;
   mythread->current_iop = iop;
+  mythread->op_live++;
 }
 #endif
 
@@ -557,6 +673,7 @@ extern gasnet_handle_t gasnete_end_nbi_accessregion(GASNETE_THREAD_FARG_ALONE) {
   #endif
   mythread->current_iop = iop->next;
   iop->next = NULL;
+  GASNETE_OP_DONE_NOTIFY(iop); /* may already be complete (e.g. if empty) */
   return (gasnet_handle_t)iop;
 }
 #endif
@@ -118,6 +118,10 @@ typedef struct _gasnete_op_t *gasnet_handle_t;
  *   set: conduit provides own gasnete_get_val() as an inline
  */
 
+/* Use the scalable gasnete_wait_syncnb_{some,all}() in gasnet_extended.c */
+#define GASNETI_DIRECT_WAIT_SYNCNB_SOME 1
+#define GASNETI_DIRECT_WAIT_SYNCNB_ALL  1
+
 /* Configure use of AM-based implementation of get/put/memset */
 /* NOTE: Barriers, Collectives, VIS may use GASNETE_USING_REF_* in algorithm selection */
 #define GASNETE_USING_REF_EXTENDED_GET_BULK 1
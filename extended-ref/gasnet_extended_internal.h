@@ -40,11 +40,17 @@ typedef struct _gasnete_op_t {
 /* for compactness, eops address each other in the free list using a gasnete_eopaddr_t */ 
 typedef union _gasnete_eopaddr_t {
   struct {
+    uint16_t _eopidx;
     uint8_t _bufferidx;
-    uint8_t _eopidx;
+    uint8_t _unused;
   } compaddr;
-  uint16_t fulladdr;
+  uint32_t fulladdr;
 } gasnete_eopaddr_t;
+
+/* eop buffers grow geometrically from 256 to 65536 eops, so the bufferidx/eopidx
+ * lookup stays a single index into a fixed table, while allowing over 16M handles */
+#define GASNETE_EOP_MAXBUFS       256
+#define GASNETE_EOP_BUFSZ(bufidx) (256 << MIN((bufidx), 8))
 #define bufferidx compaddr._bufferidx
 #define eopidx compaddr._eopidx
 
@@ -88,7 +94,7 @@ typedef struct _gasnete_iop_t {
 typedef struct _gasnete_threaddata_t {
   GASNETE_COMMON_THREADDATA_FIELDS /* MUST come first, for reserved ptrs */
 
-  gasnete_eop_t *eop_bufs[256]; /*  buffers of eops for memory management */
+  gasnete_eop_t *eop_bufs[GASNETE_EOP_MAXBUFS]; /*  buffers of eops for memory management */
   int eop_num_bufs;             /*  number of valid buffer entries */
   gasnete_eopaddr_t eop_free;   /*  free list of eops */
 
@@ -97,6 +103,16 @@ typedef struct _gasnete_threaddata_t {
 
   gasnete_iop_t *iop_free;      /*  free list of iops */
 
+  int op_live;                  /*  count of my eops and access-region iops not yet freed */
+  gasneti_weakatomic_t op_done_cnt; /*  bumped as each of my ops completes */
+
+  struct {                      /*  last try_syncnb_{some,all}() which returned NOT_READY */
+    gasneti_weakatomic_val_t done_cnt; /*  op_done_cnt sampled before its scan */
+    gasnet_handle_t handle;     /*  a handle it found incomplete... */
+    size_t idx;                 /*  ...and that handle's index */
+    int some;                   /*  non-zero if every op_live was found incomplete */
+  } sync_hint;
+
   #ifdef GASNETE_CONDUIT_THREADDATA_FIELDS
   GASNETE_CONDUIT_THREADDATA_FIELDS
   #endif
@@ -177,6 +193,13 @@ void SET_OPSTATE(gasnete_eop_t *op, uint8_t state) {
           == ((_iop)->initiated_##_putget##_cnt & GASNETI_ATOMIC_MAX))
 #endif
 
+/* Tell the thread owning an op that it has completed (after marking it so).
+ * This lets gasnete_{try,wait}_syncnb_{some,all}() rescan their handles only
+ * after some completion, rather than on every poll. */
+#define GASNETE_OP_DONE_NOTIFY(_op) \
+    gasneti_weakatomic_increment(&gasnete_threadtable[(_op)->threadidx]->op_done_cnt, \
+                                 GASNETI_ATOMIC_REL)
+
 #if GASNETE_EOP_COUNTED
   #define GASNETE_EOP_DONE(_eop) \
     (gasneti_weakatomic_read(&(_eop)->completed_cnt, 0) \
@@ -184,12 +207,14 @@ void SET_OPSTATE(gasnete_eop_t *op, uint8_t state) {
   #define GASNETE_EOP_MARKDONE(_eop) do {                        \
       gasneti_assert(!GASNETE_EOP_DONE(_eop));                   \
       gasneti_weakatomic_increment(&((_eop)->completed_cnt), 0); \
+      GASNETE_OP_DONE_NOTIFY(_eop);                              \
     } while (0)
 #else
   #define GASNETE_EOP_DONE(_eop) (OPSTATE(_eop) == OPSTATE_COMPLETE)
   #define GASNETE_EOP_MARKDONE(_eop) do {      \
       gasneti_assert(!GASNETE_EOP_DONE(_eop)); \
       SET_OPSTATE((_eop), OPSTATE_COMPLETE);   \
+      GASNETE_OP_DONE_NOTIFY(_eop);            \
     } while (0)
 #endif
 
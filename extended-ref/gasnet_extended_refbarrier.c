@@ -226,6 +226,9 @@ void gasnete_pshmbarrier_arrive(gasnete_pshmbarrier_data_t * const pshm_bdata, i
     result = (flags & GASNET_BARRIERFLAG_MISMATCH) ? GASNET_ERR_BARRIER_MISMATCH : GASNET_OK;
     PSHM_BSTATE_SIGNAL(pshm_bdata, result, two_to_phase);
   }
+
+  /* Our parent (or everyone, if we are the root) may be sleeping */
+  gasneti_pshm_wakeall();
 }
 
 /* TODO: to inline or not? */
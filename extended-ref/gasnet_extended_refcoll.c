@@ -33,6 +33,7 @@
 #include <gasnet_coll_scratch.c>
 #include <smp-collectives/smp_coll.c>
 #include <smp-collectives/smp_coll_barrier.c>
+#include <smp-collectives/smp_coll_bcast_scatter_gather.c>
 
 size_t gasnete_coll_p2p_eager_min = 0;
 size_t gasnete_coll_p2p_eager_scale = 0;
@@ -54,6 +55,77 @@ int gasnete_coll_opt_exchange_enabled;
 gasnet_coll_fn_entry_t *gasnete_coll_fn_tbl;
 size_t gasnete_coll_fn_count;
 
+/*---------------------------------------------------------------------------------*/
+/* Predefined reduction operators
+ * Each kernel is a plain element-wise loop over a known type, which the
+ * compiler can unroll and vectorize.  Every reduce algorithm calls them
+ * with results == left_operands, so that case gets its own loop in which
+ * the two distinct arrays are declared non-aliasing.
+ */
+#define GASNETE_COLL_BUILTIN_SUM(a,b)  ((a) + (b))
+#define GASNETE_COLL_BUILTIN_PROD(a,b) ((a) * (b))
+#define GASNETE_COLL_BUILTIN_MIN(a,b)  (((b) < (a)) ? (b) : (a))
+#define GASNETE_COLL_BUILTIN_MAX(a,b)  (((b) > (a)) ? (b) : (a))
+
+#define GASNETE_COLL_BUILTIN_KERNEL(_op, _tname, _type)                                 \
+static void gasnete_coll_builtin_##_op##_##_tname##_inplace(                            \
+                      _type * GASNETI_RESTRICT res,                                   \
+                      const _type * GASNETI_RESTRICT rhs, size_t count) {             \
+  size_t i;                                                                           \
+  for (i = 0; i < count; ++i) {                                                       \
+    res[i] = GASNETE_COLL_BUILTIN_##_op(res[i], rhs[i]);                              \
+  }                                                                                   \
+}                                                                                     \
+static void gasnete_coll_builtin_##_op##_##_tname(void *results, size_t result_count,  \
+                      const void *left_operands, size_t left_count,                   \
+                      const void *right_operands,                                     \
+                      size_t elem_size, int flags, int arg) {                         \
+  gasneti_assert(elem_size == sizeof(_type));                                         \
+  gasneti_assert(left_count == result_count);                                         \
+  if (results == left_operands) {                                                     \
+    gasnete_coll_builtin_##_op##_##_tname##_inplace((_type *)results,                 \
+                      (const _type *)right_operands, result_count);                   \
+  } else {                                                                            \
+    _type *res = (_type *)results;                                                    \
+    const _type *lhs = (const _type *)left_operands;                                  \
+    const _type *rhs = (const _type *)right_operands;                                 \
+    size_t i;                                                                         \
+    for (i = 0; i < result_count; ++i) {                                              \
+      res[i] = GASNETE_COLL_BUILTIN_##_op(lhs[i], rhs[i]);                            \
+    }                                                                                 \
+  }                                                                                   \
+}
+
+#define GASNETE_COLL_BUILTIN_KERNELS(_op)                \
+  GASNETE_COLL_BUILTIN_KERNEL(_op, INT32,  int32_t)      \
+  GASNETE_COLL_BUILTIN_KERNEL(_op, UINT32, uint32_t)     \
+  GASNETE_COLL_BUILTIN_KERNEL(_op, INT64,  int64_t)      \
+  GASNETE_COLL_BUILTIN_KERNEL(_op, UINT64, uint64_t)     \
+  GASNETE_COLL_BUILTIN_KERNEL(_op, FLOAT,  float)        \
+  GASNETE_COLL_BUILTIN_KERNEL(_op, DOUBLE, double)
+GASNETE_COLL_BUILTIN_KERNELS(SUM)
+GASNETE_COLL_BUILTIN_KERNELS(PROD)
+GASNETE_COLL_BUILTIN_KERNELS(MIN)
+GASNETE_COLL_BUILTIN_KERNELS(MAX)
+
+/* Table order must match GASNET_COLL_FN_BUILTIN(op,type) in gasnet_coll.h */
+#define GASNETE_COLL_BUILTIN_ENTRIES(_op)                              \
+  { &gasnete_coll_builtin_##_op##_INT32,  GASNET_COLL_AMSAFE },        \
+  { &gasnete_coll_builtin_##_op##_UINT32, GASNET_COLL_AMSAFE },        \
+  { &gasnete_coll_builtin_##_op##_INT64,  GASNET_COLL_AMSAFE },        \
+  { &gasnete_coll_builtin_##_op##_UINT64, GASNET_COLL_AMSAFE },        \
+  { &gasnete_coll_builtin_##_op##_FLOAT,  GASNET_COLL_AMSAFE },        \
+  { &gasnete_coll_builtin_##_op##_DOUBLE, GASNET_COLL_AMSAFE }
+const gasnet_coll_fn_entry_t gasnete_coll_builtin_fn_tbl[GASNET_COLL_FN_OP_COUNT*GASNET_COLL_FN_TYPE_COUNT] = {
+  GASNETE_COLL_BUILTIN_ENTRIES(SUM),
+  GASNETE_COLL_BUILTIN_ENTRIES(PROD),
+  GASNETE_COLL_BUILTIN_ENTRIES(MIN),
+  GASNETE_COLL_BUILTIN_ENTRIES(MAX)
+};
+const size_t gasnete_coll_builtin_elem_size[GASNET_COLL_FN_TYPE_COUNT] = {
+  sizeof(int32_t), sizeof(uint32_t), sizeof(int64_t), sizeof(uint64_t), sizeof(float), sizeof(double)
+};
+
 /*declarations for gasnet team all*/
 gasnet_team_handle_t gasnete_coll_team_all;
 gasnet_team_handle_t gasnete_coll_teamA;
@@ -958,62 +1030,78 @@ gasnete_coll_op_destroy(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
   td->op_freelist = op;
 }
 
-void gasnete_coll_poll(GASNETE_THREAD_FARG_ALONE) {
-#if ALL_THREADS_POLL
-  static gasneti_mutex_t poll_lock = GASNETI_MUTEX_INITIALIZER;
+/* Several threads may walk the active list at once (all threads of a process
+ * have my_local_image==0 when there is one image per node), so ops are owned
+ * by the walker which polls them.  Ownership is per-team rather than per-op,
+ * since the poll functions of a team's ops share its consensus barriers and
+ * scratch space, and must issue the latter's requests in sequence order.
+ * Each walk thus claims every unowned team it meets, polls that team's ops in
+ * list order, and skips the ops of teams owned by concurrent walkers.  The
+ * active lock is held only to step through the list and to retire ops, never
+ * across a poll function.
+ */
+#ifndef GASNETE_COLL_POLL_MAX_TEAMS
+#define GASNETE_COLL_POLL_MAX_TEAMS 8
 #endif
-  gasnete_coll_threaddata_t *td = GASNETE_COLL_MYTHREAD;
-  if(td->my_local_image==0 || ALL_THREADS_POLL) {
-    gasneti_AMPoll();
-  }
 
-  /* First try to make progress on any handles this thread has initiated */
-  if(td->my_local_image==0 || ALL_THREADS_POLL) {
-    gasnete_coll_sync_saved_handles(GASNETE_THREAD_PASS_ALONE);
-  }
-  /* XXX: We'd also like to have multiple pollers walk the list polling
-   * distinct entries.
-   */
-#if ALL_THREADS_POLL
-  if (gasneti_mutex_trylock(&poll_lock) == 0) {
-#else
-    if(td->my_local_image==0) {
-#endif
-    gasnete_coll_op_t *op;
+static void gasnete_coll_poll_active(GASNETE_THREAD_FARG_ALONE) {
+  const gasnete_coll_threaddata_t * const td = GASNETE_COLL_MYTHREAD_NOALLOC;
+  gasnete_coll_team_t claimed[GASNETE_COLL_POLL_MAX_TEAMS];
+  int num_claimed = 0;
+  gasnete_coll_op_t *op;
+  int i;
 
+  gasneti_mutex_lock(&gasnete_coll_active_lock);
+  op = gasnete_coll_active_first();
+  while (op != NULL) {
+    gasnete_coll_team_t team = op->team;
+    gasnete_coll_op_t *next;
+    int poll_result;
+
+    if (team->poller != td) {
+      if ((team->poller != NULL) || (num_claimed == GASNETE_COLL_POLL_MAX_TEAMS)) {
+        /* Owned by a concurrent walk, or we can't track another team */
+        op = gasnete_coll_active_next(op);
+        continue;
+      }
+      team->poller = td;
+      claimed[num_claimed++] = team;
+    }
+    gasneti_mutex_unlock(&gasnete_coll_active_lock);
 
-    op = gasnete_coll_active_first();
+    /* Poll/kick the op */
+    gasneti_assert(op->poll_fn != (gasnete_coll_poll_fn)NULL);
+    poll_result = (*op->poll_fn)(op GASNETE_THREAD_PASS);
 
+    gasneti_mutex_lock(&gasnete_coll_active_lock);
 
-    while (op != NULL) {
-      gasnete_coll_op_t *next;
-      int poll_result = 0;
+    /* Advance down the list, possibly deleting this current element.
+     * Only the owner of its team can remove op, so it is still linked. */
+    next = gasnete_coll_active_next(op);
+    if (poll_result != 0) {
+      gasnete_coll_op_complete(op, poll_result GASNETE_THREAD_PASS);
+    }
 
-      /* Poll/kick the op */
-      gasneti_assert(op->poll_fn != (gasnete_coll_poll_fn)NULL);
-      poll_result = (*op->poll_fn)(op GASNETE_THREAD_PASS);
+    /* Next... */
+    op = next;
+  }
 
-      next = gasnete_coll_active_next(op);
-      /* Advance down the list, possibly deleting this current element */
-      
-      
-      if (poll_result != 0) {
-        /*if the op was using any scratch space indicate that the scratch is free to overwrite*/
-        /*update my head and tail of the scratch space*/
-        gasneti_mutex_lock(&gasnete_coll_active_lock);
-        gasnete_coll_op_complete(op, poll_result GASNETE_THREAD_PASS);
-        gasneti_mutex_unlock(&gasnete_coll_active_lock);
-      }
+  for (i = 0; i < num_claimed; ++i) {
+    gasneti_assert(claimed[i]->poller == td);
+    claimed[i]->poller = NULL;
+  }
+  gasneti_mutex_unlock(&gasnete_coll_active_lock);
+}
 
-      
+void gasnete_coll_poll(GASNETE_THREAD_FARG_ALONE) {
+  gasnete_coll_threaddata_t *td = GASNETE_COLL_MYTHREAD;
+  if(td->my_local_image==0 || ALL_THREADS_POLL) {
+    gasneti_AMPoll();
 
-      /* Next... */
-      op = next;
-    }
-#if ALL_THREADS_POLL
-    gasneti_mutex_unlock(&poll_lock);
-#endif
-  
+    /* First try to make progress on any handles this thread has initiated */
+    gasnete_coll_sync_saved_handles(GASNETE_THREAD_PASS_ALONE);
+
+    gasnete_coll_poll_active(GASNETE_THREAD_PASS_ALONE);
   }
 }
   
@@ -1330,97 +1418,119 @@ extern int gasnete_coll_consensus_wait(gasnete_coll_team_t team GASNETE_THREAD_F
 	 (gasneti_assert(GASNETI_POWEROFTWO(GASNETE_COLL_P2P_TABLE_SIZE)), \
           ((uint32_t)(S) & (GASNETE_COLL_P2P_TABLE_SIZE-1)))
 
+/* Each slot of the table has its own lock, and since sequence numbers of
+ * concurrent ops are (nearly) consecutive, the common case is one entry per
+ * slot.  An existing entry is found without locking: entries are published
+ * only once initialized, and are never returned to the heap (a search which
+ * races with a removal may wander into the freelist, but will then miss and
+ * retry under the lock).
+ * Recycled entries are reset lazily, when reused, and only their state and
+ * counter arrays: algorithms always write eager data before raising the
+ * state or counter which permits it to be read.
+ */
+GASNETI_INLINE(gasnete_coll_p2p_find)
+gasnete_coll_p2p_t *gasnete_coll_p2p_find(gasnete_coll_p2p_t *p2p, uint32_t sequence) {
+  while (p2p && (p2p->sequence != sequence)) {
+    p2p = p2p->p2p_next;
+  }
+  return p2p;
+}
+
 gasnete_coll_p2p_t *gasnete_coll_p2p_get(uint32_t team_id, uint32_t sequence) {
   gasnete_coll_team_t team = gasnete_coll_team_lookup(team_id);
   unsigned int slot_nr = GASNETE_COLL_P2P_TABLE_SLOT(sequence);
-  gasnete_coll_p2p_t *p2p, **prev_p;
+  gasnete_coll_p2p_t *p2p;
   int i;
-  
-  gasnet_hsl_lock(&team->p2p_lock);
 
-  /* Search table, which is sorted by sequence */
-  prev_p = &(team->p2p_table[slot_nr]);
-  p2p = team->p2p_table[slot_nr];
-  while (p2p && (p2p->sequence < sequence)) {
-    prev_p = &p2p->p2p_next;
-    p2p = p2p->p2p_next;
+  /* Fast path: already present */
+  p2p = gasnete_coll_p2p_find(team->p2p_table[slot_nr].head, sequence);
+  if_pt (p2p != NULL) {
+    gasneti_sync_reads();
+    goto out;
   }
 
+  gasnet_hsl_lock(&team->p2p_table[slot_nr].lock);
+
+  /* Search again, since another thread may have created it */
+  p2p = gasnete_coll_p2p_find(team->p2p_table[slot_nr].head, sequence);
+
   /* If not found, create it with all zeros */
-  if_pf ((p2p == NULL) || (p2p->sequence != sequence)) {
+  if_pf (p2p == NULL) {
     size_t statesz = GASNETI_ALIGNUP(2*team->total_images * sizeof(uint32_t), 8);
     size_t countersz = GASNETI_ALIGNUP(2*team->total_images * sizeof(gasneti_weakatomic_t), 8);
-    gasnete_coll_p2p_t *next = p2p;
-        
-    p2p = team->p2p_freelist;
-        
+
+    p2p = team->p2p_table[slot_nr].freelist;
+
     if_pf (p2p == NULL) {
       /* Round to 8-byte alignment of entry array */
       size_t alloc_size = GASNETI_ALIGNUP(sizeof(gasnete_coll_p2p_t) + statesz + countersz,8)
         + gasnete_coll_p2p_eager_buffersz;
       uintptr_t p = (uintptr_t)gasneti_malloc(alloc_size);
-          
+
       p2p = (gasnete_coll_p2p_t *)p;
       p += sizeof(gasnete_coll_p2p_t);
-          
+
       p2p->state = (uint32_t *)p;
       p += statesz;
-          
+
       p2p->counter = (gasneti_weakatomic_t *)p;
       p += countersz;
-          
+
       p = GASNETI_ALIGNUP(p,8);
       p2p->data = (uint8_t *)p;
-          
+      memset(p2p->data, 0, gasnete_coll_p2p_eager_buffersz);
+
+      gasnet_hsl_init(&p2p->lock);
       p2p->p2p_next = NULL;
+    } else {
+      team->p2p_table[slot_nr].freelist = p2p->p2p_next;
     }
-        
+
     memset((void *)p2p->state, 0, statesz);
-    memset(p2p->data, 0, gasnete_coll_p2p_eager_buffersz);
     for(i=0; i<2*team->total_images; i++) {
       gasneti_weakatomic_set(&p2p->counter[i], 0, 0);
     }
-    gasneti_sync_writes();
     /*allocate an empty interval for the free list */
     p2p->seg_intervals = NULL;
-        
+    p2p->num_segs_processed = 0;
+
 #if GASNET_DEBUG
     p2p->team_id = team_id;
 #endif
     p2p->sequence = sequence;
-    gasnet_hsl_init(&p2p->lock);
-        
-    team->p2p_freelist = p2p->p2p_next;
-        
-    /* Insert in order before the last location searched */
-    gasneti_assert(prev_p != NULL);
-    gasneti_assert(!next || (next->p2p_prev_p == prev_p));
-    *prev_p = p2p;
-    p2p->p2p_prev_p = prev_p;
-    p2p->p2p_next = next;
-    if (next) {
-      next->p2p_prev_p = &p2p->p2p_next;
+
+    /* Insert at the head */
+    p2p->p2p_next = team->p2p_table[slot_nr].head;
+    p2p->p2p_prev_p = (gasnete_coll_p2p_t **)&team->p2p_table[slot_nr].head;
+    if (p2p->p2p_next) {
+      p2p->p2p_next->p2p_prev_p = &p2p->p2p_next;
     }
 #ifdef GASNETE_P2P_EXTRA_INIT
     GASNETE_P2P_EXTRA_INIT(p2p)
 #endif
+    gasneti_sync_writes(); /* publish only once initialized */
+    team->p2p_table[slot_nr].head = p2p;
   }
-      
-  gasnet_hsl_unlock(&team->p2p_lock);
-      
+
+  gasnet_hsl_unlock(&team->p2p_table[slot_nr].lock);
+
+out:
   gasneti_assert(p2p != NULL);
   gasneti_assert(p2p->state != NULL);
   gasneti_assert(p2p->data != NULL);
   gasneti_assert(p2p->team_id == team->team_id);
-      
+
   return p2p;
 }
 
 void gasnete_coll_p2p_free(gasnete_coll_team_t team, gasnete_coll_p2p_t *p2p) {
+  unsigned int slot_nr;
+
   gasneti_assert(p2p != NULL);
   gasneti_assert(p2p->team_id == team->team_id);
 
-  gasnet_hsl_lock(&team->p2p_lock);
+  slot_nr = GASNETE_COLL_P2P_TABLE_SLOT(p2p->sequence);
+  gasnet_hsl_lock(&team->p2p_table[slot_nr].lock);
 
   *(p2p->p2p_prev_p) = p2p->p2p_next;
   if (p2p->p2p_next) {
@@ -1430,8 +1540,8 @@ void gasnete_coll_p2p_free(gasnete_coll_team_t team, gasnete_coll_p2p_t *p2p) {
   GASNETE_P2P_EXTRA_FREE(p2p)
 #endif
 
-  p2p->p2p_next = team->p2p_freelist;
-  team->p2p_freelist = p2p;
+  p2p->p2p_next = team->p2p_table[slot_nr].freelist;
+  team->p2p_table[slot_nr].freelist = p2p;
 
 #if GASNET_DEBUG
   /* Detect double free using otherwise unused prev pointer */
@@ -1439,7 +1549,7 @@ void gasnete_coll_p2p_free(gasnete_coll_team_t team, gasnete_coll_p2p_t *p2p) {
   p2p->p2p_prev_p = &p2p->p2p_next;
 #endif
 
-  gasnet_hsl_unlock(&team->p2p_lock);
+  gasnet_hsl_unlock(&team->p2p_table[slot_nr].lock);
 }
 
 /*Management of the Intervals for Segments*/
@@ -2759,6 +2869,65 @@ GASNETI_COLL_FN_HEADER(_gasnet_coll_exchange)
   gasnete_coll_exchange(team,dst,src,nbytes,flags GASNETE_THREAD_PASS);
 }
 
+/****** Exchange Variable-size *********/
+
+#ifndef gasnete_coll_exchangev_nb
+#define gasnete_coll_exchangev_nb gasnete_coll_exchangev_nb_default
+#else
+extern gasnet_coll_handle_t
+gasnete_coll_exchangev_nb_default(gasnet_team_handle_t team,
+                                  void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                                  void *src, const size_t src_counts[], const size_t src_offsets[],
+                                  size_t max_nbytes, int flags, uint32_t sequence
+                                  GASNETE_THREAD_FARG);
+#endif
+extern gasnet_coll_handle_t
+gasnete_coll_exchangev_nb(gasnet_team_handle_t team,
+                          void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                          void *src, const size_t src_counts[], const size_t src_offsets[],
+                          size_t max_nbytes, int flags, uint32_t sequence
+                          GASNETE_THREAD_FARG);
+GASNETI_COLL_FN_HEADER(_gasnet_coll_exchangev_nb) GASNETI_WARN_UNUSED_RESULT
+gasnet_coll_handle_t
+_gasnet_coll_exchangev_nb(gasnet_team_handle_t team,
+                          void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                          void *src, const size_t src_counts[], const size_t src_offsets[],
+                          size_t max_nbytes, int flags GASNETE_THREAD_FARG) {
+  gasnet_coll_handle_t handle;
+  GASNETI_TRACE_COLL_EXCHANGEV(COLL_EXCHANGEV_NB,team,dst,dst_counts,dst_offsets,src,src_counts,src_offsets,max_nbytes,flags);
+  GASNETE_COLL_VALIDATE_EXCHANGEV(team,dst,dst_counts,dst_offsets,src,src_counts,src_offsets,max_nbytes,flags);
+  handle = gasnete_coll_exchangev_nb(team,dst,dst_counts,dst_offsets,src,src_counts,src_offsets,max_nbytes,flags,0 GASNETE_THREAD_PASS);
+  gasnete_coll_poll(GASNETE_THREAD_PASS_ALONE);
+  return handle;
+}
+
+#ifdef gasnete_coll_exchangev
+extern void
+gasnete_coll_exchangev(gasnet_team_handle_t team,
+                       void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                       void *src, const size_t src_counts[], const size_t src_offsets[],
+                       size_t max_nbytes, int flags GASNETE_THREAD_FARG);
+#else
+GASNETI_COLL_FN_HEADER(gasnete_coll_exchangev)
+     void gasnete_coll_exchangev(gasnet_team_handle_t team,
+                                 void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                                 void *src, const size_t src_counts[], const size_t src_offsets[],
+                                 size_t max_nbytes, int flags GASNETE_THREAD_FARG) {
+  gasnet_coll_handle_t handle;
+  handle = gasnete_coll_exchangev_nb(team,dst,dst_counts,dst_offsets,src,src_counts,src_offsets,max_nbytes,flags,0 GASNETE_THREAD_PASS);
+  gasnete_coll_wait_sync(handle GASNETE_THREAD_PASS);
+}
+#endif
+GASNETI_COLL_FN_HEADER(_gasnet_coll_exchangev)
+     void _gasnet_coll_exchangev(gasnet_team_handle_t team,
+                                 void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                                 void *src, const size_t src_counts[], const size_t src_offsets[],
+                                 size_t max_nbytes, int flags GASNETE_THREAD_FARG) {
+  GASNETI_TRACE_COLL_EXCHANGEV(COLL_EXCHANGEV,team,dst,dst_counts,dst_offsets,src,src_counts,src_offsets,max_nbytes,flags);
+  GASNETE_COLL_VALIDATE_EXCHANGEV(team,dst,dst_counts,dst_offsets,src,src_counts,src_offsets,max_nbytes,flags);
+  gasnete_coll_exchangev(team,dst,dst_counts,dst_offsets,src,src_counts,src_offsets,max_nbytes,flags GASNETE_THREAD_PASS);
+}
+
 /**** Exchange Multiaddr ****/
 #ifndef gasnete_coll_exchangeM_nb
 #define gasnete_coll_exchangeM_nb gasnete_coll_exchangeM_nb_default
@@ -2948,6 +3117,132 @@ GASNETI_COLL_FN_HEADER(_gasnet_coll_reduceM)
   gasnete_coll_reduceM(team,dstimage,dst,srclist,src_blksz,src_offset,elem_size,elem_count,func,func_arg,flags GASNETE_THREAD_PASS);
 }
 
+/**** Reduce All ***/
+#ifndef gasnete_coll_reduce_all_nb
+#define gasnete_coll_reduce_all_nb gasnete_coll_reduce_all_nb_default
+#else
+extern gasnet_coll_handle_t
+gasnete_coll_reduce_all_nb_default(gasnet_team_handle_t team,
+                                   void *dst, void *src,
+                                   size_t elem_size, size_t elem_count,
+                                   gasnet_coll_fn_handle_t func, int func_arg,
+                                   int flags, uint32_t sequence GASNETE_THREAD_FARG);
+#endif
+
+extern gasnet_coll_handle_t
+gasnete_coll_reduce_all_nb(gasnet_team_handle_t team,
+                           void *dst, void *src,
+                           size_t elem_size, size_t elem_count,
+                           gasnet_coll_fn_handle_t func, int func_arg,
+                           int flags, uint32_t sequence GASNETE_THREAD_FARG);
+GASNETI_COLL_FN_HEADER(_gasnet_coll_reduce_all_nb) GASNETI_WARN_UNUSED_RESULT
+gasnet_coll_handle_t
+_gasnet_coll_reduce_all_nb(gasnet_team_handle_t team,
+                           void *dst, void *src,
+                           size_t elem_size, size_t elem_count,
+                           gasnet_coll_fn_handle_t func, int func_arg,
+                           int flags GASNETE_THREAD_FARG) {
+  gasnet_coll_handle_t handle;
+  GASNETI_TRACE_COLL_REDUCE_ALL(COLL_REDUCE_ALL_NB,team,dst,src,elem_size,elem_count,func,func_arg,flags);
+  GASNETE_COLL_VALIDATE_REDUCE_ALL(team,dst,src,elem_size,elem_count,func,func_arg,flags);
+  handle = gasnete_coll_reduce_all_nb(team,dst,src,elem_size,elem_count,func,func_arg,flags, 0 GASNETE_THREAD_PASS);
+  gasnete_coll_poll(GASNETE_THREAD_PASS_ALONE);
+  return handle;
+}
+
+#ifdef gasnete_coll_reduce_all
+extern void
+gasnete_coll_reduce_all(gasnet_team_handle_t team,
+                        void *dst, void *src,
+                        size_t elem_size, size_t elem_count,
+                        gasnet_coll_fn_handle_t func, int func_arg,
+                        int flags GASNETE_THREAD_FARG);
+#else
+GASNETI_COLL_FN_HEADER(gasnete_coll_reduce_all)
+     void gasnete_coll_reduce_all(gasnet_team_handle_t team,
+                                  void *dst, void *src,
+                                  size_t elem_size, size_t elem_count,
+                                  gasnet_coll_fn_handle_t func, int func_arg,
+                                  int flags GASNETE_THREAD_FARG) {
+  gasnet_coll_handle_t handle;
+  handle = gasnete_coll_reduce_all_nb(team,dst,src,elem_size,elem_count,func,func_arg,flags, 0 GASNETE_THREAD_PASS);
+  gasnete_coll_wait_sync(handle GASNETE_THREAD_PASS);
+}
+#endif
+GASNETI_COLL_FN_HEADER(_gasnet_coll_reduce_all)
+     void _gasnet_coll_reduce_all(gasnet_team_handle_t team,
+                                  void *dst, void *src,
+                                  size_t elem_size, size_t elem_count,
+                                  gasnet_coll_fn_handle_t func, int func_arg,
+                                  int flags GASNETE_THREAD_FARG) {
+  GASNETI_TRACE_COLL_REDUCE_ALL(COLL_REDUCE_ALL,team,dst,src,elem_size,elem_count,func,func_arg,flags);
+  GASNETE_COLL_VALIDATE_REDUCE_ALL(team,dst,src,elem_size,elem_count,func,func_arg,flags);
+  gasnete_coll_reduce_all(team,dst,src,elem_size,elem_count,func,func_arg,flags GASNETE_THREAD_PASS);
+}
+
+/**** Reduce Scatter ***/
+#ifndef gasnete_coll_reduce_scatter_nb
+#define gasnete_coll_reduce_scatter_nb gasnete_coll_reduce_scatter_nb_default
+#else
+extern gasnet_coll_handle_t
+gasnete_coll_reduce_scatter_nb_default(gasnet_team_handle_t team,
+                                       void *dst, void *src,
+                                       size_t elem_size, size_t elem_count,
+                                       gasnet_coll_fn_handle_t func, int func_arg,
+                                       int flags, uint32_t sequence GASNETE_THREAD_FARG);
+#endif
+
+extern gasnet_coll_handle_t
+gasnete_coll_reduce_scatter_nb(gasnet_team_handle_t team,
+                               void *dst, void *src,
+                               size_t elem_size, size_t elem_count,
+                               gasnet_coll_fn_handle_t func, int func_arg,
+                               int flags, uint32_t sequence GASNETE_THREAD_FARG);
+GASNETI_COLL_FN_HEADER(_gasnet_coll_reduce_scatter_nb) GASNETI_WARN_UNUSED_RESULT
+gasnet_coll_handle_t
+_gasnet_coll_reduce_scatter_nb(gasnet_team_handle_t team,
+                               void *dst, void *src,
+                               size_t elem_size, size_t elem_count,
+                               gasnet_coll_fn_handle_t func, int func_arg,
+                               int flags GASNETE_THREAD_FARG) {
+  gasnet_coll_handle_t handle;
+  GASNETI_TRACE_COLL_REDUCE_ALL(COLL_REDUCE_SCATTER_NB,team,dst,src,elem_size,elem_count,func,func_arg,flags);
+  GASNETE_COLL_VALIDATE_REDUCE_SCATTER(team,dst,src,elem_size,elem_count,func,func_arg,flags);
+  handle = gasnete_coll_reduce_scatter_nb(team,dst,src,elem_size,elem_count,func,func_arg,flags, 0 GASNETE_THREAD_PASS);
+  gasnete_coll_poll(GASNETE_THREAD_PASS_ALONE);
+  return handle;
+}
+
+#ifdef gasnete_coll_reduce_scatter
+extern void
+gasnete_coll_reduce_scatter(gasnet_team_handle_t team,
+                            void *dst, void *src,
+                            size_t elem_size, size_t elem_count,
+                            gasnet_coll_fn_handle_t func, int func_arg,
+                            int flags GASNETE_THREAD_FARG);
+#else
+GASNETI_COLL_FN_HEADER(gasnete_coll_reduce_scatter)
+     void gasnete_coll_reduce_scatter(gasnet_team_handle_t team,
+                                      void *dst, void *src,
+                                      size_t elem_size, size_t elem_count,
+                                      gasnet_coll_fn_handle_t func, int func_arg,
+                                      int flags GASNETE_THREAD_FARG) {
+  gasnet_coll_handle_t handle;
+  handle = gasnete_coll_reduce_scatter_nb(team,dst,src,elem_size,elem_count,func,func_arg,flags, 0 GASNETE_THREAD_PASS);
+  gasnete_coll_wait_sync(handle GASNETE_THREAD_PASS);
+}
+#endif
+GASNETI_COLL_FN_HEADER(_gasnet_coll_reduce_scatter)
+     void _gasnet_coll_reduce_scatter(gasnet_team_handle_t team,
+                                      void *dst, void *src,
+                                      size_t elem_size, size_t elem_count,
+                                      gasnet_coll_fn_handle_t func, int func_arg,
+                                      int flags GASNETE_THREAD_FARG) {
+  GASNETI_TRACE_COLL_REDUCE_ALL(COLL_REDUCE_SCATTER,team,dst,src,elem_size,elem_count,func,func_arg,flags);
+  GASNETE_COLL_VALIDATE_REDUCE_SCATTER(team,dst,src,elem_size,elem_count,func,func_arg,flags);
+  gasnete_coll_reduce_scatter(team,dst,src,elem_size,elem_count,func,func_arg,flags GASNETE_THREAD_PASS);
+}
+
 /*** Scan **/
 
 #ifndef gasnete_coll_scan_nb
@@ -5366,6 +5661,167 @@ gasnete_coll_exchange_nb_default(gasnet_team_handle_t team,
   return ret;
 }
 #endif
+/*---------------------------------------------------------------------------------*/
+/* gasnete_coll_exchangev_nb() */
+
+/* exchgv Put: exchange the destination addresses and then put each block directly */
+/* Every image first learns where each peer wants its block to land through a
+   subordinate exchange of addresses and then issues one put per peer.
+   Requires GASNET_COLL_DST_IN_SEGMENT */
+static int gasnete_coll_pf_exchgv_Put(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  const gasnete_coll_exchangev_args_t *args = GASNETE_COLL_GENERIC_ARGS(data, exchangev);
+  /* the addresses live in private memory and differ from node to node*/
+  const int flags = ((GASNETE_COLL_FORWARD_FLAGS(op->flags)|GASNETE_COLL_NONROOT_SUBORDINATE|GASNET_COLL_DISABLE_AUTOTUNE) &
+                     ~(GASNET_COLL_SINGLE|GASNET_COLL_SRC_IN_SEGMENT|GASNET_COLL_DST_IN_SEGMENT)) | GASNET_COLL_LOCAL;
+  const int total_ranks = op->team->total_ranks;
+  const int myrank = op->team->myrank;
+  uintptr_t *addrs = (uintptr_t*) data->private_data;
+  int result = 0;
+  int i;
+  
+  switch (data->state) {
+  case 0:	/* Optional IN barrier */
+    if (!gasnete_coll_generic_all_threads(data) ||
+        !gasnete_coll_generic_insync(op->team, data)) {
+      break;
+    }
+    data->state = 1;
+    
+  case 1:	/* Exchange the destination address of every block */
+    if (!GASNETE_COLL_MAY_INIT_FOR(op)) break;
+    addrs = data->private_data = gasneti_malloc(2*sizeof(uintptr_t)*total_ranks);
+    for(i=0; i<total_ranks; i++) {
+      addrs[i] = (uintptr_t)((int8_t*)args->dst + args->dst_offsets[i]);
+    }
+    data->coll_handle = gasnete_coll_exchange_nb(op->team, addrs+total_ranks, addrs, sizeof(uintptr_t),
+                                                 flags, op->sequence+1 GASNETE_THREAD_PASS);
+    gasnete_coll_save_coll_handle(&data->coll_handle GASNETE_THREAD_PASS);
+    data->state = 2;
+    
+  case 2:	/* Fire off the puts, starting with the peer to the right of me */
+    if (!gasnete_coll_generic_coll_sync(&data->coll_handle, 1 GASNETE_THREAD_PASS)) {
+      break;
+    }
+    gasnete_begin_nbi_accessregion(1 GASNETE_THREAD_PASS);
+    for(i=1; i<total_ranks; i++) {
+      int peer = (myrank + i) % total_ranks;
+      if(args->src_counts[peer] == 0) continue;
+      gasnete_put_nbi_bulk(GASNETE_COLL_REL2ACT(op->team, peer), (void*)addrs[total_ranks+peer],
+                           (int8_t*)args->src + args->src_offsets[peer], args->src_counts[peer] GASNETE_THREAD_PASS);
+    }
+    data->handle = gasnete_end_nbi_accessregion(GASNETE_THREAD_PASS_ALONE);
+    gasnete_coll_save_handle(&data->handle GASNETE_THREAD_PASS);
+    gasneti_assert(args->src_counts[myrank] == args->dst_counts[myrank]);
+    GASNETE_FAST_UNALIGNED_MEMCPY_CHECK((int8_t*)args->dst + args->dst_offsets[myrank],
+                                        (int8_t*)args->src + args->src_offsets[myrank], args->src_counts[myrank]);
+    data->state = 3;
+    
+  case 3:	/* Sync all the handles for the puts */
+    if (data->handle != GASNET_INVALID_HANDLE) {
+      break;
+    }
+    data->state = 4;
+    
+  case 4:	/* Optional OUT barrier */
+    if (!gasnete_coll_generic_outsync(op->team, data)) {
+      break;
+    }
+    
+    gasneti_free(data->private_data);
+    gasnete_coll_generic_free(op->team, data GASNETE_THREAD_PASS);
+    result = (GASNETE_COLL_OP_COMPLETE | GASNETE_COLL_OP_INACTIVE);
+  }
+  
+  return result;
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_exchgv_Put(gasnet_team_handle_t team,
+                        void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                        void *src, const size_t src_counts[], const size_t src_offsets[],
+                        size_t max_nbytes, int flags, gasnete_coll_implementation_t coll_params, uint32_t sequence
+                        GASNETE_THREAD_FARG)
+{
+  int options = GASNETE_COLL_GENERIC_OPT_INSYNC_IF (!(flags & GASNET_COLL_IN_NOSYNC)) |
+		GASNETE_COLL_GENERIC_OPT_OUTSYNC_IF(!(flags & GASNET_COLL_OUT_NOSYNC));
+  
+  gasneti_assert(flags & GASNET_COLL_DST_IN_SEGMENT);
+  gasneti_assert(team->total_images == team->total_ranks);
+  /* one subordinate op follows this one*/
+  return gasnete_coll_generic_exchangev_nb(team, dst, dst_counts, dst_offsets, src, src_counts, src_offsets,
+                                           max_nbytes, flags, &gasnete_coll_pf_exchgv_Put, options,
+                                           NULL, NULL, (flags & GASNETE_COLL_SUBORDINATE ? sequence : 1),
+                                           coll_params->num_params, coll_params->param_list, NULL
+                                           GASNETE_THREAD_PASS);
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_generic_exchangev_nb(gasnet_team_handle_t team,
+                                  void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                                  void *src, const size_t src_counts[], const size_t src_offsets[],
+                                  size_t max_nbytes, int flags,
+                                  gasnete_coll_poll_fn poll_fn, int options,
+                                  void *private_data, gasnete_coll_dissem_info_t *dissem, uint32_t sequence,
+                                  int num_params, uint32_t *param_list, gasnete_coll_scratch_req_t *scratch_req
+                                  GASNETE_THREAD_FARG) {
+  gasnet_coll_handle_t result;
+  int first_thread;
+  
+  gasnete_coll_threads_lock(team, flags GASNETE_THREAD_PASS);
+  if(!(flags & GASNETE_COLL_SUBORDINATE) || ALL_THREADS_POLL) {
+    first_thread = gasnete_coll_threads_first(GASNETE_THREAD_PASS_ALONE);
+  } else {
+    first_thread = 1;
+  }
+  
+  if_pt (first_thread) {
+    gasnete_coll_generic_data_t *data = gasnete_coll_generic_alloc(GASNETE_THREAD_PASS_ALONE);
+    GASNETE_COLL_GENERIC_SET_TAG(data, exchangev);
+    data->args.exchangev.dst         = dst;
+    data->args.exchangev.dst_counts  = dst_counts;
+    data->args.exchangev.dst_offsets = dst_offsets;
+    data->args.exchangev.src         = src;
+    data->args.exchangev.src_counts  = src_counts;
+    data->args.exchangev.src_offsets = src_offsets;
+    data->args.exchangev.max_nbytes  = max_nbytes;
+    
+    data->options = options;
+    data->private_data = private_data; data->tree_info=NULL;
+    data->dissem_info = dissem;
+    result = gasnete_coll_op_generic_init_with_scratch(team, flags, data, poll_fn, sequence, scratch_req, num_params, param_list, NULL GASNETE_THREAD_PASS);
+  } else {
+    result = gasnete_coll_threads_get_handle(GASNETE_THREAD_PASS_ALONE);
+  }
+  gasnete_coll_threads_unlock(GASNETE_THREAD_PASS_ALONE);
+  return result;
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_exchangev_nb_default(gasnet_team_handle_t team,
+                                  void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                                  void *src, const size_t src_counts[], const size_t src_offsets[],
+                                  size_t max_nbytes, int flags, uint32_t sequence
+                                  GASNETE_THREAD_FARG)
+{
+  gasnete_coll_implementation_t impl;
+  gasnet_coll_handle_t ret;
+  
+  /* the count and offset arrays are indexed by image*/
+  if(team->total_images != team->total_ranks) {
+    gasneti_fatalerror("gasnet_coll_exchangev() requires one image per node");
+  }
+  /* the extents are not single-valued so there is no in-segment discovery:
+     the caller's segment flags are used as given*/
+  
+  impl = gasnete_coll_autotune_get_exchangev_algorithm(team, dst, src, max_nbytes, flags GASNETE_THREAD_PASS);
+  ret = (*((gasnete_coll_exchangev_fn_ptr_t) (impl->fn_ptr)))(team, dst, dst_counts, dst_offsets,
+                                                               src, src_counts, src_offsets,
+                                                               max_nbytes, flags, impl, sequence GASNETE_THREAD_PASS);
+  if(impl->need_to_free) gasnete_coll_free_implementation(impl);
+  return ret;
+}
+
 /*---------------------------------------------------------------------------------*/
 /* gasnete_coll_exchangeM_nb() */
 
@@ -5778,9 +6234,7 @@ gasnete_coll_reduce_nb_default(gasnet_team_handle_t team,
   gasneti_assert(src_offset == 0);
   
   /*error check to make sure the function table is properly configured*/
-  gasneti_assert(gasnete_coll_fn_tbl);
-  gasneti_assert(func < gasnete_coll_fn_count);
-  gasneti_assert(gasnete_coll_fn_tbl[func].fnptr);
+  gasnete_coll_fn_check(func, elem_size);
   
   
   impl = gasnete_coll_autotune_get_reduce_algorithm(team, dstimage, dst, src, src_blksz, 
@@ -5913,9 +6367,7 @@ gasnete_coll_reduceM_nb_default(gasnet_team_handle_t team,
   gasneti_assert(src_offset == 0);
   
   /*error check to make sure the function table is properly configured*/
-  gasneti_assert(gasnete_coll_fn_tbl);
-  gasneti_assert(func < gasnete_coll_fn_count);
-  gasneti_assert(gasnete_coll_fn_tbl[func].fnptr);
+  gasnete_coll_fn_check(func, elem_size);
   
   
   impl = gasnete_coll_autotune_get_reduceM_algorithm(team, dstimage, dst, srclist, src_blksz, 
@@ -5927,6 +6379,309 @@ gasnete_coll_reduceM_nb_default(gasnet_team_handle_t team,
 
 }
 
+/*---------------------------------------------------------------------------------*/
+/* gasnete_coll_reduce_all_nb() */
+
+/* RedBcast: Implement reduce_all as a reduce to image 0 followed by a broadcast */
+/* Valid wherever the underlying reduce and broadcast are valid */
+static int gasnete_coll_pf_reduce_all_RedBcast(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  const gasnete_coll_reduce_all_args_t *args = GASNETE_COLL_GENERIC_ARGS(data, reduce_all);
+  /* dst doubles as the broadcast source: let the subordinate ops rediscover the segment flags*/
+  const int flags = (GASNETE_COLL_FORWARD_FLAGS(op->flags)|GASNETE_COLL_NONROOT_SUBORDINATE|GASNET_COLL_DISABLE_AUTOTUNE) &
+    ~(GASNET_COLL_SRC_IN_SEGMENT|GASNET_COLL_DST_IN_SEGMENT);
+  int result = 0;
+  
+  switch (data->state) {
+  case 0:	/* Optional IN barrier */
+    if (!gasnete_coll_generic_all_threads(data) ||
+        !gasnete_coll_generic_insync(op->team, data)) {
+      break;
+    }
+    data->state = 1;
+    
+  case 1:	/* Reduce to image 0 */
+    if (!GASNETE_COLL_MAY_INIT_FOR(op)) break;
+    data->coll_handle = gasnete_coll_reduce_nb(op->team, 0, args->dst, args->src, 0, 0,
+                                               args->elem_size, args->elem_count, 
+                                               args->func, args->func_arg, flags, 
+                                               op->sequence+1 GASNETE_THREAD_PASS);
+    gasnete_coll_save_coll_handle(&data->coll_handle GASNETE_THREAD_PASS);
+    data->state = 2;
+    
+  case 2:	/* Broadcast the result from image 0 */
+    if (!gasnete_coll_generic_coll_sync(&data->coll_handle, 1 GASNETE_THREAD_PASS)) {
+      break;
+    }
+    data->coll_handle = gasnete_coll_broadcast_nb(op->team, args->dst, 0, args->dst, args->nbytes,
+                                                  flags, op->sequence+2 GASNETE_THREAD_PASS);
+    gasnete_coll_save_coll_handle(&data->coll_handle GASNETE_THREAD_PASS);
+    data->state = 3;
+    
+  case 3:	/* Sync data movement */
+    if (!gasnete_coll_generic_coll_sync(&data->coll_handle, 1 GASNETE_THREAD_PASS)) {
+      break;
+    }
+    data->state = 4;
+    
+  case 4:	/* Optional OUT barrier */
+    if (!gasnete_coll_generic_outsync(op->team, data)) {
+      break;
+    }
+    
+    gasnete_coll_generic_free(op->team, data GASNETE_THREAD_PASS);
+    result = (GASNETE_COLL_OP_COMPLETE | GASNETE_COLL_OP_INACTIVE);
+  }
+  
+  return result;
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_reduce_all_RedBcast(gasnet_team_handle_t team,
+                                 void *dst, void *src,
+                                 size_t elem_size, size_t elem_count,
+                                 gasnet_coll_fn_handle_t func, int func_arg,
+                                 int flags, 
+                                 gasnete_coll_implementation_t coll_params,
+                                 uint32_t sequence
+                                 GASNETE_THREAD_FARG)
+{
+  int options = GASNETE_COLL_GENERIC_OPT_INSYNC_IF (!(flags & GASNET_COLL_IN_NOSYNC)) |
+		GASNETE_COLL_GENERIC_OPT_OUTSYNC_IF(!(flags & GASNET_COLL_OUT_NOSYNC));
+  
+  /* two subordinate ops follow this one*/
+  return gasnete_coll_generic_reduce_all_nb(team, dst, src, elem_size, elem_count, func, func_arg, flags,
+                                            &gasnete_coll_pf_reduce_all_RedBcast, options,
+                                            NULL, (flags & GASNETE_COLL_SUBORDINATE ? sequence : 2),
+                                            coll_params->num_params, coll_params->param_list, NULL
+                                            GASNETE_THREAD_PASS);
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_generic_reduce_all_nb(gasnet_team_handle_t team,
+                                   void *dst, void *src,
+                                   size_t elem_size, size_t elem_count, 
+                                   gasnet_coll_fn_handle_t func, int func_arg, int flags,
+                                   gasnete_coll_poll_fn poll_fn, int options,
+                                   void *private_data, uint32_t sequence,
+                                   int num_params, uint32_t *param_list, gasnete_coll_scratch_req_t *scratch_req
+                                   GASNETE_THREAD_FARG) {
+  gasnet_coll_handle_t result;
+  int first_thread;
+  
+  gasnete_coll_threads_lock(team, flags GASNETE_THREAD_PASS);
+  if(!(flags & GASNETE_COLL_SUBORDINATE) || ALL_THREADS_POLL) {
+    first_thread = gasnete_coll_threads_first(GASNETE_THREAD_PASS_ALONE);
+  } else {
+    first_thread = 1;
+  }
+  
+  if_pt (first_thread) {
+    gasnete_coll_generic_data_t *data = gasnete_coll_generic_alloc(GASNETE_THREAD_PASS_ALONE);
+    GASNETE_COLL_GENERIC_SET_TAG(data, reduce_all);
+    data->args.reduce_all.dst        = dst;
+    data->args.reduce_all.src        = src;
+    data->args.reduce_all.elem_size  = elem_size;
+    data->args.reduce_all.elem_count = elem_count;
+    data->args.reduce_all.nbytes     = elem_size*elem_count;
+    data->args.reduce_all.func       = func;
+    data->args.reduce_all.func_arg   = func_arg;
+    
+    data->options = options;
+    data->private_data = private_data; data->tree_info=NULL;
+    result = gasnete_coll_op_generic_init_with_scratch(team, flags, data, poll_fn, sequence, scratch_req, num_params, param_list, NULL GASNETE_THREAD_PASS);
+  } else {
+    result = gasnete_coll_threads_get_handle(GASNETE_THREAD_PASS_ALONE);
+  }
+  gasnete_coll_threads_unlock(GASNETE_THREAD_PASS_ALONE);
+  return result;
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_reduce_all_nb_default(gasnet_team_handle_t team,
+                                   void *dst, void *src,
+                                   size_t elem_size, size_t elem_count,
+                                   gasnet_coll_fn_handle_t func, int func_arg,
+                                   int flags, uint32_t sequence GASNETE_THREAD_FARG)
+{
+  gasnete_coll_implementation_t impl;
+  size_t nbytes = elem_size*elem_count;
+  gasnet_coll_handle_t ret;
+  
+#if GASNET_PAR
+  /* there is no multi-address variant to forward thread-local addresses to*/
+  if((flags & GASNET_COLL_LOCAL) && team->my_images > 1) {
+    gasneti_fatalerror("gasnet_coll_reduce_all() with GASNET_COLL_LOCAL requires one image per node");
+  }
+#endif
+  flags = gasnete_coll_segment_check(team, flags, 0, 0, dst, nbytes,
+                                     0, 0, src, nbytes);
+  
+  /*error check to make sure the function table is properly configured*/
+  gasnete_coll_fn_check(func, elem_size);
+  
+  impl = gasnete_coll_autotune_get_reduce_all_algorithm(team, dst, src, elem_size, elem_count, 
+                                                        func, func_arg, flags GASNETE_THREAD_PASS);
+  ret = (*((gasnete_coll_reduce_all_fn_ptr_t) (impl->fn_ptr)))(team, dst, src, elem_size, elem_count, func, func_arg,
+                                                                flags, impl, sequence GASNETE_THREAD_PASS);
+  if(impl->need_to_free) gasnete_coll_free_implementation(impl);
+  return ret;
+}
+
+/*---------------------------------------------------------------------------------*/
+/* gasnete_coll_reduce_scatter_nb() */
+
+/* RedScat: Implement reduce_scatter as a reduce of the whole vector into a 
+   temporary buffer on image 0 followed by a scatter of that buffer */
+/* Valid wherever the underlying reduce and scatter are valid */
+static int gasnete_coll_pf_reduce_scatter_RedScat(gasnete_coll_op_t *op GASNETE_THREAD_FARG) {
+  gasnete_coll_generic_data_t *data = op->data;
+  const gasnete_coll_reduce_scatter_args_t *args = GASNETE_COLL_GENERIC_ARGS(data, reduce_scatter);
+  /* the temporary buffer is never in the segment*/
+  const int flags = (GASNETE_COLL_FORWARD_FLAGS(op->flags)|GASNETE_COLL_NONROOT_SUBORDINATE|GASNET_COLL_DISABLE_AUTOTUNE) &
+    ~(GASNET_COLL_SRC_IN_SEGMENT|GASNET_COLL_DST_IN_SEGMENT);
+  int result = 0;
+  
+  switch (data->state) {
+  case 0:	/* Optional IN barrier */
+    if (!gasnete_coll_generic_all_threads(data) ||
+        !gasnete_coll_generic_insync(op->team, data)) {
+      break;
+    }
+    data->state = 1;
+    
+  case 1:	/* Reduce the whole vector to image 0 */
+    if (!GASNETE_COLL_MAY_INIT_FOR(op)) break;
+    if (op->team->myrank == gasnete_coll_image_node(op->team, 0)) {
+      data->private_data = gasneti_malloc(args->nbytes*op->team->total_images);
+    }
+    data->coll_handle = gasnete_coll_reduce_nb(op->team, 0, data->private_data, args->src, 0, 0,
+                                               args->elem_size, args->elem_count*op->team->total_images, 
+                                               args->func, args->func_arg, flags, 
+                                               op->sequence+1 GASNETE_THREAD_PASS);
+    gasnete_coll_save_coll_handle(&data->coll_handle GASNETE_THREAD_PASS);
+    data->state = 2;
+    
+  case 2:	/* Scatter the blocks from image 0 */
+    if (!gasnete_coll_generic_coll_sync(&data->coll_handle, 1 GASNETE_THREAD_PASS)) {
+      break;
+    }
+    data->coll_handle = gasnete_coll_scatter_nb(op->team, args->dst, 0, data->private_data, args->nbytes,
+                                                flags, op->sequence+2 GASNETE_THREAD_PASS);
+    gasnete_coll_save_coll_handle(&data->coll_handle GASNETE_THREAD_PASS);
+    data->state = 3;
+    
+  case 3:	/* Sync data movement */
+    if (!gasnete_coll_generic_coll_sync(&data->coll_handle, 1 GASNETE_THREAD_PASS)) {
+      break;
+    }
+    data->state = 4;
+    
+  case 4:	/* Optional OUT barrier */
+    if (!gasnete_coll_generic_outsync(op->team, data)) {
+      break;
+    }
+    
+    if (data->private_data) gasneti_free(data->private_data);
+    gasnete_coll_generic_free(op->team, data GASNETE_THREAD_PASS);
+    result = (GASNETE_COLL_OP_COMPLETE | GASNETE_COLL_OP_INACTIVE);
+  }
+  
+  return result;
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_reduce_scatter_RedScat(gasnet_team_handle_t team,
+                                    void *dst, void *src,
+                                    size_t elem_size, size_t elem_count,
+                                    gasnet_coll_fn_handle_t func, int func_arg,
+                                    int flags, 
+                                    gasnete_coll_implementation_t coll_params,
+                                    uint32_t sequence
+                                    GASNETE_THREAD_FARG)
+{
+  int options = GASNETE_COLL_GENERIC_OPT_INSYNC_IF (!(flags & GASNET_COLL_IN_NOSYNC)) |
+		GASNETE_COLL_GENERIC_OPT_OUTSYNC_IF(!(flags & GASNET_COLL_OUT_NOSYNC));
+  
+  /* two subordinate ops follow this one*/
+  return gasnete_coll_generic_reduce_scatter_nb(team, dst, src, elem_size, elem_count, func, func_arg, flags,
+                                                &gasnete_coll_pf_reduce_scatter_RedScat, options,
+                                                NULL, (flags & GASNETE_COLL_SUBORDINATE ? sequence : 2),
+                                                coll_params->num_params, coll_params->param_list, NULL
+                                                GASNETE_THREAD_PASS);
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_generic_reduce_scatter_nb(gasnet_team_handle_t team,
+                                       void *dst, void *src,
+                                       size_t elem_size, size_t elem_count, 
+                                       gasnet_coll_fn_handle_t func, int func_arg, int flags,
+                                       gasnete_coll_poll_fn poll_fn, int options,
+                                       void *private_data, uint32_t sequence,
+                                       int num_params, uint32_t *param_list, gasnete_coll_scratch_req_t *scratch_req
+                                       GASNETE_THREAD_FARG) {
+  gasnet_coll_handle_t result;
+  int first_thread;
+  
+  gasnete_coll_threads_lock(team, flags GASNETE_THREAD_PASS);
+  if(!(flags & GASNETE_COLL_SUBORDINATE) || ALL_THREADS_POLL) {
+    first_thread = gasnete_coll_threads_first(GASNETE_THREAD_PASS_ALONE);
+  } else {
+    first_thread = 1;
+  }
+  
+  if_pt (first_thread) {
+    gasnete_coll_generic_data_t *data = gasnete_coll_generic_alloc(GASNETE_THREAD_PASS_ALONE);
+    GASNETE_COLL_GENERIC_SET_TAG(data, reduce_scatter);
+    data->args.reduce_scatter.dst        = dst;
+    data->args.reduce_scatter.src        = src;
+    data->args.reduce_scatter.elem_size  = elem_size;
+    data->args.reduce_scatter.elem_count = elem_count;
+    data->args.reduce_scatter.nbytes     = elem_size*elem_count;
+    data->args.reduce_scatter.func       = func;
+    data->args.reduce_scatter.func_arg   = func_arg;
+    
+    data->options = options;
+    data->private_data = private_data; data->tree_info=NULL;
+    result = gasnete_coll_op_generic_init_with_scratch(team, flags, data, poll_fn, sequence, scratch_req, num_params, param_list, NULL GASNETE_THREAD_PASS);
+  } else {
+    result = gasnete_coll_threads_get_handle(GASNETE_THREAD_PASS_ALONE);
+  }
+  gasnete_coll_threads_unlock(GASNETE_THREAD_PASS_ALONE);
+  return result;
+}
+
+extern gasnet_coll_handle_t
+gasnete_coll_reduce_scatter_nb_default(gasnet_team_handle_t team,
+                                       void *dst, void *src,
+                                       size_t elem_size, size_t elem_count,
+                                       gasnet_coll_fn_handle_t func, int func_arg,
+                                       int flags, uint32_t sequence GASNETE_THREAD_FARG)
+{
+  gasnete_coll_implementation_t impl;
+  size_t nbytes = elem_size*elem_count;
+  gasnet_coll_handle_t ret;
+  
+#if GASNET_PAR
+  /* there is no multi-address variant to forward thread-local addresses to*/
+  if((flags & GASNET_COLL_LOCAL) && team->my_images > 1) {
+    gasneti_fatalerror("gasnet_coll_reduce_scatter() with GASNET_COLL_LOCAL requires one image per node");
+  }
+#endif
+  flags = gasnete_coll_segment_check(team, flags, 0, 0, dst, nbytes,
+                                     0, 0, src, nbytes*team->total_images);
+  
+  /*error check to make sure the function table is properly configured*/
+  gasnete_coll_fn_check(func, elem_size);
+  
+  impl = gasnete_coll_autotune_get_reduce_scatter_algorithm(team, dst, src, elem_size, elem_count, 
+                                                            func, func_arg, flags GASNETE_THREAD_PASS);
+  ret = (*((gasnete_coll_reduce_scatter_fn_ptr_t) (impl->fn_ptr)))(team, dst, src, elem_size, elem_count, func, func_arg,
+                                                                    flags, impl, sequence GASNETE_THREAD_PASS);
+  if(impl->need_to_free) gasnete_coll_free_implementation(impl);
+  return ret;
+}
+
 /*---------------------------------------------------------------------------------*/
 
 extern gasnet_coll_handle_t
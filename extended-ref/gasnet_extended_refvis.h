@@ -97,6 +97,13 @@
 #define _hidx_gasnete_puts_AMPipeline_reqh    (GASNETE_VIS_HANDLER_BASE+7)
 #define _hidx_gasnete_gets_AMPipeline_reqh    (GASNETE_VIS_HANDLER_BASE+8)
 #define _hidx_gasnete_gets_AMPipeline_reph    (GASNETE_VIS_HANDLER_BASE+9)
+#define _hidx_gasnete_visplan_alloc_reqh      (GASNETE_VIS_HANDLER_BASE+10)
+#define _hidx_gasnete_visplan_ack_reph        (GASNETE_VIS_HANDLER_BASE+11)
+#define _hidx_gasnete_visplan_setup_reqh      (GASNETE_VIS_HANDLER_BASE+12)
+#define _hidx_gasnete_visplan_free_reqh       (GASNETE_VIS_HANDLER_BASE+13)
+#define _hidx_gasnete_visplan_put_reqh        (GASNETE_VIS_HANDLER_BASE+14)
+#define _hidx_gasnete_visplan_get_reqh        (GASNETE_VIS_HANDLER_BASE+15)
+#define _hidx_gasnete_visplan_get_reph        (GASNETE_VIS_HANDLER_BASE+16)
 
 /*---------------------------------------------------------------------------------*/
 
@@ -111,6 +118,13 @@
   MEDIUM_HANDLER_DECL(gasnete_puts_AMPipeline_reqh,5,7);
   MEDIUM_HANDLER_DECL(gasnete_gets_AMPipeline_reqh,6,8);
   MEDIUM_HANDLER_DECL(gasnete_gets_AMPipeline_reph,4,5);
+  SHORT_HANDLER_DECL(gasnete_visplan_alloc_reqh,2,3);
+  SHORT_HANDLER_DECL(gasnete_visplan_ack_reph,2,4);
+  MEDIUM_HANDLER_DECL(gasnete_visplan_setup_reqh,3,5);
+  SHORT_HANDLER_DECL(gasnete_visplan_free_reqh,1,2);
+  MEDIUM_HANDLER_DECL(gasnete_visplan_put_reqh,7,9);
+  SHORT_HANDLER_DECL(gasnete_visplan_get_reqh,9,12);
+  MEDIUM_HANDLER_DECL(gasnete_visplan_get_reph,3,5);
 
   #define GASNETE_VIS_AMPIPELINE_HANDLERS()                               \
     gasneti_handler_tableentry_with_bits(gasnete_putv_AMPipeline_reqh),   \
@@ -122,7 +136,14 @@
     gasneti_handler_tableentry_with_bits(gasnete_geti_AMPipeline_reph),   \
     gasneti_handler_tableentry_with_bits(gasnete_puts_AMPipeline_reqh),   \
     gasneti_handler_tableentry_with_bits(gasnete_gets_AMPipeline_reqh),   \
-    gasneti_handler_tableentry_with_bits(gasnete_gets_AMPipeline_reph),     
+    gasneti_handler_tableentry_with_bits(gasnete_gets_AMPipeline_reph),   \
+    gasneti_handler_tableentry_with_bits(gasnete_visplan_alloc_reqh),     \
+    gasneti_handler_tableentry_with_bits(gasnete_visplan_ack_reph),       \
+    gasneti_handler_tableentry_with_bits(gasnete_visplan_setup_reqh),     \
+    gasneti_handler_tableentry_with_bits(gasnete_visplan_free_reqh),      \
+    gasneti_handler_tableentry_with_bits(gasnete_visplan_put_reqh),       \
+    gasneti_handler_tableentry_with_bits(gasnete_visplan_get_reqh),       \
+    gasneti_handler_tableentry_with_bits(gasnete_visplan_get_reph),     
 #else
   #define GASNETE_VIS_AMPIPELINE_HANDLERS()
 #endif
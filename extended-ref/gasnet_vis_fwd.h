@@ -55,6 +55,8 @@ extern void gasneti_vis_progressfn(void);
         CNT(C, GETI_REF_INDIV, cnt)          \
         CNT(C, PUTI_REF_VECTOR, cnt)         \
         CNT(C, GETI_REF_VECTOR, cnt)         \
+        CNT(C, PUTI_PLAN_CREATE, cnt)        \
+        CNT(C, GETI_PLAN_CREATE, cnt)        \
                                              \
         CNT(C, PUTS_GATHER, cnt)             \
         CNT(C, GETS_SCATTER, cnt)            \
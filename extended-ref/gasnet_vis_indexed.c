@@ -725,3 +725,270 @@ extern gasnet_handle_t gasnete_geti(gasnete_synctype_t synctype,
   return GASNET_INVALID_HANDLE; /* avoid warning on MIPSPro */
 }
 #endif
+/*---------------------------------------------------------------------------------*/
+/* ***  Persistent Indexed plans *** */
+/*---------------------------------------------------------------------------------*/
+/* A plan packetizes the transfer once at creation and, when AM pipelining is 
+   available, leaves a copy of the remote addrlist at the peer. Each execution
+   then sends only data (or data requests), tagged with the remote packet boundaries,
+   and needs no allocation on the initiator.
+   Plans which cannot be pipelined fall back to gasnete_puti/geti on the saved lists.
+ */
+static gasnet_visplan_t gasnete_visplan_create(int isget, gasnet_node_t node,
+                                   size_t localcount, void * const locallist[], size_t locallen,
+                                   size_t remotecount, void * const remotelist[], size_t remotelen GASNETE_THREAD_FARG) {
+  gasnet_visplan_t const plan = gasneti_calloc(1, sizeof(*plan));
+  gasneti_assert(gasnete_vis_isinit);
+  if (isget) GASNETI_TRACE_EVENT(C, GETI_PLAN_CREATE);
+  else       GASNETI_TRACE_EVENT(C, PUTI_PLAN_CREATE);
+  plan->isget = isget;
+  plan->node = node;
+  plan->localcount = localcount;
+  plan->locallen = locallen;
+  plan->remotecount = remotecount;
+  plan->remotelen = remotelen;
+  plan->locallist = gasneti_malloc(localcount*sizeof(void *));
+  memcpy(plan->locallist, locallist, localcount*sizeof(void *));
+  plan->remotelist = gasneti_malloc(remotecount*sizeof(void *));
+  memcpy(plan->remotelist, remotelist, remotecount*sizeof(void *));
+  plan->rlist = NULL;
+
+#if GASNETE_USE_AMPIPELINE
+  if (gasnete_vis_use_ampipe &&
+      localcount + remotecount > 2 && /* not fully contiguous */
+      !GASNETI_SUPERNODE_LOCAL(node) &&
+      remotecount == (uint32_t)remotecount && remotelen == (uint32_t)remotelen &&
+      (locallen <= gasnete_vis_maxchunk || remotelen <= gasnete_vis_maxchunk)) {
+    size_t const maxpayload = gasnet_AMMaxMedium();
+    size_t packetidx;
+    /* metadata and data travel separately, so each packet bounds both independently */
+    plan->packetcnt = gasnete_packetize_addrlist(remotecount, remotelen, localcount, locallen,
+                                                 &plan->remotept, &plan->localpt, maxpayload, 0);
+    gasneti_assert(plan->packetcnt <= GASNETI_ATOMIC_MAX);
+    gasneti_assert(plan->packetcnt == (gasnet_handlerarg_t)plan->packetcnt);
+    if (!isget) plan->packedbuf = gasneti_malloc(maxpayload);
+
+    /* allocate the remote copy of the addrlist */
+    gasneti_weakatomic_set(&(plan->setupcnt), 1, GASNETI_ATOMIC_WMB_POST);
+    GASNETI_SAFE(
+      SHORT_REQ(2,3,(node, gasneti_handleridx(gasnete_visplan_alloc_reqh),
+                    PACK(plan), remotecount)));
+    GASNET_BLOCKUNTIL(gasneti_weakatomic_read(&(plan->setupcnt), 0) == 0);
+    gasneti_assert(plan->rlist);
+
+    /* populate it using the same packet boundaries later used for data */
+    gasneti_weakatomic_set(&(plan->setupcnt), plan->packetcnt, GASNETI_ATOMIC_WMB_POST);
+    for (packetidx = 0; packetidx < plan->packetcnt; packetidx++) {
+      gasnete_packetdesc_t * const rpacket = &(plan->remotept[packetidx]);
+      size_t const rnum = rpacket->lastidx - rpacket->firstidx + 1;
+      GASNETI_SAFE(
+        MEDIUM_REQ(3,5,(node, gasneti_handleridx(gasnete_visplan_setup_reqh),
+                      &(plan->remotelist[rpacket->firstidx]), rnum*sizeof(void *),
+                      PACK(plan->rlist), rpacket->firstidx, PACK(plan))));
+    }
+    GASNET_BLOCKUNTIL(gasneti_weakatomic_read(&(plan->setupcnt), 0) == 0);
+  }
+#endif
+
+  return plan;
+}
+
+extern gasnet_visplan_t gasnete_puti_plan(gasnet_node_t dstnode,
+                                   size_t dstcount, void * const dstlist[], size_t dstlen,
+                                   size_t srccount, void * const srclist[], size_t srclen GASNETE_THREAD_FARG) {
+  return gasnete_visplan_create(0, dstnode, srccount, srclist, srclen,
+                                dstcount, dstlist, dstlen GASNETE_THREAD_PASS);
+}
+
+extern gasnet_visplan_t gasnete_geti_plan(size_t dstcount, void * const dstlist[], size_t dstlen,
+                                   gasnet_node_t srcnode,
+                                   size_t srccount, void * const srclist[], size_t srclen GASNETE_THREAD_FARG) {
+  return gasnete_visplan_create(1, srcnode, dstcount, dstlist, dstlen,
+                                srccount, srclist, srclen GASNETE_THREAD_PASS);
+}
+
+extern gasnet_handle_t gasnete_visplan_exec(gasnete_synctype_t synctype, gasnet_visplan_t plan GASNETE_THREAD_FARG) {
+  gasneti_assert(plan);
+  /* each execution is a transfer, traced as such (creation is not) */
+  if (plan->isget)
+    GASNETI_TRACE_GETI(GETI_PLAN,plan->node,plan->localcount,plan->locallist,plan->locallen,
+                       plan->remotecount,plan->remotelist,plan->remotelen);
+  else
+    GASNETI_TRACE_PUTI(PUTI_PLAN,plan->node,plan->remotecount,plan->remotelist,plan->remotelen,
+                       plan->localcount,plan->locallist,plan->locallen);
+
+  if (!plan->rlist) { /* not pipelined */
+    if (plan->isget)
+      return gasnete_geti(synctype, plan->localcount, plan->locallist, plan->locallen,
+                          plan->node, plan->remotecount, plan->remotelist, plan->remotelen GASNETE_THREAD_PASS);
+    else
+      return gasnete_puti(synctype, plan->node, plan->remotecount, plan->remotelist, plan->remotelen,
+                          plan->localcount, plan->locallist, plan->locallen GASNETE_THREAD_PASS);
+  }
+
+#if GASNETE_USE_AMPIPELINE
+  GASNETE_START_NBIREGION(synctype, 0);
+
+  { gasnet_node_t const node = plan->node;
+    void * const rlist = plan->rlist;
+    size_t const packetcnt = plan->packetcnt;
+    gasneti_iop_t * const iop = gasneti_iop_register(packetcnt, plan->isget GASNETE_THREAD_PASS);
+    size_t packetidx;
+
+    if (plan->isget) {
+      for (packetidx = 0; packetidx < packetcnt; packetidx++) {
+        gasnete_packetdesc_t * const rpacket = &(plan->remotept[packetidx]);
+        size_t const rnum = rpacket->lastidx - rpacket->firstidx + 1;
+        GASNETI_SAFE(
+          SHORT_REQ(9,12,(node, gasneti_handleridx(gasnete_visplan_get_reqh),
+                        PACK(rlist), rpacket->firstidx, rnum, plan->remotelen,
+                        rpacket->firstoffset, rpacket->lastlen,
+                        PACK(plan), packetidx, PACK(iop))));
+      }
+    } else {
+      void * const packedbuf = plan->packedbuf;
+      for (packetidx = 0; packetidx < packetcnt; packetidx++) {
+        gasnete_packetdesc_t * const rpacket = &(plan->remotept[packetidx]);
+        gasnete_packetdesc_t * const lpacket = &(plan->localpt[packetidx]);
+        size_t const rnum = rpacket->lastidx - rpacket->firstidx + 1;
+        size_t const lnum = lpacket->lastidx - lpacket->firstidx + 1;
+        /* gather data payload from the local list - no metadata needed */
+        uint8_t * const end = gasnete_addrlist_pack(lnum, &(plan->locallist[lpacket->firstidx]), plan->locallen,
+                                                    packedbuf, lpacket->firstoffset, lpacket->lastlen);
+        GASNETI_SAFE(
+          MEDIUM_REQ(7,9,(node, gasneti_handleridx(gasnete_visplan_put_reqh),
+                        packedbuf, end - (uint8_t *)packedbuf,
+                        PACK(rlist), rpacket->firstidx, rnum, plan->remotelen,
+                        rpacket->firstoffset, rpacket->lastlen, PACK(iop))));
+      }
+    }
+  }
+
+  GASNETE_END_NBIREGION_AND_RETURN(synctype, 0);
+#else
+  gasneti_fatalerror("pipelined VIS plan without GASNETE_USE_AMPIPELINE - should never reach here");
+  return GASNET_INVALID_HANDLE; /* avoid warning on MIPSPro */
+#endif
+}
+
+extern void gasnete_visplan_destroy(gasnet_visplan_t plan GASNETE_THREAD_FARG) {
+  gasneti_assert(plan);
+#if GASNETE_USE_AMPIPELINE
+  if (plan->rlist) {
+    GASNETI_SAFE(
+      SHORT_REQ(1,2,(plan->node, gasneti_handleridx(gasnete_visplan_free_reqh),
+                    PACK(plan->rlist))));
+  }
+#endif
+  gasneti_free(plan->remotept);
+  gasneti_free(plan->localpt);
+  gasneti_free(plan->packedbuf);
+  gasneti_free(plan->remotelist);
+  gasneti_free(plan->locallist);
+  gasneti_free(plan);
+}
+/* ------------------------------------------------------------------------------------ */
+#if GASNETE_USE_AMPIPELINE
+GASNETI_INLINE(gasnete_visplan_alloc_reqh_inner)
+void gasnete_visplan_alloc_reqh_inner(gasnet_token_t token, 
+  void *plan, gasnet_handlerarg_t remotecount) {
+  void * const rlist = gasneti_malloc(((uint32_t)remotecount)*sizeof(void *));
+  GASNETI_SAFE(
+    SHORT_REP(2,4,(token, gasneti_handleridx(gasnete_visplan_ack_reph),
+                  PACK(plan), PACK(rlist))));
+}
+SHORT_HANDLER(gasnete_visplan_alloc_reqh,2,3, 
+              (token, UNPACK(a0),      a1),
+              (token, UNPACK2(a0, a1), a2));
+/* ------------------------------------------------------------------------------------ */
+GASNETI_INLINE(gasnete_visplan_ack_reph_inner)
+void gasnete_visplan_ack_reph_inner(gasnet_token_t token, 
+  void *_plan, void *rlist) {
+  gasnet_visplan_t const plan = _plan;
+  gasneti_assert(!plan->rlist || plan->rlist == rlist);
+  plan->rlist = rlist;
+  gasneti_weakatomic_decrement(&(plan->setupcnt), GASNETI_ATOMIC_WMB_PRE);
+}
+SHORT_HANDLER(gasnete_visplan_ack_reph,2,4, 
+              (token, UNPACK(a0),      UNPACK(a1)),
+              (token, UNPACK2(a0, a1), UNPACK2(a2, a3)));
+/* ------------------------------------------------------------------------------------ */
+GASNETI_INLINE(gasnete_visplan_setup_reqh_inner)
+void gasnete_visplan_setup_reqh_inner(gasnet_token_t token, 
+  void *addr, size_t nbytes,
+  void *rlist, gasnet_handlerarg_t firstidx, void *plan) {
+  memcpy(((void **)rlist) + (uint32_t)firstidx, addr, nbytes);
+  gasneti_sync_writes();
+  GASNETI_SAFE(
+    SHORT_REP(2,4,(token, gasneti_handleridx(gasnete_visplan_ack_reph),
+                  PACK(plan), PACK(rlist))));
+}
+MEDIUM_HANDLER(gasnete_visplan_setup_reqh,3,5, 
+              (token,addr,nbytes, UNPACK(a0),      a1, UNPACK(a2)),
+              (token,addr,nbytes, UNPACK2(a0, a1), a2, UNPACK2(a3, a4)));
+/* ------------------------------------------------------------------------------------ */
+GASNETI_INLINE(gasnete_visplan_free_reqh_inner)
+void gasnete_visplan_free_reqh_inner(gasnet_token_t token, void *rlist) {
+  gasneti_free(rlist);
+}
+SHORT_HANDLER(gasnete_visplan_free_reqh,1,2, 
+              (token, UNPACK(a0)),
+              (token, UNPACK2(a0, a1)));
+/* ------------------------------------------------------------------------------------ */
+GASNETI_INLINE(gasnete_visplan_put_reqh_inner)
+void gasnete_visplan_put_reqh_inner(gasnet_token_t token, 
+  void *addr, size_t nbytes,
+  void *rlist, gasnet_handlerarg_t firstidx, gasnet_handlerarg_t rnum, gasnet_handlerarg_t dstlen,
+  gasnet_handlerarg_t firstoffset, gasnet_handlerarg_t lastlen, void *iop) {
+  void * const * const plist = ((void * const *)rlist) + (uint32_t)firstidx;
+  uint8_t * const end = gasnete_addrlist_unpack(rnum, plist, (uint32_t)dstlen, addr, firstoffset, lastlen);
+  gasneti_assert(end - (uint8_t *)addr == nbytes);
+  gasneti_sync_writes();
+  GASNETI_SAFE(
+    SHORT_REP(1,2,(token, gasneti_handleridx(gasnete_putvis_AMPipeline_reph),
+                  PACK(iop))));
+}
+MEDIUM_HANDLER(gasnete_visplan_put_reqh,7,9, 
+              (token,addr,nbytes, UNPACK(a0),      a1,a2,a3,a4,a5, UNPACK(a6)),
+              (token,addr,nbytes, UNPACK2(a0, a1), a2,a3,a4,a5,a6, UNPACK2(a7, a8)));
+/* ------------------------------------------------------------------------------------ */
+GASNETI_INLINE(gasnete_visplan_get_reqh_inner)
+void gasnete_visplan_get_reqh_inner(gasnet_token_t token, 
+  void *rlist, gasnet_handlerarg_t firstidx, gasnet_handlerarg_t rnum, gasnet_handlerarg_t srclen,
+  gasnet_handlerarg_t firstoffset, gasnet_handlerarg_t lastlen,
+  void *plan, gasnet_handlerarg_t packetidx, void *iop) {
+  void * const * const plist = ((void * const *)rlist) + (uint32_t)firstidx;
+  uint8_t * const packedbuf = gasneti_malloc(gasnet_AMMaxMedium());
+  /* gather data payload from the saved sourcelist into packet */
+  uint8_t * const end = gasnete_addrlist_pack(rnum, plist, (uint32_t)srclen, packedbuf, firstoffset, lastlen);
+  size_t const repbytes = end - packedbuf;
+  gasneti_assert(repbytes <= gasnet_AMMaxMedium());
+  GASNETI_SAFE(
+    MEDIUM_REP(3,5,(token, gasneti_handleridx(gasnete_visplan_get_reph),
+                  packedbuf, repbytes,
+                  PACK(plan), packetidx, PACK(iop))));
+  gasneti_free(packedbuf);
+}
+SHORT_HANDLER(gasnete_visplan_get_reqh,9,12, 
+              (token, UNPACK(a0),      a1,a2,a3,a4,a5, UNPACK(a6),       a7, UNPACK(a8)),
+              (token, UNPACK2(a0, a1), a2,a3,a4,a5,a6, UNPACK2(a7, a8),  a9, UNPACK2(a10, a11)));
+/* ------------------------------------------------------------------------------------ */
+GASNETI_INLINE(gasnete_visplan_get_reph_inner)
+void gasnete_visplan_get_reph_inner(gasnet_token_t token, 
+  void *addr, size_t nbytes,
+  void *_plan, gasnet_handlerarg_t packetidx, void *iop) {
+  gasnet_visplan_t const plan = _plan;
+  gasnete_packetdesc_t * const lpacket = &(plan->localpt[packetidx]);
+  size_t const lnum = lpacket->lastidx - lpacket->firstidx + 1;
+  gasneti_assert(plan->isget && lpacket->lastidx < plan->localcount);
+  { uint8_t * const end = gasnete_addrlist_unpack(lnum, &(plan->locallist[lpacket->firstidx]), plan->locallen,
+                                                  addr, lpacket->firstoffset, lpacket->lastlen);
+    gasneti_assert(end - (uint8_t *)addr == nbytes);
+  }
+  gasneti_sync_writes();
+  gasneti_iop_markdone(iop, 1, 1);
+}
+MEDIUM_HANDLER(gasnete_visplan_get_reph,3,5, 
+              (token,addr,nbytes, UNPACK(a0),      a1, UNPACK(a2)),
+              (token,addr,nbytes, UNPACK2(a0, a1), a2, UNPACK2(a3, a4)));
+#endif
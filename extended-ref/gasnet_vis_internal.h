@@ -200,6 +200,23 @@ typedef struct {
 extern void gasnete_packetize_verify(gasnete_packetdesc_t *pt, size_t ptidx, int lastpacket,
                               size_t count, size_t len, gasnet_memvec_t const *list);
 
+/*---------------------------------------------------------------------------------*/
+/* persistent indexed plans */
+struct gasnete_visplan_S {
+  uint8_t isget;
+  gasnet_node_t node;
+  size_t localcount, locallen;
+  size_t remotecount, remotelen;
+  void **locallist;             /* private copy of the local addrlist */
+  void **remotelist;            /* private copy of the remote addrlist */
+  void * volatile rlist;        /* remote copy of remotelist, NULL if the plan is not pipelined */
+  size_t packetcnt;
+  gasnete_packetdesc_t *remotept;
+  gasnete_packetdesc_t *localpt;
+  void *packedbuf;              /* reusable put packing buffer */
+  gasneti_weakatomic_t setupcnt; /* outstanding setup acknowledgements */
+};
+
 /*---------------------------------------------------------------------------------*/
 /* GASNETE_METAMACRO_ASC/DESC##maxval(fn) is a meta-macro that iteratively expands the fn_INT(x,y) macro 
    with ascending or descending integer arguments. The base case (value zero) is expanded as fn_BASE().
@@ -170,6 +170,53 @@ typedef struct {
     unsigned int		flags;
 } gasnet_coll_fn_entry_t;
 
+/* Predefined reduction operators
+ * These handles may be passed as the 'func' argument of any of the
+ * reduce entry points without registering them in the function table
+ * given to gasnet_coll_init().  They are element-wise, commutative
+ * and AM-safe; 'elem_size' must match the type and 'func_arg' is ignored.
+ */
+#define GASNET_COLL_FN_BUILTIN_BIT	0x40000000
+#define GASNET_COLL_FN_TYPE_INT32	0
+#define GASNET_COLL_FN_TYPE_UINT32	1
+#define GASNET_COLL_FN_TYPE_INT64	2
+#define GASNET_COLL_FN_TYPE_UINT64	3
+#define GASNET_COLL_FN_TYPE_FLOAT	4
+#define GASNET_COLL_FN_TYPE_DOUBLE	5
+#define GASNET_COLL_FN_TYPE_COUNT	6
+#define GASNET_COLL_FN_OP_SUM		0
+#define GASNET_COLL_FN_OP_PROD		1
+#define GASNET_COLL_FN_OP_MIN		2
+#define GASNET_COLL_FN_OP_MAX		3
+#define GASNET_COLL_FN_OP_COUNT		4
+#define GASNET_COLL_FN_BUILTIN(op,type) \
+  ((gasnet_coll_fn_handle_t)(GASNET_COLL_FN_BUILTIN_BIT | ((op) * GASNET_COLL_FN_TYPE_COUNT + (type))))
+
+#define GASNET_COLL_FN_SUM_INT32	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_SUM, GASNET_COLL_FN_TYPE_INT32)
+#define GASNET_COLL_FN_SUM_UINT32	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_SUM, GASNET_COLL_FN_TYPE_UINT32)
+#define GASNET_COLL_FN_SUM_INT64	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_SUM, GASNET_COLL_FN_TYPE_INT64)
+#define GASNET_COLL_FN_SUM_UINT64	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_SUM, GASNET_COLL_FN_TYPE_UINT64)
+#define GASNET_COLL_FN_SUM_FLOAT	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_SUM, GASNET_COLL_FN_TYPE_FLOAT)
+#define GASNET_COLL_FN_SUM_DOUBLE	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_SUM, GASNET_COLL_FN_TYPE_DOUBLE)
+#define GASNET_COLL_FN_PROD_INT32	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_PROD, GASNET_COLL_FN_TYPE_INT32)
+#define GASNET_COLL_FN_PROD_UINT32	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_PROD, GASNET_COLL_FN_TYPE_UINT32)
+#define GASNET_COLL_FN_PROD_INT64	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_PROD, GASNET_COLL_FN_TYPE_INT64)
+#define GASNET_COLL_FN_PROD_UINT64	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_PROD, GASNET_COLL_FN_TYPE_UINT64)
+#define GASNET_COLL_FN_PROD_FLOAT	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_PROD, GASNET_COLL_FN_TYPE_FLOAT)
+#define GASNET_COLL_FN_PROD_DOUBLE	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_PROD, GASNET_COLL_FN_TYPE_DOUBLE)
+#define GASNET_COLL_FN_MIN_INT32	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_MIN, GASNET_COLL_FN_TYPE_INT32)
+#define GASNET_COLL_FN_MIN_UINT32	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_MIN, GASNET_COLL_FN_TYPE_UINT32)
+#define GASNET_COLL_FN_MIN_INT64	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_MIN, GASNET_COLL_FN_TYPE_INT64)
+#define GASNET_COLL_FN_MIN_UINT64	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_MIN, GASNET_COLL_FN_TYPE_UINT64)
+#define GASNET_COLL_FN_MIN_FLOAT	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_MIN, GASNET_COLL_FN_TYPE_FLOAT)
+#define GASNET_COLL_FN_MIN_DOUBLE	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_MIN, GASNET_COLL_FN_TYPE_DOUBLE)
+#define GASNET_COLL_FN_MAX_INT32	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_MAX, GASNET_COLL_FN_TYPE_INT32)
+#define GASNET_COLL_FN_MAX_UINT32	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_MAX, GASNET_COLL_FN_TYPE_UINT32)
+#define GASNET_COLL_FN_MAX_INT64	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_MAX, GASNET_COLL_FN_TYPE_INT64)
+#define GASNET_COLL_FN_MAX_UINT64	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_MAX, GASNET_COLL_FN_TYPE_UINT64)
+#define GASNET_COLL_FN_MAX_FLOAT	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_MAX, GASNET_COLL_FN_TYPE_FLOAT)
+#define GASNET_COLL_FN_MAX_DOUBLE	GASNET_COLL_FN_BUILTIN(GASNET_COLL_FN_OP_MAX, GASNET_COLL_FN_TYPE_DOUBLE)
+
 /* Handle type for collective teams: */
 #ifndef GASNETE_COLL_TEAMS_OVERRIDE
 struct gasnete_coll_team_t_;
@@ -261,6 +308,9 @@ typedef enum {GASNET_COLL_BROADCAST_OP=0,
   GASNET_COLL_EXCHANGEM_OP, 
   GASNET_COLL_REDUCE_OP,
   GASNET_COLL_REDUCEM_OP,
+  GASNET_COLL_REDUCE_ALL_OP,
+  GASNET_COLL_REDUCE_SCATTER_OP,
+  GASNET_COLL_EXCHANGEV_OP,
   GASNET_COLL_NUM_COLL_OPTYPES
 } gasnet_coll_optype_t;
 
@@ -603,6 +653,27 @@ void _gasnet_coll_exchangeM(gasnet_team_handle_t team,
 #define gasnet_coll_exchangeM(team,dstlist,srclist,nbytes,flags) \
        _gasnet_coll_exchangeM(team,dstlist,srclist,nbytes,flags GASNETE_THREAD_GET)
 
+/*---------------------------------------------------------------------------------*/
+/* exchangev: image i sends src_counts[j] bytes at src+src_offsets[j] to image j, which
+   receives them as dst_counts[i] bytes at dst+dst_offsets[i].  max_nbytes is an upper
+   bound on every count on every image and must be single-valued.  The count and offset
+   arrays must not be modified until the operation completes. */
+GASNETI_COLL_FN_HEADER(_gasnet_coll_exchangev_nb) 
+gasnet_coll_handle_t _gasnet_coll_exchangev_nb(gasnet_team_handle_t team,
+                          void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                          void *src, const size_t src_counts[], const size_t src_offsets[],
+                          size_t max_nbytes, int flags GASNETE_THREAD_FARG) ;
+#define gasnet_coll_exchangev_nb(team,dst,dst_counts,dst_offsets,src,src_counts,src_offsets,max_nbytes,flags) \
+       _gasnet_coll_exchangev_nb(team,dst,dst_counts,dst_offsets,src,src_counts,src_offsets,max_nbytes,flags GASNETE_THREAD_GET)
+
+GASNETI_COLL_FN_HEADER(_gasnet_coll_exchangev) 
+void _gasnet_coll_exchangev(gasnet_team_handle_t team,
+                                   void *dst, const size_t dst_counts[], const size_t dst_offsets[],
+                                   void *src, const size_t src_counts[], const size_t src_offsets[],
+                                   size_t max_nbytes, int flags GASNETE_THREAD_FARG);
+#define gasnet_coll_exchangev(team,dst,dst_counts,dst_offsets,src,src_counts,src_offsets,max_nbytes,flags) \
+       _gasnet_coll_exchangev(team,dst,dst_counts,dst_offsets,src,src_counts,src_offsets,max_nbytes,flags GASNETE_THREAD_GET)
+
 /*---------------------------------------------------------------------------------*/
 GASNETI_COLL_FN_HEADER(_gasnet_coll_reduce_nb) 
 gasnet_coll_handle_t _gasnet_coll_reduce_nb(gasnet_team_handle_t team,
@@ -646,6 +717,47 @@ void _gasnet_coll_reduceM(gasnet_team_handle_t team,
 #define gasnet_coll_reduceM(team,dstimage,dst,srclist,src_blksz,src_offset,elem_size,elem_count,func,func_arg,flags) \
        _gasnet_coll_reduceM(team,dstimage,dst,srclist,src_blksz,src_offset,elem_size,elem_count,func,func_arg,flags GASNETE_THREAD_GET);
 
+/*---------------------------------------------------------------------------------*/
+/* reduce_all: every image receives the elem_count-element reduction in dst */
+GASNETI_COLL_FN_HEADER(_gasnet_coll_reduce_all_nb) 
+gasnet_coll_handle_t _gasnet_coll_reduce_all_nb(gasnet_team_handle_t team,
+                        void *dst, void *src,
+                        size_t elem_size, size_t elem_count,
+                        gasnet_coll_fn_handle_t func, int func_arg,
+                        int flags GASNETE_THREAD_FARG) ;
+#define gasnet_coll_reduce_all_nb(team,dst,src,elem_size,elem_count,func,func_arg,flags) \
+       _gasnet_coll_reduce_all_nb(team,dst,src,elem_size,elem_count,func,func_arg,flags GASNETE_THREAD_GET)
+
+GASNETI_COLL_FN_HEADER(_gasnet_coll_reduce_all) 
+void _gasnet_coll_reduce_all(gasnet_team_handle_t team,
+                                    void *dst, void *src,
+                                    size_t elem_size, size_t elem_count,
+                                    gasnet_coll_fn_handle_t func, int func_arg,
+                                    int flags GASNETE_THREAD_FARG) ;
+#define gasnet_coll_reduce_all(team,dst,src,elem_size,elem_count,func,func_arg,flags) \
+       _gasnet_coll_reduce_all(team,dst,src,elem_size,elem_count,func,func_arg,flags GASNETE_THREAD_GET);
+
+/*---------------------------------------------------------------------------------*/
+/* reduce_scatter: src holds elem_count*total_images elements on every image and
+   image i receives the reduction of the i-th block of elem_count elements in dst */
+GASNETI_COLL_FN_HEADER(_gasnet_coll_reduce_scatter_nb) 
+gasnet_coll_handle_t _gasnet_coll_reduce_scatter_nb(gasnet_team_handle_t team,
+                        void *dst, void *src,
+                        size_t elem_size, size_t elem_count,
+                        gasnet_coll_fn_handle_t func, int func_arg,
+                        int flags GASNETE_THREAD_FARG) ;
+#define gasnet_coll_reduce_scatter_nb(team,dst,src,elem_size,elem_count,func,func_arg,flags) \
+       _gasnet_coll_reduce_scatter_nb(team,dst,src,elem_size,elem_count,func,func_arg,flags GASNETE_THREAD_GET)
+
+GASNETI_COLL_FN_HEADER(_gasnet_coll_reduce_scatter) 
+void _gasnet_coll_reduce_scatter(gasnet_team_handle_t team,
+                                        void *dst, void *src,
+                                        size_t elem_size, size_t elem_count,
+                                        gasnet_coll_fn_handle_t func, int func_arg,
+                                        int flags GASNETE_THREAD_FARG) ;
+#define gasnet_coll_reduce_scatter(team,dst,src,elem_size,elem_count,func,func_arg,flags) \
+       _gasnet_coll_reduce_scatter(team,dst,src,elem_size,elem_count,func,func_arg,flags GASNETE_THREAD_GET);
+
 /*---------------------------------------------------------------------------------*/
 GASNETI_COLL_FN_HEADER(_gasnet_coll_scan_nb) 
 gasnet_coll_handle_t _gasnet_coll_scan_nb(gasnet_team_handle_t team,
@@ -857,6 +857,11 @@ extern gasneti_pshm_rank_t gasneti_pshm_nodes;  /* # nodes in my supernode */
 extern gasneti_pshm_rank_t gasneti_pshm_mynode; /* my 0-based rank in supernode */
 extern gasnet_node_t gasneti_pshm_firstnode;    /* lowest node # in supernode */
 
+/* Sleep until a PSHM AM arrives or a short timeout (GASNET_PSHM_SLEEP_USECS)
+ * elapses, whichever is first.  For conduits which wait in GASNET_WAIT_BLOCK
+ * mode when all communication is intra-supernode (e.g. smp-conduit). */
+extern void gasneti_pshm_block(void);
+
 /* vector of first node within each supernode */
 extern gasnet_node_t *gasneti_pshm_firsts;
 
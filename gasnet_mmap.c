@@ -1587,6 +1587,9 @@ void gasneti_segmentAttach(uintptr_t segsize, uintptr_t minheapoffset,
         segbase =
 #endif
         gasneti_do_mmap_fixed(segbase, segsize);
+      #if GASNET_PSHM
+        gasneti_pshm_numa_bind(segbase, segsize);
+      #endif
       }
     }
     gasneti_free(gasneti_segexch);
@@ -6,13 +6,28 @@
 
 #include <gasnet_internal.h>
 
-#ifndef GASNET_PSHM /* Otherwise file is empty */
+#if GASNET_PSHM /* Otherwise file is empty */
 
 #include <gasnet_core_internal.h> /* for gasnetc_{Short,Medium,Long} and gasnetc_handler[] */
 
 #include <sys/types.h>
 #include <signal.h>
 
+#if PLATFORM_OS_LINUX
+  #include <sys/syscall.h>
+  #include <linux/futex.h>
+  #include <time.h>
+  #include <limits.h>
+  #ifdef SYS_futex
+    #define GASNETI_PSHM_FUTEX 1
+  #endif
+  #if defined(SYS_mbind) && defined(SYS_getcpu)
+    #include <linux/mempolicy.h>
+    #include <unistd.h>
+    #define GASNETI_PSHM_NUMA 1
+  #endif
+#endif
+
 #if defined(GASNETI_USE_GENERIC_ATOMICOPS) || defined(GASNETI_USE_OS_ATOMICOPS)
   #error "GASNet PSHM support requires Native atomics"
 #endif
@@ -29,11 +44,41 @@ gasneti_pshmnet_t *gasneti_reply_pshmnet = NULL;
 /* Structure for PSHM intra-supernode barrier */
 gasneti_pshm_barrier_t *gasneti_pshm_barrier = NULL; /* lives in shared space */
 
+/* optional per-peer "fast box" rings: slots per ring and max payload per slot */
+#define GASNETI_PSHM_FASTBOX_DEPTH_DEFAULT (0UL) /* Disabled */
+#define GASNETI_PSHM_FASTBOX_DEPTH_MAX     (1024UL)
+#define GASNETI_PSHM_FASTBOX_SIZE_DEFAULT  (192UL)
+
 static unsigned long gasneti_pshmnet_network_depth = GASNETI_PSHM_NETWORK_DEPTH_DEFAULT;
 static uintptr_t gasneti_pshmnet_queue_mem = 0;
 
+static int gasneti_pshmnet_fbox_inited = 0;
+static unsigned long gasneti_pshmnet_fbox_depth = 0;
+static size_t gasneti_pshmnet_fbox_slotsz = 0;
+static size_t gasneti_pshmnet_fbox_maxpayload = 0;
+
 static void *gasnetc_pshmnet_region = NULL;
 
+/* Doorbells, in shared space, for nodes blocked in gasneti_pshm_block().
+ * A sender rings the target's doorbell only if it has advertised sleepers.
+ * The first entry is not a doorbell, but counts sleepers supernode-wide.
+ */
+typedef struct {
+  gasneti_atomic32_t seq;      /* futex word: incremented by each ring */
+  gasneti_atomic32_t sleepers; /* count of threads (possibly) asleep */
+  char _pad[GASNETI_CACHE_PAD(2*sizeof(gasneti_atomic32_t))];
+} gasneti_pshm_doorbell_t;
+static gasneti_pshm_doorbell_t *gasneti_pshm_doorbells = NULL;
+#define GASNETI_PSHM_SLEEPERS (&gasneti_pshm_doorbells[-1].sleepers)
+
+#define GASNETI_PSHM_SLEEP_USECS_DEFAULT 1000
+static unsigned long gasneti_pshm_sleep_usecs;
+
+/* NUMA node of this process when PSHM placement is enabled, else -1 */
+static int gasneti_pshm_numa_node = -1;
+static void gasneti_pshm_numa_init(void);
+static void gasneti_pshm_numa_report(void);
+
 static struct gasneti_pshm_info {
     gasneti_atomic_t    bootstrap_barrier_cnt;
     char _pad1[GASNETI_CACHE_PAD(sizeof(gasneti_atomic_t))];
@@ -104,6 +149,8 @@ void *gasneti_pshm_init(gasneti_bootstrapBroadcastfn_t snodebcastfn, size_t aux_
     info_sz = GASNETI_ALIGNUP(info_sz, GASNETI_CACHE_LINE_BYTES);
     info_sz += sizeof(gasneti_pshm_barrier_t) +
 	       (gasneti_pshm_nodes - 1) * sizeof(gasneti_pshm_barrier->node);
+    /* space for the doorbells (plus one for supernode-wide count): */
+    info_sz += (gasneti_pshm_nodes + 1) * sizeof(gasneti_pshm_doorbell_t);
     /* space for early barrier, sharing space with the items above: */
     info_sz = MAX(info_sz, gasneti_pshm_nodes * sizeof(gasneti_pshm_info->early_barrier[0]));
     info_sz += offsetof(struct gasneti_pshm_info, early_barrier);
@@ -166,7 +213,17 @@ void *gasneti_pshm_init(gasneti_bootstrapBroadcastfn_t snodebcastfn, size_t aux_
     gasneti_pshm_barrier = (gasneti_pshm_barrier_t *)addr;
     addr += sizeof(gasneti_pshm_barrier_t) +
 	    (gasneti_pshm_nodes-1) * sizeof(gasneti_pshm_barrier->node);
+    /* doorbells, which are cache-line multiples like the barrier nodes: */
+    gasneti_pshm_doorbells = 1 + (gasneti_pshm_doorbell_t *)addr;
+    addr += (gasneti_pshm_nodes + 1) * sizeof(gasneti_pshm_doorbell_t);
   }
+  gasneti_atomic32_set(&gasneti_pshm_doorbells[gasneti_pshm_mynode].seq, 0, 0);
+  gasneti_atomic32_set(&gasneti_pshm_doorbells[gasneti_pshm_mynode].sleepers, 0, 0);
+  if (!gasneti_pshm_mynode) gasneti_atomic32_set(GASNETI_PSHM_SLEEPERS, 0, 0);
+  gasneti_pshm_sleep_usecs =
+          gasneti_getenv_int_withdefault("GASNET_PSHM_SLEEP_USECS",
+                                         GASNETI_PSHM_SLEEP_USECS_DEFAULT, 0);
+  if (!gasneti_pshm_sleep_usecs) gasneti_pshm_sleep_usecs = 1;
 
   /* Populate gasneti_pshm_firsts[] */
   if (!gasneti_pshm_mynode) gasneti_pshm_firsts[0] = 0;
@@ -200,6 +257,7 @@ void *gasneti_pshm_init(gasneti_bootstrapBroadcastfn_t snodebcastfn, size_t aux_
   }
 
   /* Collective call to initialize Shared AM "networks" */
+  gasneti_pshm_numa_init();
   gasneti_request_pshmnet = 
           gasneti_pshmnet_init(gasnetc_pshmnet_region,
                                vnetsz, gasneti_pshm_nodes);
@@ -210,6 +268,8 @@ void *gasneti_pshm_init(gasneti_bootstrapBroadcastfn_t snodebcastfn, size_t aux_
   /* Ensure all peers are initialized before return */
   gasneti_pshmnet_bootstrapBarrier();
 
+  gasneti_pshm_numa_report();
+
   /* Return the conduit's portion, if any */
   return aux_sz ? (void*)((uintptr_t)gasnetc_pshmnet_region +
                           mmapsz - round_up_to_pshmpage(aux_sz))
@@ -341,6 +401,10 @@ typedef union {
                   gasneti_atomic_compare_and_swap((_t),(_o),(_n),0)
   #define gasneti_pshmnet_tail_swap(_t,_v)\
                   gasneti_atomic_swap((_t),(_v),GASNETI_ATOMIC_REL)
+  #define gasneti_pshmnet_tail_read(_t)\
+                  gasneti_atomic_read((_t),0)
+  #define gasneti_pshmnet_tail_cas_rel(_t,_o,_n)\
+                  gasneti_atomic_compare_and_swap((_t),(_o),(_n),GASNETI_ATOMIC_REL)
 #elif defined(GASNETI_HAVE_ATOMIC_ADD_SUB)
   typedef struct {
     gasneti_atomic_t last_ticket;
@@ -382,6 +446,15 @@ typedef union {
     gasneti_pshmnet_tail_unlock(t, my_ticket);
     return result;
   }
+  GASNETI_INLINE(gasneti_pshmnet_tail_read)
+  gasneti_atomic_val_t gasneti_pshmnet_tail_read(gasneti_pshmnet_tail_t *t) {
+    gasneti_atomic_val_t my_ticket = gasneti_pshmnet_tail_lock(t);
+    gasneti_atomic_val_t result = t->value;
+    gasneti_pshmnet_tail_unlock(t, my_ticket);
+    return result;
+  }
+  /* unlock has REL semantics */
+  #define gasneti_pshmnet_tail_cas_rel gasneti_pshmnet_tail_cas
 #else
   #error "Platform is missing both atomic ADD and atomic CAS"
 #endif
@@ -397,24 +470,40 @@ typedef struct gasneti_pshmnet_queue {
   /* Producers' cache line: */
   gasneti_pshmnet_tail_t tail;
   volatile gasneti_atomic_val_t head;
+  volatile gasneti_atomic_val_t fbox_pending; /* set by fast box senders */
   char _pad0[GASNETI_CACHE_PAD(sizeof(gasneti_pshmnet_tail_t)
-                             + sizeof(gasneti_atomic_val_t))];
+                             + 2*sizeof(gasneti_atomic_val_t))];
   /* Consumers' cache line: */
   volatile gasneti_atomic_val_t shead; /* shadow head */
   char _pad1[GASNETI_CACHE_PAD(sizeof(gasneti_atomic_val_t))];
 } gasneti_pshmnet_queue_t;
 
-struct gasneti_pshmnet_allocator;  /* forward definition */
-
 /* message payload metadata */
 typedef struct gasneti_pshmnet_payload {
   volatile gasneti_atomic_val_t next;
-  struct gasneti_pshmnet_allocator *allocator;
   gasneti_pshm_rank_t from;
   size_t len;
   gasneti_AMPSHM_maxmsg_t data;
 } gasneti_pshmnet_payload_t;
 
+/* "Fast box" slot: one element of a single-producer single-consumer ring
+ * between a given (sender,receiver) pair, used for small messages to bypass
+ * the receiver's shared Nemesis queue.
+ * Only the first gasneti_pshmnet_fbox_maxpayload bytes of 'data' exist.
+ * The producer and consumer indices are private to the respective nodes and
+ * all synchronization is via the per-slot 'state' (FREE->BUSY->FULL->RECV).
+ */
+typedef struct {
+  gasneti_atomic_t state;
+  size_t len;
+  gasneti_AMPSHM_maxmsg_t data; /* truncated to the configured slot size */
+} gasneti_pshmnet_fbox_slot_t;
+
+#define GASNETI_PSHMNET_FBOX_FREE 0 /* owned by producer */
+#define GASNETI_PSHMNET_FBOX_BUSY 1 /* reserved, but not yet delivered */
+#define GASNETI_PSHMNET_FBOX_FULL 2 /* delivered, owned by consumer */
+#define GASNETI_PSHMNET_FBOX_RECV 3 /* received, but not yet released */
+
 /******************************************************************************
  * Payload memory allocator interface.
  *
@@ -425,48 +514,70 @@ typedef struct gasneti_pshmnet_payload {
  *
  * Logically, we have this layout:
  *  
- *    1) Atomic used by allocator as 'in use' bit
+ *    1) Offsets used by the allocator to link free blocks and find their owner
  *    2) A gasneti_pshmnet_payload_t, used by pshmnet
  *
  * Allocator returns #2 to the caller
- * NOTE: placement of #1 ensures no reference to offset==0 is ever used
+ * NOTE: the allocator's shared list heads precede all blocks in its region,
+ * which ensures no block is ever at offset==0 (used as the list terminator).
  */ 
 
 typedef struct {
-  gasneti_atomic_t in_use;
+  volatile gasneti_atomic_val_t next_free; /* link in a free or returned list */
+  gasneti_atomic_val_t home;               /* offset of owning class's returned list */
   gasneti_pshmnet_payload_t payload;
 } gasneti_pshmnet_allocator_block_t;
 
+/* Size classes, smallest first: a Short with max args, a Medium with up to
+ * GASNETI_PSHMNET_SMALL_MEDIUM bytes of payload, and the largest AM. */
+#define GASNETI_PSHMNET_NUM_CLASSES 3
+#define GASNETI_PSHMNET_SMALL_MEDIUM 512
+#define GASNETI_PSHMNET_CLASS_PAYLOAD(_c) \
+    ((_c) == 0 ? sizeof(gasneti_AMPSHM_shortmsg_t) : \
+     (_c) == 1 ? MIN(offsetof(gasneti_AMPSHM_medmsg_t, mediumdata) + 6 + GASNETI_PSHMNET_SMALL_MEDIUM, \
+                     sizeof(gasneti_AMPSHM_maxmsg_t)) : \
+                 sizeof(gasneti_AMPSHM_maxmsg_t))
+#define GASNETI_PSHMNET_CLASS_BLOCKSZ(_c) \
+    GASNETI_ALIGNUP(offsetof(gasneti_pshmnet_allocator_block_t, payload.data) + \
+                    GASNETI_PSHMNET_CLASS_PAYLOAD(_c), GASNETI_CACHE_LINE_BYTES)
+
 #define GASNETI_PSHMNET_ALLOC_MAXSZ \
-    round_up_to_pshmpage(sizeof(gasneti_pshmnet_allocator_block_t))
-#define GASNETI_PSHMNET_ALLOC_MAXPG (GASNETI_PSHMNET_ALLOC_MAXSZ >> GASNETI_PSHMNET_PAGESHIFT)
+    GASNETI_PSHMNET_CLASS_BLOCKSZ(GASNETI_PSHMNET_NUM_CLASSES - 1)
 
 #define GASNETI_PSHMNET_MAX_PAYLOAD \
-    (GASNETI_PSHMNET_ALLOC_MAXSZ - offsetof(gasneti_pshmnet_allocator_block_t, payload.data))
+    GASNETI_PSHMNET_CLASS_PAYLOAD(GASNETI_PSHMNET_NUM_CLASSES - 1)
 
 size_t gasneti_pshmnet_max_payload(void) {
   return GASNETI_PSHMNET_MAX_PAYLOAD;
 }
 
-/* This implementation uses a circular queue of variable-sized payloads.
- * This data structure lives entirely in private memory.
+/* This implementation uses one pool of fixed-size blocks per size class, each
+ * holding 'network depth' blocks.  The metadata lives in private memory,
+ * except for one cache line per class at the start of the region.
  *
- * The allocator's per-block metadata is external to the blocks, and is
- * stored in the "length" array.  There is a length entry for each "page",
- * but only the entries corresponding to the first page of each block have
- * defined values.  The "length[]", "next" and "count" are all in units
- * of GASNETI_PSHMNET_PAGESIZE (which must be a power-of-2).
+ * Only the owner allocates, popping from its private 'free' list.  Receivers
+ * release blocks by pushing them (CAS) onto the shared 'returned' list of the
+ * owning class.  The owner adopts the entire returned list (swap) when its
+ * private list is empty.  Since there is only one popper, there is no ABA.
+ * All lists are linked by offsets (see gasneti_pshm_offset()), 0-terminated.
  */
+typedef struct {
+  gasneti_atomic_val_t free;           /* private free list */
+  gasneti_pshmnet_tail_t *returned;    /* shared list of released blocks */
+  size_t max_payload;
+  unsigned int count;                  /* total blocks */
+  unsigned int in_use;                 /* blocks not on the private free list */
+} gasneti_pshmnet_sizeclass_t;
+
 typedef struct gasneti_pshmnet_allocator {
-  void *region;
-  unsigned int next;
-  unsigned int count;
-  unsigned int length[1]; /* Variable length */
+  gasneti_pshmnet_sizeclass_t cls[GASNETI_PSHMNET_NUM_CLASSES];
 } gasneti_pshmnet_allocator_t;
 
+/* Shared-memory needed by an allocator of the given depth */
+static size_t gasneti_pshmnet_allocator_memory_needed(unsigned long depth);
+
 /* WARNING: the amount requested from this allocator must be less than 
- * or equal to GASNETI_PSHMNET_MAX_PAYLOAD (which is at least as large
- * as sizeof(gasneti_pshmnet_payload_t)).
+ * or equal to GASNETI_PSHMNET_MAX_PAYLOAD.
  * - returns NULL if no memory available
  */
 static gasneti_pshmnet_allocator_t *gasneti_pshmnet_init_allocator(void *region, size_t len);
@@ -483,16 +594,43 @@ static void gasneti_pshmnet_free(gasneti_pshmnet_payload_t *p);
  */
 struct gasneti_pshmnet {
   gasneti_pshm_rank_t nodecount;    /* nodes in supernode */
-  gasneti_pshmnet_queue_t *queues;  /* array of queue heads */
+  uintptr_t region;                 /* start of per-node blocks */
+  size_t pernode;                   /* stride between per-node blocks */
   gasneti_pshmnet_queue_t *my_queue;
   /* only need to see one's own allocator */
   gasneti_pshmnet_allocator_t *my_allocator;
 #if GASNET_PAR || GASNETI_CONDUIT_THREADS
   /* serializes dequeue operations */
   gasneti_mutex_t lock;
+#endif
+  /* optional fast box rings, for all (sender,receiver) pairs */
+  size_t fbox_len;                  /* per-receiver length, zero if disabled */
+  unsigned int *fbox_tail;          /* per-target producer index */
+  unsigned int *fbox_head;          /* per-source consumer index */
+  gasneti_pshm_rank_t fbox_next;    /* round-robin starting source */
+  unsigned int fbox_streak;         /* consecutive fast box receives */
+#if GASNET_PAR || GASNETI_CONDUIT_THREADS
+  gasneti_mutex_t *fbox_lock;       /* per-source, serializes dequeue */
 #endif
 };
 
+/* Each node's block holds, in order, its payload allocator region, its
+ * receive queue header and the fast box rings for which it is the receiver.
+ * Keeping these together lets the owner place the block on its NUMA node.
+ */
+#define gasneti_pshmnet_queue(vnet, node)                                    \
+        ((gasneti_pshmnet_queue_t *)((vnet)->region + (node) * (vnet)->pernode \
+                                     + gasneti_pshmnet_queue_mem))
+#define gasneti_pshmnet_fbox_base(vnet, to) \
+        ((uintptr_t)(gasneti_pshmnet_queue(vnet, to) + 1))
+
+/* Slot 'idx' of the ring from node 'from' to node 'to' */
+#define gasneti_pshmnet_fbox_slot(vnet, to, from, idx)                       \
+        ((gasneti_pshmnet_fbox_slot_t *)(gasneti_pshmnet_fbox_base(vnet, to) + \
+          ((from) * gasneti_pshmnet_fbox_depth + (idx)) * gasneti_pshmnet_fbox_slotsz))
+#define gasneti_pshmnet_in_fbox(vnet, to, addr) \
+        (((uintptr_t)(addr) - gasneti_pshmnet_fbox_base(vnet, to)) < (vnet)->fbox_len)
+
 #define gasneti_assert_align(p, align) \
         gasneti_assert((((uintptr_t)p) % align) == 0)
 
@@ -534,33 +672,66 @@ static uintptr_t get_queue_mem(int nodes)
     gasneti_pshmnet_network_depth = GASNETI_PSHM_NETWORK_DEPTH_MAX;
   }
 
-  pernode = GASNETI_PSHMNET_ALLOC_MAXSZ * gasneti_pshmnet_network_depth;
+  pernode = gasneti_pshmnet_allocator_memory_needed(gasneti_pshmnet_network_depth);
   gasneti_assert(pernode > 0);
 
   /* round up to multiple of allocator page size */
   return round_up_to_pshmpage(pernode);
 }
 
+static size_t gasneti_pshmnet_fbox_memory_needed(gasneti_pshm_rank_t nodes);
+
 static size_t gasneti_pshmnet_memory_needed_pernode(gasneti_pshm_rank_t nodes)
 {
   /* Space for the message payloads */
   if_pf (!gasneti_pshmnet_queue_mem) {
     gasneti_pshmnet_queue_mem = get_queue_mem(nodes);
   }
-  return round_up_to_pshmpage(gasneti_pshmnet_queue_mem);
+  /* ... followed by the queue header and the (optional) incoming fast boxes */
+  return round_up_to_pshmpage(gasneti_pshmnet_queue_mem
+                              + sizeof(gasneti_pshmnet_queue_t)
+                              + gasneti_pshmnet_fbox_memory_needed(nodes));
 }
 
-static size_t gasneti_pshmnet_memory_needed_once(gasneti_pshm_rank_t nodes)
+static void get_fbox_params(void)
 {
-  /* Space for the queue headers */
-  return round_up_to_pshmpage(nodes * sizeof(gasneti_pshmnet_queue_t));
+  size_t maxpayload;
+
+  gasneti_pshmnet_fbox_depth =
+          gasneti_getenv_int_withdefault("GASNET_PSHM_FASTBOX_DEPTH",
+                                         GASNETI_PSHM_FASTBOX_DEPTH_DEFAULT, 0);
+  if (gasneti_pshmnet_fbox_depth > GASNETI_PSHM_FASTBOX_DEPTH_MAX) {
+    fprintf(stderr, "WARNING: GASNET_PSHM_FASTBOX_DEPTH (%lu) greater than max: using %lu\n",
+            gasneti_pshmnet_fbox_depth, GASNETI_PSHM_FASTBOX_DEPTH_MAX);
+    gasneti_pshmnet_fbox_depth = GASNETI_PSHM_FASTBOX_DEPTH_MAX;
+  }
+
+  maxpayload = gasneti_getenv_int_withdefault("GASNET_PSHM_FASTBOX_SIZE",
+                                              GASNETI_PSHM_FASTBOX_SIZE_DEFAULT, 1);
+  /* Must hold at least a Short with max args, and need not exceed the largest AM */
+  maxpayload = MAX(maxpayload, sizeof(gasneti_AMPSHM_shortmsg_t));
+  maxpayload = MIN(maxpayload, sizeof(gasneti_AMPSHM_maxmsg_t));
+  gasneti_pshmnet_fbox_slotsz =
+          GASNETI_ALIGNUP(offsetof(gasneti_pshmnet_fbox_slot_t, data) + maxpayload,
+                          GASNETI_CACHE_LINE_BYTES);
+  gasneti_pshmnet_fbox_maxpayload =
+          gasneti_pshmnet_fbox_slotsz - offsetof(gasneti_pshmnet_fbox_slot_t, data);
+
+  gasneti_pshmnet_fbox_inited = 1;
+}
+
+static size_t gasneti_pshmnet_fbox_memory_needed(gasneti_pshm_rank_t nodes)
+{
+  if_pf (!gasneti_pshmnet_fbox_inited) {
+    get_fbox_params();
+  }
+  /* Rings from every sender to a single receiver */
+  return (size_t)nodes * gasneti_pshmnet_fbox_depth * gasneti_pshmnet_fbox_slotsz;
 }
 
 size_t gasneti_pshmnet_memory_needed(gasneti_pshm_rank_t nodes)
 {
-  size_t pernode = gasneti_pshmnet_memory_needed_pernode(nodes);
-  size_t once = gasneti_pshmnet_memory_needed_once(nodes);
-  return once + nodes * pernode;
+  return nodes * gasneti_pshmnet_memory_needed_pernode(nodes);
 }
 
 /* Initializes the pshmnet region. Called from each node twice: 
@@ -569,57 +740,182 @@ gasneti_pshmnet_t *
 gasneti_pshmnet_init(void *region, size_t regionlen, gasneti_pshm_rank_t pshmnodes)
 {
   gasneti_pshmnet_t *vnet;
-  size_t szonce, szpernode;
+  size_t szpernode;
   void *myregion;
 
   /* make sure that our max buffer size fits all possible AMs */
   gasneti_assert(sizeof(gasneti_AMPSHM_maxmsg_t) <= GASNETI_PSHMNET_MAX_PAYLOAD);
 
   szpernode = gasneti_pshmnet_memory_needed_pernode(pshmnodes);
-  szonce = gasneti_pshmnet_memory_needed_once(pshmnodes);
 
-  if (regionlen < (szonce + szpernode * pshmnodes))
+  if (regionlen < (szpernode * pshmnodes))
     gasneti_fatalerror("Internal error: not enough memory for pshmnet: \n"
                        " given %lu effective bytes, but need %lu", 
-                       (unsigned long)regionlen, (unsigned long)(szonce + szpernode * pshmnodes));
+                       (unsigned long)regionlen, (unsigned long)(szpernode * pshmnodes));
 
   vnet = gasneti_malloc(sizeof(gasneti_pshmnet_t));
   vnet->nodecount = pshmnodes;
+  vnet->region = (uintptr_t)region;
+  vnet->pernode = szpernode;
 #if GASNET_PAR || GASNETI_CONDUIT_THREADS
   gasneti_mutex_init(&vnet->lock);
 #endif
 
-  /* initialize my own allocator */
+  /* place my block on my NUMA node (if enabled) before first touching it */
   myregion = (void *)((uintptr_t)region + (szpernode * gasneti_pshm_mynode));
   gasneti_assert_align(myregion, GASNETI_PSHMNET_PAGESIZE);
+  gasneti_pshm_numa_bind(myregion, szpernode);
+  if (gasneti_pshm_numa_node >= 0) {
+    size_t off;
+    for (off = 0; off < szpernode; off += GASNETI_PSHMNET_PAGESIZE) {
+      ((volatile char *)myregion)[off] = 0;
+    }
+  }
+
+  /* initialize my own allocator */
   vnet->my_allocator = gasneti_pshmnet_init_allocator(myregion, gasneti_pshmnet_queue_mem);
 
   /* initialize my own queue header */
-  vnet->queues = (gasneti_pshmnet_queue_t*)((uintptr_t)region + szpernode * pshmnodes);
-  gasneti_assert_align(vnet->queues, GASNETI_PSHMNET_PAGESIZE);
-  vnet->my_queue = &vnet->queues[gasneti_pshm_mynode];
+  vnet->my_queue = gasneti_pshmnet_queue(vnet, gasneti_pshm_mynode);
+  gasneti_assert_align(vnet->my_queue, GASNETI_PSHMNET_PAGESIZE);
   vnet->my_queue->head = 0;
   vnet->my_queue->shead = 0;
+  vnet->my_queue->fbox_pending = 0;
   gasneti_pshmnet_tail_init(&vnet->my_queue->tail);
 
+  /* initialize the fast box rings for which I am the receiver */
+  vnet->fbox_len = gasneti_pshmnet_fbox_memory_needed(pshmnodes);
+  vnet->fbox_next = 0;
+  vnet->fbox_streak = 0;
+  if (vnet->fbox_len) {
+    gasneti_pshm_rank_t i;
+    unsigned int j;
+
+    /* Medium payloads must share the alignment of those in the allocator */
+    gasneti_assert(((offsetof(gasneti_pshmnet_fbox_slot_t, data) ^
+                     offsetof(gasneti_pshmnet_allocator_block_t, payload.data)) & 7) == 0);
+    gasneti_assert_align(gasneti_pshmnet_fbox_base(vnet, gasneti_pshm_mynode),
+                         GASNETI_CACHE_LINE_BYTES);
+
+    vnet->fbox_tail = gasneti_calloc(pshmnodes, sizeof(unsigned int));
+    vnet->fbox_head = gasneti_calloc(pshmnodes, sizeof(unsigned int));
+    gasneti_leak(vnet->fbox_tail);
+    gasneti_leak(vnet->fbox_head);
+  #if GASNET_PAR || GASNETI_CONDUIT_THREADS
+    vnet->fbox_lock = gasneti_malloc(pshmnodes * sizeof(gasneti_mutex_t));
+    gasneti_leak(vnet->fbox_lock);
+  #endif
+    for (i = 0; i < pshmnodes; ++i) {
+    #if GASNET_PAR || GASNETI_CONDUIT_THREADS
+      gasneti_mutex_init(&vnet->fbox_lock[i]);
+    #endif
+      for (j = 0; j < gasneti_pshmnet_fbox_depth; ++j) {
+        gasneti_pshmnet_fbox_slot_t *slot =
+                gasneti_pshmnet_fbox_slot(vnet, gasneti_pshm_mynode, i, j);
+        gasneti_atomic_set(&slot->state, GASNETI_PSHMNET_FBOX_FREE, 0);
+      }
+    }
+  } else {
+    vnet->fbox_tail = vnet->fbox_head = NULL;
+  #if GASNET_PAR || GASNETI_CONDUIT_THREADS
+    vnet->fbox_lock = NULL;
+  #endif
+  }
+
   gasneti_leak(vnet);
   return vnet;
 }
 
 
+/* Reserve the next slot in my ring to 'target', if it is free.
+   Like the allocator, callers are responsible for serialization. */
+GASNETI_INLINE(gasneti_pshmnet_fbox_alloc)
+void *gasneti_pshmnet_fbox_alloc(gasneti_pshmnet_t *vnet, gasneti_pshm_rank_t target)
+{
+  unsigned int idx = vnet->fbox_tail[target];
+  gasneti_pshmnet_fbox_slot_t *slot =
+          gasneti_pshmnet_fbox_slot(vnet, target, gasneti_pshm_mynode, idx);
+
+  if (gasneti_atomic_read(&slot->state, GASNETI_ATOMIC_ACQ) != GASNETI_PSHMNET_FBOX_FREE)
+    return NULL; /* ring is full */
+
+  gasneti_atomic_set(&slot->state, GASNETI_PSHMNET_FBOX_BUSY, 0);
+  if (++idx == gasneti_pshmnet_fbox_depth) idx = 0;
+  vnet->fbox_tail[target] = idx;
+  return &slot->data;
+}
+
+/* Find a delivered slot, scanning the rings round-robin by source.
+ * Senders set the fbox_pending flag in our queue header after each delivery,
+ * so that gasneti_pshmnet_peek() need not scan.  We clear it only after a
+ * scan comes up empty, and then scan once more for any message whose
+ * sender's setting of the flag preceded our clearing of it.  A successful
+ * receive (re)sets the flag, since its ring (or another one skipped while
+ * locked by a concurrent receiver) may hold more.
+ */
+GASNETI_INLINE(gasneti_pshmnet_fbox_recv)
+gasneti_pshmnet_fbox_slot_t *gasneti_pshmnet_fbox_recv(gasneti_pshmnet_t *vnet,
+                                                       gasneti_pshm_rank_t *pfrom)
+{
+  const gasneti_pshm_rank_t nodes = vnet->nodecount;
+  gasneti_pshmnet_queue_t * const q = vnet->my_queue;
+  gasneti_pshm_rank_t from = vnet->fbox_next;
+  gasneti_pshm_rank_t n;
+  int retry = 1;
+
+again:
+  for (n = 0; n < nodes; ++n, from = ((from + 1 == nodes) ? 0 : from + 1)) {
+    gasneti_pshmnet_fbox_slot_t *slot =
+            gasneti_pshmnet_fbox_slot(vnet, gasneti_pshm_mynode, from, vnet->fbox_head[from]);
+    if (gasneti_atomic_read(&slot->state, 0) != GASNETI_PSHMNET_FBOX_FULL) continue;
+  #if GASNET_PAR || GASNETI_CONDUIT_THREADS
+    /* Another thread draining this ring is as good as empty */
+    if (gasneti_mutex_trylock(&vnet->fbox_lock[from])) continue;
+    slot = gasneti_pshmnet_fbox_slot(vnet, gasneti_pshm_mynode, from, vnet->fbox_head[from]);
+    if (gasneti_atomic_read(&slot->state, 0) != GASNETI_PSHMNET_FBOX_FULL) {
+      gasneti_mutex_unlock(&vnet->fbox_lock[from]);
+      continue;
+    }
+  #endif
+    gasneti_local_rmb(); /* ACQ */
+    gasneti_atomic_set(&slot->state, GASNETI_PSHMNET_FBOX_RECV, 0);
+    if (++vnet->fbox_head[from] == gasneti_pshmnet_fbox_depth) vnet->fbox_head[from] = 0;
+  #if GASNET_PAR || GASNETI_CONDUIT_THREADS
+    gasneti_mutex_unlock(&vnet->fbox_lock[from]);
+  #endif
+    vnet->fbox_next = (from + 1 == nodes) ? 0 : from + 1;
+    if (!q->fbox_pending) q->fbox_pending = 1;
+    *pfrom = from;
+    return slot;
+  }
+  if (retry) {
+    retry = 0;
+    q->fbox_pending = 0;
+    gasneti_local_mb();
+    goto again;
+  }
+  return NULL;
+}
+
 void * gasneti_pshmnet_get_send_buffer(gasneti_pshmnet_t *vnet, size_t nbytes, 
-                                       gasneti_pshm_rank_t target /* currently unused */)
+                                       gasneti_pshm_rank_t target)
 {
   gasneti_pshmnet_payload_t *p;
   void *retval = NULL;
   
   gasneti_assert(nbytes <= GASNETI_PSHMNET_MAX_PAYLOAD);
 
+  /* Small messages try the fast box first, falling back to the queue if full */
+  if (vnet->fbox_len && (nbytes <= gasneti_pshmnet_fbox_maxpayload)) {
+    gasneti_assert(target != gasneti_pshm_mynode);
+    retval = gasneti_pshmnet_fbox_alloc(vnet, target);
+    if (retval) return retval;
+  }
+
   p = gasneti_pshmnet_alloc(vnet->my_allocator, nbytes);
   if (p != NULL) {
     p->next = 0;
     p->from = gasneti_pshm_mynode;
-    p->allocator = vnet->my_allocator;
     retval = &p->data;
   }
   
@@ -631,10 +927,23 @@ void gasneti_pshmnet_deliver_send_buffer(gasneti_pshmnet_t *vnet, void *buf,
 {
   gasneti_pshmnet_payload_t *p =
           pshmnet_get_struct_addr_from_field_addr(gasneti_pshmnet_payload_t, data, buf);
-  gasneti_pshmnet_queue_t *q = &vnet->queues[target];
-  gasneti_atomic_val_t my_offset = gasneti_pshm_offset(p);
+  gasneti_pshmnet_queue_t *q = gasneti_pshmnet_queue(vnet, target);
+  gasneti_atomic_val_t my_offset;
   gasneti_atomic_val_t prev_offset;
 
+  if (gasneti_pshmnet_in_fbox(vnet, target, buf)) {
+    gasneti_pshmnet_fbox_slot_t *slot =
+          pshmnet_get_struct_addr_from_field_addr(gasneti_pshmnet_fbox_slot_t, data, buf);
+    gasneti_assert(gasneti_atomic_read(&slot->state, 0) == GASNETI_PSHMNET_FBOX_BUSY);
+    slot->len = nbytes;
+    gasneti_atomic_set(&slot->state, GASNETI_PSHMNET_FBOX_FULL, GASNETI_ATOMIC_REL);
+    gasneti_local_wmb(); /* flag must not precede the slot state */
+    q->fbox_pending = 1;
+    gasneti_pshm_wake(target);
+    return;
+  }
+
+  my_offset = gasneti_pshm_offset(p);
   p->len = nbytes;
 
   /* Nemesis enqueue: */
@@ -645,6 +954,8 @@ void gasneti_pshmnet_deliver_send_buffer(gasneti_pshmnet_t *vnet, void *buf,
   } else {
     q->head = my_offset;
   }
+
+  gasneti_pshm_wake(target);
 }
 
 GASNETI_ALWAYS_INLINE(gasneti_pshmnet_queue_peek)
@@ -653,6 +964,29 @@ int gasneti_pshmnet_queue_peek(const gasneti_pshmnet_queue_t * const q)
   return q->shead || q->head;
 }
 
+/* Non-zero if any fast box has a message waiting */
+GASNETI_INLINE(gasneti_pshmnet_fbox_peek)
+int gasneti_pshmnet_fbox_peek(const gasneti_pshmnet_t * const vnet)
+{
+  gasneti_pshm_rank_t from;
+
+  for (from = 0; from < vnet->nodecount; ++from) {
+    gasneti_pshmnet_fbox_slot_t *slot =
+            gasneti_pshmnet_fbox_slot(vnet, gasneti_pshm_mynode, from, vnet->fbox_head[from]);
+    if (gasneti_atomic_read(&slot->state, 0) == GASNETI_PSHMNET_FBOX_FULL) return 1;
+  }
+  return 0;
+}
+
+/* Non-zero if gasneti_pshmnet_recv() might find a message.
+ * The fbox_pending flag stays zero if fast boxes are disabled. */
+GASNETI_ALWAYS_INLINE(gasneti_pshmnet_peek)
+int gasneti_pshmnet_peek(const gasneti_pshmnet_t * const vnet)
+{
+  const gasneti_pshmnet_queue_t * const q = vnet->my_queue;
+  return gasneti_pshmnet_queue_peek(q) || q->fbox_pending;
+}
+
 int gasneti_pshmnet_recv(gasneti_pshmnet_t *vnet, void **pbuf, size_t *psize, 
                          gasneti_pshm_rank_t *pfrom)
 {
@@ -660,6 +994,21 @@ int gasneti_pshmnet_recv(gasneti_pshmnet_t *vnet, void **pbuf, size_t *psize,
   gasneti_pshmnet_payload_t *p = NULL;
   gasneti_pshmnet_queue_t *q = vnet->my_queue;
 
+  /* Fast boxes first, but yield to a non-empty queue after a streak of
+   * nodecount consecutive fast box receives to prevent its starvation. */
+  if (vnet->fbox_len) {
+    if ((vnet->fbox_streak < vnet->nodecount) || !gasneti_pshmnet_queue_peek(q)) {
+      gasneti_pshmnet_fbox_slot_t *slot = gasneti_pshmnet_fbox_recv(vnet, pfrom);
+      if (slot) {
+        vnet->fbox_streak += 1;
+        *pbuf  = &slot->data;
+        *psize = slot->len;
+        return 0;
+      }
+    }
+    vnet->fbox_streak = 0;
+  }
+
 #if GASNET_PAR || GASNETI_CONDUIT_THREADS
   if (gasneti_pshmnet_queue_peek(q)) {
     gasneti_mutex_lock(&vnet->lock);
@@ -708,13 +1057,184 @@ int gasneti_pshmnet_recv(gasneti_pshmnet_t *vnet, void **pbuf, size_t *psize,
 void gasneti_pshmnet_recv_release(gasneti_pshmnet_t *vnet, void *buf)
 {
   /* Address we handed out was the addr of the 'data' field */
-  gasneti_pshmnet_payload_t *p = 
-    pshmnet_get_struct_addr_from_field_addr(gasneti_pshmnet_payload_t,
-                                            data, buf);
-  gasneti_pshmnet_free(p);
+  if (gasneti_pshmnet_in_fbox(vnet, gasneti_pshm_mynode, buf)) {
+    gasneti_pshmnet_fbox_slot_t *slot =
+      pshmnet_get_struct_addr_from_field_addr(gasneti_pshmnet_fbox_slot_t,
+                                              data, buf);
+    gasneti_assert(gasneti_atomic_read(&slot->state, 0) == GASNETI_PSHMNET_FBOX_RECV);
+    gasneti_atomic_set(&slot->state, GASNETI_PSHMNET_FBOX_FREE, GASNETI_ATOMIC_REL);
+  } else {
+    gasneti_pshmnet_payload_t *p = 
+      pshmnet_get_struct_addr_from_field_addr(gasneti_pshmnet_payload_t,
+                                              data, buf);
+    gasneti_pshmnet_free(p);
+  }
 }
 
 
+/******************************************************************************
+ * Doorbells for blocking receivers
+ *
+ * A sleeper advertises itself, issues a full fence, and then rechecks its
+ * queues (and fast boxes) before sleeping on the futex for (at most)
+ * gasneti_pshm_sleep_usecs.  The matching check by senders in
+ * gasneti_pshm_wake() is deliberately NOT fenced, to keep a full fence out of
+ * every send.  On x86 the Nemesis tail swap is a full fence anyway, but the
+ * timeout is what bounds the rare late wakeup on other paths, and also covers
+ * events which are not AMs (such as completions by another local thread).
+ ******************************************************************************/
+
+/* Non-zero if an incoming message is waiting in either network */
+static int gasneti_pshmnet_pending(void)
+{
+  gasneti_pshmnet_t * const vnets[2] = { gasneti_request_pshmnet, gasneti_reply_pshmnet };
+  int i;
+
+  for (i = 0; i < 2; ++i) {
+    if (gasneti_pshmnet_queue_peek(vnets[i]->my_queue)) return 1;
+    if (vnets[i]->fbox_len && gasneti_pshmnet_fbox_peek(vnets[i])) return 1;
+  }
+  return 0;
+}
+
+void gasneti_pshm_block(void)
+{
+#if GASNETI_PSHM_FUTEX
+  gasneti_pshm_doorbell_t * const db = gasneti_pshm_doorbells + gasneti_pshm_mynode;
+  uint32_t seq;
+
+  if_pf (!gasneti_pshm_doorbells || !gasneti_reply_pshmnet) {
+    /* too early */
+    gasneti_sched_yield();
+    return;
+  }
+
+  seq = gasneti_atomic32_read(&db->seq, 0);
+  gasneti_atomic32_increment(&db->sleepers, 0);
+  gasneti_atomic32_increment(GASNETI_PSHM_SLEEPERS, 0);
+  gasneti_local_mb();
+
+  if (!gasneti_pshmnet_pending()) {
+    struct timespec timeout;
+    timeout.tv_sec  = gasneti_pshm_sleep_usecs / 1000000;
+    timeout.tv_nsec = (gasneti_pshm_sleep_usecs % 1000000) * 1000;
+    (void) syscall(SYS_futex, (int *)&db->seq, FUTEX_WAIT, (int)seq, &timeout, NULL, 0);
+  }
+
+  gasneti_atomic32_decrement(GASNETI_PSHM_SLEEPERS, 0);
+  gasneti_atomic32_decrement(&db->sleepers, GASNETI_ATOMIC_REL);
+#else
+  gasneti_sched_yield();
+#endif
+}
+
+void gasneti_pshm_wake(gasneti_pshm_rank_t target)
+{
+#if GASNETI_PSHM_FUTEX
+  gasneti_pshm_doorbell_t * const db = gasneti_pshm_doorbells + target;
+
+  gasneti_assert(target < gasneti_pshm_nodes);
+  if_pf (gasneti_atomic32_read(&db->sleepers, 0)) {
+    gasneti_atomic32_increment(&db->seq, 0);
+    (void) syscall(SYS_futex, (int *)&db->seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+  }
+#endif
+}
+
+void gasneti_pshm_wakeall(void)
+{
+#if GASNETI_PSHM_FUTEX
+  if_pf (gasneti_pshm_doorbells && gasneti_atomic32_read(GASNETI_PSHM_SLEEPERS, 0)) {
+    gasneti_pshm_rank_t i;
+    for (i = 0; i < gasneti_pshm_nodes; ++i) {
+      if (i != gasneti_pshm_mynode) gasneti_pshm_wake(i);
+    }
+  }
+#endif
+}
+
+/******************************************************************************
+ * NUMA placement
+ *
+ * When enabled, each process binds the pages it owns (its pshmnet blocks and
+ * its segment) to the NUMA node on which it is running at startup, with
+ * MPOL_PREFERRED so that a full node degrades to remote memory rather than
+ * failure.  Because the memory is shared, the policy holds regardless of
+ * which process first faults a page in.  Processes should be pinned for the
+ * placement to remain meaningful.
+ ******************************************************************************/
+#define GASNETI_PSHM_NUMA_MAXNODES 1024
+
+static void gasneti_pshm_numa_init(void)
+{
+#if GASNETI_PSHM_NUMA
+  /* Default is to enable only if there appears to be more than one node */
+  const int multinode = !access("/sys/devices/system/node/node1", F_OK);
+  unsigned int cpu, node;
+
+  if (!gasneti_getenv_yesno_withdefault("GASNET_PSHM_NUMA", multinode)) return;
+
+  if (syscall(SYS_getcpu, &cpu, &node, NULL) || (node >= GASNETI_PSHM_NUMA_MAXNODES)) {
+    GASNETI_TRACE_PRINTF(I, ("WARNING: GASNET_PSHM_NUMA unable to determine NUMA node: disabled"));
+    return;
+  }
+  gasneti_pshm_numa_node = node;
+#endif
+}
+
+void gasneti_pshm_numa_bind(void *addr, size_t len)
+{
+#if GASNETI_PSHM_NUMA
+  unsigned long mask[GASNETI_PSHM_NUMA_MAXNODES / (8 * sizeof(unsigned long))];
+  const int bits = 8 * sizeof(unsigned long);
+  const int node = gasneti_pshm_numa_node;
+
+  if (node < 0 || !len) return;
+  gasneti_assert(((uintptr_t)addr % GASNET_PAGESIZE) == 0);
+
+  memset(mask, 0, sizeof(mask));
+  mask[node / bits] = 1UL << (node % bits);
+  /* NOTE: the kernel treats maxnode as one more than the number of bits */
+  if (syscall(SYS_mbind, addr, GASNETI_PAGE_ALIGNUP(len), MPOL_PREFERRED,
+              mask, (unsigned long)(8 * sizeof(mask) + 1), MPOL_MF_MOVE)) {
+    GASNETI_TRACE_PRINTF(I, ("WARNING: mbind("GASNETI_LADDRFMT", %lu) to NUMA node %d failed: %s",
+                             GASNETI_LADDRSTR(addr), (unsigned long)len, node, strerror(errno)));
+  }
+#endif
+}
+
+/* Collective over the supernode: log placement and, if GASNET_VERBOSEENV
+ * is set, have node 0 display that of all members of its supernode */
+static void gasneti_pshm_numa_report(void)
+{
+#if GASNETI_PSHM_NUMA
+  int *nodes;
+
+  /* Every rank must take part in the exchange, including any which could
+   * not determine its NUMA node (and so contributes -1). */
+  if (gasneti_pshm_numa_node >= 0) {
+    GASNETI_TRACE_PRINTF(C, ("PSHM NUMA placement: queues, payload buffers and segment on NUMA node %d",
+                             gasneti_pshm_numa_node));
+  }
+
+  nodes = gasneti_malloc(gasneti_pshm_nodes * sizeof(int));
+  gasneti_pshmnet_bootstrapExchange(gasneti_request_pshmnet, &gasneti_pshm_numa_node,
+                                    sizeof(int), nodes);
+  if (gasneti_verboseenv() > 0) { /* -1 means "not yet known" */
+    gasneti_pshm_rank_t i;
+    fprintf(stderr, "PSHM NUMA placement for supernode %d (local rank:NUMA node, - if unbound):",
+            (int)gasneti_nodemap_global_rank);
+    for (i = 0; i < gasneti_pshm_nodes; ++i) {
+      if (nodes[i] < 0) fprintf(stderr, "%s%d:-", (i % 16) ? " " : "\n  ", (int)i);
+      else fprintf(stderr, "%s%d:%d", (i % 16) ? " " : "\n  ", (int)i, nodes[i]);
+    }
+    fprintf(stderr, "\n");
+    fflush(stderr);
+  }
+  gasneti_free(nodes);
+#endif
+}
+
 /******************************************************************************
  * PSHMnet bootstrap barrier
  * - TODO: only good a finite number of times before it wraps!
@@ -998,99 +1518,107 @@ void gasneti_pshmnet_bootstrapGather(gasneti_pshmnet_t *vnet, void *src,
  * Allocator implementation
  ******************************************************************************/
 
+static size_t gasneti_pshmnet_allocator_memory_needed(unsigned long depth)
+{
+  size_t result = GASNETI_PSHMNET_NUM_CLASSES * sizeof(gasneti_pshmnet_queue_t);
+  int c;
+
+  for (c = 0; c < GASNETI_PSHMNET_NUM_CLASSES; ++c) {
+    result += depth * GASNETI_PSHMNET_CLASS_BLOCKSZ(c);
+  }
+  return result;
+}
+
 static gasneti_pshmnet_allocator_t *gasneti_pshmnet_init_allocator(void *region, size_t len)
 {
-  int count = len >> GASNETI_PSHMNET_PAGESHIFT;
-  gasneti_pshmnet_allocator_block_t *tmp;
+  gasneti_pshmnet_allocator_t *a = gasneti_malloc(sizeof(gasneti_pshmnet_allocator_t));
+  /* Heads of returned lists, each on its own cache line (queue_t is padded as needed) */
+  gasneti_pshmnet_queue_t *heads = region;
+  uintptr_t addr = (uintptr_t)(heads + GASNETI_PSHMNET_NUM_CLASSES);
+  int c;
 
-  /* This implementation doesn't need to put allocator within shared memory.
-   * If a later one does, consider increasing the size returned by
-   * get_queue_mem()
-   */
-  gasneti_pshmnet_allocator_t *a = gasneti_malloc(sizeof(gasneti_pshmnet_allocator_t) +
-                                                  (count-1) * sizeof(unsigned int));
   gasneti_leak(a);
 
-  /* make sure we've arranged for page alignment */
-  gasneti_assert_align(GASNETI_PSHMNET_ALLOC_MAXSZ, GASNETI_PSHMNET_PAGESIZE);
   gasneti_assert_align(region, GASNETI_PSHMNET_PAGESIZE);
-
-  /* Initial state is one large free block */
-  a->next = 0;
-  a->count = count;
-  a->length[0] = count;
-  a->region = tmp = region;
-  gasneti_atomic_set(&tmp->in_use, 0, 0);
+  gasneti_assert(len >= gasneti_pshmnet_allocator_memory_needed(gasneti_pshmnet_network_depth));
+
+  for (c = 0; c < GASNETI_PSHMNET_NUM_CLASSES; ++c) {
+    gasneti_pshmnet_sizeclass_t *cls = &a->cls[c];
+    const size_t blocksz = GASNETI_PSHMNET_CLASS_BLOCKSZ(c);
+    gasneti_atomic_val_t home;
+    unsigned long i;
+
+    cls->returned = &heads[c].tail;
+    gasneti_pshmnet_tail_init(cls->returned);
+    /* Not gasneti_pshm_offset(), which asserts non-zero: node 0's first head IS at 0 */
+    home = (uintptr_t)cls->returned - (uintptr_t)gasnetc_pshmnet_region;
+    cls->max_payload = GASNETI_PSHMNET_CLASS_PAYLOAD(c);
+    cls->count = gasneti_pshmnet_network_depth;
+    cls->in_use = 0;
+
+    /* Thread all blocks onto the private free list, in address order */
+    cls->free = 0;
+    addr += blocksz * cls->count;
+    for (i = 0; i < cls->count; ++i) {
+      gasneti_pshmnet_allocator_block_t *block;
+      addr -= blocksz;
+      block = (gasneti_pshmnet_allocator_block_t *)addr;
+      gasneti_assert_align(block, GASNETI_CACHE_LINE_BYTES);
+      block->next_free = cls->free;
+      block->home = home;
+      cls->free = gasneti_pshm_offset(block);
+    }
+    addr += blocksz * cls->count;
+  }
+  gasneti_assert(addr <= (uintptr_t)region + len);
 
   return a;
 }
 
-
-/* Basic page-granular first-fit allocator
+/* Size-segregated allocator: O(1), except when adopting returned blocks
+   which is amortized O(1) (the walk just counts blocks for occupancy).
+   A request overflows to the next larger class if its own is exhausted.
    This allocator is NOT thread-safe - the callers are responsible for serialization. */
 static gasneti_pshmnet_payload_t *
 gasneti_pshmnet_alloc(gasneti_pshmnet_allocator_t *a, size_t nbytes)
 {
-  void *retval = NULL;
-  unsigned int curr;
-  unsigned int needed;
-  int remain;
-  void *region = a->region;
-
-  nbytes += offsetof(gasneti_pshmnet_allocator_block_t, payload.data);
-  gasneti_assert(nbytes <= GASNETI_PSHMNET_ALLOC_MAXSZ);
-
-  needed = (nbytes + GASNETI_PSHMNET_PAGESIZE - 1) >> GASNETI_PSHMNET_PAGESHIFT;
-  gasneti_assert(needed <= GASNETI_PSHMNET_ALLOC_MAXPG);
+  int c;
 
-  curr = a->next;
-  remain = a->count;
-  do {
-    unsigned int length = a->length[curr];
-    gasneti_pshmnet_allocator_block_t *next_block;
-    gasneti_pshmnet_allocator_block_t * const block = 
-            (gasneti_pshmnet_allocator_block_t*)
-                      ((uintptr_t)region + (curr << GASNETI_PSHMNET_PAGESHIFT));
-
-    if (!gasneti_atomic_read(&block->in_use, GASNETI_ATOMIC_ACQ)) {
-      while (length < needed) {
-        unsigned int next = curr + length;
-        gasneti_assert (next <= a->count);
-        if (next == a->count) break; /* hit end of region */
-        next_block = (gasneti_pshmnet_allocator_block_t*)
-                     ((uintptr_t)block + (length << GASNETI_PSHMNET_PAGESHIFT));
-        if (gasneti_atomic_read(&next_block->in_use, GASNETI_ATOMIC_ACQ)) break; /* hit busy block */
-        length += a->length[next];
-      }
-
-      if (length >= needed) {
-        unsigned int next = curr + needed;
+  gasneti_assert(nbytes <= GASNETI_PSHMNET_MAX_PAYLOAD);
 
-        if (length > needed) { /* Split it */
-          gasneti_assert (next < a->count);
-          a->length[next] = length - needed;
-          next_block = (gasneti_pshmnet_allocator_block_t*)
-                       ((uintptr_t)block + (needed << GASNETI_PSHMNET_PAGESHIFT));
-          gasneti_atomic_set(&next_block->in_use, 0, 0);
-        }
+  for (c = 0; c < GASNETI_PSHMNET_NUM_CLASSES; ++c) {
+    gasneti_pshmnet_sizeclass_t *cls = &a->cls[c];
+    gasneti_pshmnet_allocator_block_t *block;
 
-        a->length[curr] = needed;
-        gasneti_atomic_set(&block->in_use, 1, 0);
-        retval = &block->payload;
+    if (nbytes > cls->max_payload) continue;
 
-        if ((curr =next) == a->count) curr = 0;
-        break; /* do {} while (remain); */
+    if_pf (!cls->free && gasneti_pshmnet_tail_read(cls->returned)) {
+      gasneti_atomic_val_t offset = gasneti_pshmnet_tail_swap(cls->returned, 0);
+      gasneti_local_rmb(); /* ACQ */
+      cls->free = offset;
+      while (offset) {
+        block = gasneti_pshm_addr(offset);
+        offset = block->next_free;
+        gasneti_assert(cls->in_use > 0);
+        cls->in_use -= 1;
       }
+    }
 
-      /* Assume write is cheaper than branching again when length is unchanged */
-      a->length[curr] = length;
+    if_pt (cls->free) {
+      block = gasneti_pshm_addr(cls->free);
+      cls->free = block->next_free;
+      cls->in_use += 1;
+      switch (c) {
+        case 0:  GASNETI_TRACE_EVENT_VAL(I, PSHMNET_INUSE_SMALL, cls->in_use); break;
+        case 1:  GASNETI_TRACE_EVENT_VAL(I, PSHMNET_INUSE_MEDIUM, cls->in_use); break;
+        default: GASNETI_TRACE_EVENT_VAL(I, PSHMNET_INUSE_LARGE, cls->in_use); break;
+      }
+      return &block->payload;
     }
+  }
 
-    remain -= length;
-    if ((curr += length) == a->count) curr = 0;
-  } while (remain > 0); /* could be negative if merging took us past our starting point */
-  a->next = curr;
-  return retval;
+  GASNETI_TRACE_EVENT(I, PSHMNET_ALLOC_FULL);
+  return NULL;
 }
 
 static void gasneti_pshmnet_free(gasneti_pshmnet_payload_t *p)
@@ -1099,11 +1627,19 @@ static void gasneti_pshmnet_free(gasneti_pshmnet_payload_t *p)
   gasneti_pshmnet_allocator_block_t *block = 
       pshmnet_get_struct_addr_from_field_addr(gasneti_pshmnet_allocator_block_t,
                                               payload, p);
+  gasneti_pshmnet_tail_t *returned =
+      (gasneti_pshmnet_tail_t *)((uintptr_t)gasnetc_pshmnet_region + block->home);
+  const gasneti_atomic_val_t my_offset = gasneti_pshm_offset(block);
+  gasneti_atomic_val_t head;
+
   gasneti_assert(p == &block->payload);
-  /* assert block is page-aligned */
-  gasneti_assert( (((uintptr_t)block) % GASNETI_PSHMNET_PAGESIZE) == 0);
+  gasneti_assert_align(block, GASNETI_CACHE_LINE_BYTES);
 
-  gasneti_atomic_set(&block->in_use, 0, GASNETI_ATOMIC_REL);
+  /* Treiber push; REL ensures we are done with the payload before its reuse */
+  do {
+    head = gasneti_pshmnet_tail_read(returned);
+    block->next_free = head;
+  } while (!gasneti_pshmnet_tail_cas_rel(returned, head, my_offset));
 }
 
 /******************************************************************************
@@ -1213,12 +1749,12 @@ int gasneti_AMPSHMPoll(int repliesOnly)
   GASNETI_CHECKATTACH();
 #endif
 
-  if (gasneti_pshmnet_queue_peek(gasneti_reply_pshmnet->my_queue)) {
+  if (gasneti_pshmnet_peek(gasneti_reply_pshmnet)) {
     for (i = 0; i < GASNETI_AMPSHM_MAX_REPLY_PER_POLL; i++) 
       if (gasneti_AMPSHM_service_incoming_msg(gasneti_reply_pshmnet, 0))
         break;
   }
-  if (!repliesOnly && gasneti_pshmnet_queue_peek(gasneti_request_pshmnet->my_queue)) {
+  if (!repliesOnly && gasneti_pshmnet_peek(gasneti_request_pshmnet)) {
     for (i = 0; i < GASNETI_AMPSHM_MAX_REQUEST_PER_POLL; i++) 
       if (gasneti_AMPSHM_service_incoming_msg(gasneti_request_pshmnet, 1))
         break;
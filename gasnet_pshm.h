@@ -148,6 +148,7 @@ extern gasneti_pshmnet_t *gasneti_reply_pshmnet;
  * page size) needed for a new gasneti_pshmnet_t.
  * - Takes the number of nodes in the gasnet supernode.
  * - Reads the GASNET_PSHM_NETWORK_DEPTH environment variable, if set.
+ * - Reads the GASNET_PSHM_FASTBOX_{DEPTH,SIZE} environment variables, if set.
  */
 extern size_t gasneti_pshmnet_memory_needed(gasneti_pshm_rank_t nodes);
 
@@ -332,4 +333,16 @@ typedef struct {
 
 extern gasneti_pshm_barrier_t *gasneti_pshm_barrier;
 
+/*******************************************************************************
+ * Doorbells for PSHM receivers which block under GASNET_WAIT_BLOCK
+ * (gasneti_pshm_block() itself is declared in gasnet_help.h)
+ *******************************************************************************/
+
+/* Wake peers, if any, sleeping in gasneti_pshm_block() */
+extern void gasneti_pshm_wake(gasneti_pshm_rank_t target);
+extern void gasneti_pshm_wakeall(void);
+
+/* Bind [addr,addr+len) to this process's NUMA node, if GASNET_PSHM_NUMA is enabled */
+extern void gasneti_pshm_numa_bind(void *addr, size_t len);
+
 #endif /* _GASNET_SYSV_H */
@@ -606,6 +606,10 @@
 	GASNETI_TRACE_COLL_GATHER_ALL(name,team,dst,src,nbytes,flags)
   #define GASNETI_TRACE_COLL_EXCHANGE_M(name,team,dstlist,srclist,nbytes,flags) \
 	GASNETI_TRACE_COLL_GATHER_ALL_M(name,team,dstlist,srclist,nbytes,flags)
+  #define GASNETI_TRACE_COLL_EXCHANGEV(name,team,dst,dst_counts,dst_offsets,src,src_counts,src_offsets,max_nbytes,flags) do { \
+    GASNETI_TRACE_EVENT_VAL(W,name,max_nbytes);                                                            \
+    /* XXX: No detail implemented */                                                                       \
+  } while (0)
   #define GASNETI_TRACE_COLL_REDUCE(name,team,dstimage,dst,src,src_blksz,src_offset,elem_size,elem_count,func,func_arg,flags) do { \
     GASNETI_TRACE_EVENT_VAL(W,name,elem_count);                                                            \
     /* XXX: No detail implemented */                                                                       \
@@ -614,6 +618,10 @@
     GASNETI_TRACE_EVENT_VAL(W,name,elem_count);                                                            \
     /* XXX: No detail implemented */                                                                       \
   } while (0)
+  #define GASNETI_TRACE_COLL_REDUCE_ALL(name,team,dst,src,elem_size,elem_count,func,func_arg,flags) do { \
+    GASNETI_TRACE_EVENT_VAL(W,name,elem_count);                                                            \
+    /* XXX: No detail implemented */                                                                       \
+  } while (0)
   #define GASNETI_TRACE_COLL_SCAN(name,team,dst,dst_blksz,dst_offset,src,src_blksz,src_offset,elem_size,elem_count,func,func_arg,flags) do { \
     GASNETI_TRACE_EVENT_VAL(W,name,elem_count);                                                            \
     /* XXX: No detail implemented */                                                                       \
@@ -635,8 +643,10 @@
   #define GASNETI_TRACE_COLL_GATHER_ALL_M(name,team,dstlist,srclist,nbytes,flags)
   #define GASNETI_TRACE_COLL_EXCHANGE(name,team,dst,src,nbytes,flags)
   #define GASNETI_TRACE_COLL_EXCHANGE_M(name,team,dstlist,srclist,nbytes,flags)
+  #define GASNETI_TRACE_COLL_EXCHANGEV(name,team,dst,dst_counts,dst_offsets,src,src_counts,src_offsets,max_nbytes,flags)
   #define GASNETI_TRACE_COLL_REDUCE(name,team,dstimage,dst,src,src_blksz,src_offset,elem_size,elem_count,func,func_arg,flags)
   #define GASNETI_TRACE_COLL_REDUCE_M(name,team,dstimage,dst,srclist,src_blksz,src_offset,elem_size,elem_count,func,func_arg,flags)
+  #define GASNETI_TRACE_COLL_REDUCE_ALL(name,team,dst,src,elem_size,elem_count,func,func_arg,flags)
   #define GASNETI_TRACE_COLL_SCAN(name,team,dst,dst_blksz,dst_offset,src,src_blksz,src_offset,elem_size,elem_count,func,func_arg,flags)
   #define GASNETI_TRACE_COLL_SCAN_M(name,team,dstlist,dst_blksz,dst_offset,srclist,src_blksz,src_offset,elem_size,elem_count,func,func_arg,flags)
   #define GASNETI_TRACE_COLL_WAITSYNC_BEGIN() \
@@ -733,6 +743,7 @@ extern void gasneti_trace_finish(void);
         VAL(G, GETI_BULK, sz)                             \
         VAL(G, GETI_NB_BULK, sz)                          \
         VAL(G, GETI_NBI_BULK, sz)                         \
+        VAL(G, GETI_PLAN, sz)                             \
         VAL(G, GETS_BULK, sz)                             \
         VAL(G, GETS_NB_BULK, sz)                          \
         VAL(G, GETS_NBI_BULK, sz)                         \
@@ -743,6 +754,7 @@ extern void gasneti_trace_finish(void);
         VAL(P, PUTI_BULK, sz)                             \
         VAL(P, PUTI_NB_BULK, sz)                          \
         VAL(P, PUTI_NBI_BULK, sz)                         \
+        VAL(P, PUTI_PLAN, sz)                             \
         VAL(P, PUTS_BULK, sz)                             \
         VAL(P, PUTS_NB_BULK, sz)                          \
         VAL(P, PUTS_NBI_BULK, sz)                         \
@@ -794,6 +806,11 @@ extern void gasneti_trace_finish(void);
                                                           \
         CNT(I, AMPOLL, cnt)                               \
                                                           \
+        VAL(I, PSHMNET_INUSE_SMALL, blocks)               \
+        VAL(I, PSHMNET_INUSE_MEDIUM, blocks)              \
+        VAL(I, PSHMNET_INUSE_LARGE, blocks)               \
+        CNT(I, PSHMNET_ALLOC_FULL, cnt)                   \
+                                                          \
         VAL(I, GASNET_MALLOC, sz)                         \
         VAL(I, GASNET_FREE, sz)                           \
                                                           \
@@ -680,6 +680,64 @@ void _gasnet_geti_nbi_bulk(size_t dstcount, void * const dstlist[], size_t dstle
 #define gasnet_geti_nbi_bulk(dstcount,dstlist,dstlen,srcnode,srccount,srclist,srclen) \
        _gasnet_geti_nbi_bulk(dstcount,dstlist,dstlen,srcnode,srccount,srclist,srclen GASNETE_THREAD_GET)
 
+/*---------------------------------------------------------------------------------*/
+/* Persistent Indexed plans (experimental extension)
+   A plan captures the packetization of a fixed indexed put or get and ships the
+   remote addrlist to the peer once, so each later execution only moves data.
+   The address lists are copied at creation and may be reused by the caller.
+   A plan may be executed repeatedly, but not concurrently from multiple threads,
+   and all of its executions must be synced before it is destroyed.
+ */
+typedef struct gasnete_visplan_S *gasnet_visplan_t;
+
+#ifndef gasnete_puti_plan
+  extern gasnet_visplan_t gasnete_puti_plan(gasnet_node_t dstnode,
+                                           size_t dstcount, void * const dstlist[], size_t dstlen,
+                                           size_t srccount, void * const srclist[], size_t srclen GASNETE_THREAD_FARG);
+#endif
+#ifndef gasnete_geti_plan
+  extern gasnet_visplan_t gasnete_geti_plan(size_t dstcount, void * const dstlist[], size_t dstlen,
+                                           gasnet_node_t srcnode,
+                                           size_t srccount, void * const srclist[], size_t srclen GASNETE_THREAD_FARG);
+#endif
+#ifndef gasnete_visplan_exec
+  extern gasnet_handle_t gasnete_visplan_exec(gasnete_synctype_t synctype, gasnet_visplan_t plan GASNETE_THREAD_FARG);
+#endif
+#ifndef gasnete_visplan_destroy
+  extern void gasnete_visplan_destroy(gasnet_visplan_t plan GASNETE_THREAD_FARG);
+#endif
+
+GASNETI_INLINE(_gasnet_puti_plan) GASNETI_WARN_UNUSED_RESULT
+gasnet_visplan_t _gasnet_puti_plan(gasnet_node_t dstnode,
+                                   size_t dstcount, void * const dstlist[], size_t dstlen,
+                                   size_t srccount, void * const srclist[], size_t srclen GASNETE_THREAD_FARG) {
+  gasnete_boundscheck_addrlist(dstnode, dstcount, dstlist, dstlen);
+  gasnete_addrlist_checksizematch(dstcount, dstlen, srccount, srclen);
+  return gasnete_puti_plan(dstnode,dstcount,dstlist,dstlen,srccount,srclist,srclen GASNETE_THREAD_PASS);
+}
+#define gasnet_puti_plan(dstnode,dstcount,dstlist,dstlen,srccount,srclist,srclen) \
+       _gasnet_puti_plan(dstnode,dstcount,dstlist,dstlen,srccount,srclist,srclen GASNETE_THREAD_GET)
+
+GASNETI_INLINE(_gasnet_geti_plan) GASNETI_WARN_UNUSED_RESULT
+gasnet_visplan_t _gasnet_geti_plan(size_t dstcount, void * const dstlist[], size_t dstlen,
+                                   gasnet_node_t srcnode,
+                                   size_t srccount, void * const srclist[], size_t srclen GASNETE_THREAD_FARG) {
+  gasnete_boundscheck_addrlist(srcnode, srccount, srclist, srclen);
+  gasnete_addrlist_checksizematch(dstcount, dstlen, srccount, srclen);
+  return gasnete_geti_plan(dstcount,dstlist,dstlen,srcnode,srccount,srclist,srclen GASNETE_THREAD_PASS);
+}
+#define gasnet_geti_plan(dstcount,dstlist,dstlen,srcnode,srccount,srclist,srclen) \
+       _gasnet_geti_plan(dstcount,dstlist,dstlen,srcnode,srccount,srclist,srclen GASNETE_THREAD_GET)
+
+#define gasnet_visplan_exec_bulk(plan) \
+       ((void)gasnete_visplan_exec(gasnete_synctype_b,(plan) GASNETE_THREAD_GET))
+#define gasnet_visplan_exec_nb_bulk(plan) \
+       gasnete_visplan_exec(gasnete_synctype_nb,(plan) GASNETE_THREAD_GET)
+#define gasnet_visplan_exec_nbi_bulk(plan) \
+       ((void)gasnete_visplan_exec(gasnete_synctype_nbi,(plan) GASNETE_THREAD_GET))
+#define gasnet_visplan_destroy(plan) \
+       gasnete_visplan_destroy((plan) GASNETE_THREAD_GET)
+
 /*---------------------------------------------------------------------------------*/
 /* Strided */
 #ifndef gasnete_puts
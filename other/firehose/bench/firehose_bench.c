@@ -0,0 +1,235 @@
+/*   $Source: bitbucket.org:berkeleylab/gasnet.git/other/firehose/bench/firehose_bench.c $
+ * Description: Standalone microbenchmark of firehose-region
+ * Copyright 2026, The Regents of the University of California
+ * Terms of use are as specified in license.txt
+ */
+
+/* This program times the firehose-region table operations as a function of
+ * region size, using a fake pin/unpin backend (no memory is ever touched, so
+ * the "addresses" need not be mapped).  For each size it reports the time for
+ *   miss    - local pin + release of a new region, evicting an old one
+ *   hit     - local pin + release of a region already pinned
+ *   partial - partial local pin of a range ending in a pinned region
+ *
+ * It then models registration-heavy traffic, with the fake backend spinning
+ * for a fixed cost per call plus a cost per page pinned, and reports the
+ * time per buffer for BENCH_BATCH new buffers at a time when
+ *   sync    - each is pinned by firehose_local_pin() and released
+ *   async   - all are requested by firehose_local_pin_async(), then
+ *             firehose_poll() is run until all have completed
+ * The "issue" column is the part of the async time spent in the pin calls.
+ * See Makefile in this directory for how to build it.
+ */
+
+#include <firehose.h>
+
+#ifndef BENCH_MAXPAGES
+#define BENCH_MAXPAGES 2048
+#endif
+#ifndef BENCH_REGIONS
+#define BENCH_REGIONS 64
+#endif
+#ifndef BENCH_BATCH
+#define BENCH_BATCH 16
+#endif
+
+static uint64_t pins = 0, unpins = 0, moves = 0;
+
+/* Registration cost model, zero for the table benchmarks */
+static uint64_t cost_per_call_ns = 0;
+static uint64_t cost_per_page_ns = 0;
+
+static void
+spin_ns(uint64_t ns)
+{
+	const gasneti_tick_t start = gasneti_ticks_now();
+	while (gasneti_ticks_to_ns(gasneti_ticks_now() - start) < ns) {}
+}
+
+/* The fake backend counts, and spins to stand in for the cost of pinning */
+extern int
+firehose_move_callback(gasnet_node_t node,
+		       const firehose_region_t *unpin_list, size_t unpin_num,
+		       firehose_region_t *pin_list, size_t pin_num)
+{
+	uint64_t pages = 0;
+	size_t i;
+
+	for (i = 0; i < pin_num; ++i)
+		pages += pin_list[i].len / GASNET_PAGESIZE;
+	if (cost_per_call_ns || cost_per_page_ns)
+		spin_ns(cost_per_call_ns + pages * cost_per_page_ns);
+
+	unpins += unpin_num;
+	pins += pin_num;
+	moves++;
+	return 0;
+}
+
+extern int
+firehose_remote_callback(gasnet_node_t node,
+			 const firehose_region_t *pin_list, size_t num_pinned,
+			 firehose_remotecallback_args_t *args)
+{
+	gasneti_fatalerror("firehose_bench: unexpected remote callback");
+	return 0;
+}
+
+/* Disjoint (and non-adjacent, so unmergeable) regions of 'pages' pages */
+#define REGION_ADDR(base, i, pages) ((base) + (uintptr_t)(i) * 2 * (pages) * GASNET_PAGESIZE)
+
+static double
+ns_per_op(gasneti_tick_t start, int iters)
+{
+	return (double) gasneti_ticks_to_ns(gasneti_ticks_now() - start) / iters;
+}
+
+static const firehose_request_t *async_reqs[BENCH_BATCH];
+static int async_done;
+
+static void
+async_callback(void *context, const firehose_request_t *req, int allLocalHit)
+{
+	async_reqs[(int)(uintptr_t)context] = req;
+	async_done++;
+}
+
+int
+main(int argc, char **argv)
+{
+	const int iters = (argc > 1) ? atoi(argv[1]) : 10000;
+	const int rounds = MAX(1, iters / (10 * BENCH_BATCH));
+	firehose_info_t info;
+	uintptr_t base;
+	size_t pages;
+
+	/* No gasnet_attach(), which is off limits to code using gasnet_internal.h */
+	GASNETI_SAFE(gasnet_init(&argc, &argv));
+
+	if (iters <= 0) {
+		fprintf(stderr, "usage: %s [iterations] [ns/call] [ns/page]\n", argv[0]);
+		gasnet_exit(1);
+	}
+
+	/* Far above anything real, to make the point that it is never touched */
+	base = (uintptr_t)1 << (sizeof(void *) * 8 - 2);
+
+	firehose_init(BENCH_REGIONS * BENCH_MAXPAGES * GASNET_PAGESIZE,
+		      BENCH_REGIONS, BENCH_MAXPAGES * GASNET_PAGESIZE,
+		      NULL, 0, FIREHOSE_INIT_FLAG_LOCAL_ONLY, &info);
+
+	if (gasneti_mynode == 0) {
+		printf("firehose_bench: %d iterations, %d regions\n", iters, BENCH_REGIONS);
+		printf("%8s %12s %12s %12s\n", "pages", "miss(ns)", "hit(ns)", "partial(ns)");
+	}
+
+	for (pages = 1; pages <= BENCH_MAXPAGES; pages *= 2) {
+		const size_t len = pages * GASNET_PAGESIZE;
+		const firehose_request_t *req;
+		double t_miss, t_hit, t_partial;
+		gasneti_tick_t start;
+		int i;
+
+		/* Cycle through twice as many regions as the victim FIFO holds */
+		start = gasneti_ticks_now();
+		for (i = 0; i < iters; ++i) {
+			req = firehose_local_pin(REGION_ADDR(base, i % (2 * BENCH_REGIONS), pages), len, NULL);
+			firehose_release(&req, 1);
+		}
+		t_miss = ns_per_op(start, iters);
+
+		/* Warm one region and hit it repeatedly */
+		req = firehose_local_pin(base, len, NULL);
+		firehose_release(&req, 1);
+		start = gasneti_ticks_now();
+		for (i = 0; i < iters; ++i) {
+			req = firehose_local_pin(base, len, NULL);
+			firehose_release(&req, 1);
+		}
+		t_hit = ns_per_op(start, iters);
+
+		/* Only the last 'pages' of the 2*pages range are pinned */
+		start = gasneti_ticks_now();
+		for (i = 0; i < iters; ++i) {
+			req = firehose_partial_local_pin(base - len, 2 * len, NULL);
+			if_pf (!req) gasneti_fatalerror("firehose_bench: partial pin missed");
+			firehose_release(&req, 1);
+		}
+		t_partial = ns_per_op(start, iters);
+
+		if (gasneti_mynode == 0)
+			printf("%8d %12.1f %12.1f %12.1f\n", (int)pages, t_miss, t_hit, t_partial);
+	}
+
+	/* Defaults are in the range of a registration syscall and page walk */
+	cost_per_call_ns = (argc > 2) ? atoi(argv[2]) : 5000;
+	cost_per_page_ns = (argc > 3) ? atoi(argv[3]) : 250;
+
+	if (gasneti_mynode == 0) {
+		printf("\nregistration cost %llu ns/call + %llu ns/page, %d buffers at a time\n",
+		       (unsigned long long)cost_per_call_ns,
+		       (unsigned long long)cost_per_page_ns, BENCH_BATCH);
+		printf("%8s %12s %12s %12s %10s %10s\n", "pages", "sync(ns)",
+		       "async(ns)", "issue(ns)", "sync_mv", "async_mv");
+	}
+
+	for (pages = 1; pages <= BENCH_MAXPAGES; pages *= 4) {
+		const size_t len = pages * GASNET_PAGESIZE;
+		const int nbuf = rounds * BENCH_BATCH;
+		/* Apart from the above, and from the other sizes, so all miss */
+		const uintptr_t rbase = base + ((uintptr_t)1 << (sizeof(void *) * 8 - 3))
+						+ (uintptr_t)pages * ((uintptr_t)1 << 32);
+		double t_sync, t_async, t_issue = 0;
+		uint64_t mv_sync, mv_async;
+		gasneti_tick_t start;
+		int r, i, next = 0;
+
+		mv_sync = moves;
+		start = gasneti_ticks_now();
+		for (i = 0; i < nbuf; ++i) {
+			const firehose_request_t *req =
+			   firehose_local_pin(REGION_ADDR(rbase, next++ % (2 * BENCH_REGIONS), pages), len, NULL);
+			firehose_release(&req, 1);
+		}
+		t_sync = ns_per_op(start, nbuf);
+		mv_sync = moves - mv_sync;
+
+		mv_async = moves;
+		start = gasneti_ticks_now();
+		for (r = 0; r < rounds; ++r) {
+			gasneti_tick_t issue = gasneti_ticks_now();
+
+			async_done = 0;
+			for (i = 0; i < BENCH_BATCH; ++i) {
+				const firehose_request_t *req =
+				   firehose_local_pin_async(REGION_ADDR(rbase, next++ % (2 * BENCH_REGIONS), pages),
+							    len, NULL, async_callback, (void *)(uintptr_t)i);
+				if (req) {
+					async_reqs[i] = req;
+					async_done++;
+				}
+			}
+			t_issue += gasneti_ticks_to_ns(gasneti_ticks_now() - issue);
+
+			while (async_done < BENCH_BATCH)
+				firehose_poll();
+			firehose_release(async_reqs, BENCH_BATCH);
+		}
+		t_async = ns_per_op(start, nbuf);
+		t_issue /= nbuf;
+		mv_async = moves - mv_async;
+
+		if (gasneti_mynode == 0)
+			printf("%8d %12.1f %12.1f %12.1f %10llu %10llu\n", (int)pages,
+			       t_sync, t_async, t_issue,
+			       (unsigned long long)mv_sync, (unsigned long long)mv_async);
+	}
+
+	if (gasneti_mynode == 0)
+		printf("firehose_bench: %llu pins, %llu unpins\n",
+		       (unsigned long long)pins, (unsigned long long)unpins);
+
+	firehose_fini();
+	gasnet_exit(0);
+	return 0;
+}
@@ -0,0 +1,34 @@
+/*   $Source: bitbucket.org:berkeleylab/gasnet.git/other/firehose/bench/firehose_fwd.h $
+ * Description: Configuration of firehose for the standalone benchmark
+ * Copyright 2026, The Regents of the University of California
+ * Terms of use are as specified in license.txt
+ */
+
+#ifndef _BENCH_FIREHOSE_FWD_H
+#define _BENCH_FIREHOSE_FWD_H
+
+#define FH_BUCKET_SIZE	GASNET_PAGESIZE
+
+/* The benchmark exercises firehose-region, w/o a client_t */
+#define FIREHOSE_REGION
+
+typedef struct _firehose_remotecallback_args_t {
+        uintptr_t       local_addr;
+        uintptr_t       remote_addr;
+        size_t          nbytes;
+}
+firehose_remotecallback_args_t;
+
+/* The firehose statistics are only registered by conduits using firehose */
+#if GASNETI_STATS_OR_TRACE
+  #undef GASNETI_TRACE_EVENT
+  #undef GASNETI_TRACE_EVENT_VAL
+  #undef GASNETI_TRACE_EVENT_TIME
+  #undef GASNETI_STAT_EVENT_VAL
+  #define GASNETI_TRACE_EVENT(type, name)		((void)0)
+  #define GASNETI_TRACE_EVENT_VAL(type, name, val)	((void)0)
+  #define GASNETI_TRACE_EVENT_TIME(type, name, time)	((void)0)
+  #define GASNETI_STAT_EVENT_VAL(type, name, val)	((void)0)
+#endif
+
+#endif
@@ -23,9 +23,43 @@ static void fh_request_free(firehose_request_t *req);
  * firehose operation that modifies the state of the firehose table.  It must
  * be held during most of the firehose operations - adding/removing to the hash
  * table, adding/removing from the local and victim FIFOs.
+ * The exception is the lock-free hit path described in firehose_internal.h.
  */
 gasneti_mutex_t         fh_table_lock = GASNETI_MUTEX_INITIALIZER;
 
+#if FIREHOSE_SMP
+  /* Announcements of threads in the lock-free paths, which FH_TABLE_LOCK
+   * waits to drain.  Threads are assigned to stripes round-robin. */
+  gasneti_atomic_t        fh_table_busy = gasneti_atomic_init(0);
+  fh_fast_stripe_t        fh_fast_stripes[FH_FAST_STRIPES];
+  static gasneti_atomic_t fh_fast_nextstripe = gasneti_atomic_init(0);
+  GASNETI_THREADKEY_DEFINE(fh_fast_stripe_key);
+
+  extern gasneti_atomic_t *
+  fh_fast_enter(void)
+  {
+	fh_fast_stripe_t *stripe = gasneti_threadkey_get(fh_fast_stripe_key);
+
+	if_pf (stripe == NULL) {
+		gasneti_atomic_val_t idx = gasneti_atomic_add(&fh_fast_nextstripe, 1, 0);
+		stripe = &fh_fast_stripes[idx % FH_FAST_STRIPES];
+		gasneti_threadkey_set(fh_fast_stripe_key, stripe);
+	}
+
+	gasneti_atomic_increment(&stripe->count, GASNETI_ATOMIC_MB_POST);
+	if_pt (!gasneti_atomic_read(&fh_table_busy, GASNETI_ATOMIC_RMB_POST))
+		return &stripe->count;
+
+	/* Somebody holds (or is acquiring) the table lock */
+	gasneti_atomic_decrement(&stripe->count, GASNETI_ATOMIC_REL);
+	return NULL;
+  }
+#endif
+
+/* The request_t freelist has its own lock, since the lock-free paths need
+ * request_t's too.  It nests inside the table lock, never the reverse. */
+static gasneti_mutex_t  fh_request_lock = GASNETI_MUTEX_INITIALIZER;
+
 #ifndef FH_POLL_NOOP 
   /* This lock protects the poll FIFO queue, used to enqueue callbacks. */
   gasneti_mutex_t         fh_pollq_lock = GASNETI_MUTEX_INITIALIZER;
@@ -80,6 +114,10 @@ int fh_verbose = 0;
  *
  * firehose_release()
  *     calls fh_release_local_region() or fh_release_remote_region()
+ *
+ * All but the partial pins first try fh_fast_acquire_region(), and
+ * firehose_release() first tries fh_fast_release_region(), without the
+ * table lock.
  */
 
 uint32_t	fhi_InitFlags = 0;
@@ -221,18 +259,69 @@ firehose_fini()
 
 /* firehose_poll()
  *
- * Empties the Callback Fifo Queue.
+ * Services deferred local pins and empties the Callback Fifo Queue.
  *
  * XXX should make fh_callback_t allocated from freelists.
  */
 #ifndef FH_POLL_NOOP
 fh_pollq_t	fh_CallbackFifo = FH_STAILQ_HEAD_INITIALIZER(fh_CallbackFifo);
 
+/* Local pins deferred by firehose_local_pin_async(), protected by the
+ * table lock.  Requests in it carry FH_FLAG_PENDING. */
+static fh_pollq_t fh_LocalPinQ = FH_STAILQ_HEAD_INITIALIZER(fh_LocalPinQ);
+
+/* Service one batch from the head of fh_LocalPinQ, running the completion
+ * callbacks once the table lock is dropped.
+ */
+static void
+fh_poll_local_pins(void)
+{
+	fh_completion_callback_t	*ccb[FH_MAX_PIN_BATCH];
+	firehose_request_t		*reqs[FH_MAX_PIN_BATCH];
+	int				localhit[FH_MAX_PIN_BATCH];
+	int				i, num = 0, done = 0;
+
+	FH_TABLE_LOCK;
+
+	while ((num < FH_MAX_PIN_BATCH) && !FH_STAILQ_EMPTY(&fh_LocalPinQ)) {
+		ccb[num] = (fh_completion_callback_t *)
+				FH_STAILQ_FIRST(&fh_LocalPinQ);
+		FH_STAILQ_REMOVE_HEAD(&fh_LocalPinQ);
+		reqs[num] = ccb[num]->request;
+		reqs[num]->flags &= ~FH_FLAG_PENDING;
+		num++;
+	}
+
+	if (num) {
+		done = fh_acquire_local_batch(reqs, localhit, num);
+		gasneti_assert((done > 0) && (done <= num));
+		GASNETI_TRACE_EVENT_VAL(C, FH_LOCAL_BATCH, done);
+
+		/* Return the remainder to the head of the queue, in order */
+		for (i = num - 1; i >= done; i--) {
+			reqs[i]->flags |= FH_FLAG_PENDING;
+			FH_STAILQ_INSERT_HEAD(&fh_LocalPinQ,
+					      (fh_callback_t *) ccb[i]);
+		}
+	}
+
+	FH_TABLE_UNLOCK;
+
+	for (i = 0; i < done; i++) {
+		reqs[i]->flags |= FH_FLAG_PINNED;
+		ccb[i]->callback(ccb[i]->context, reqs[i], localhit[i]);
+		fh_free_completion_callback(ccb[i]);
+	}
+}
+
 void
 firehose_poll()
 {
 	fh_callback_t	*fhc;
 
+	while (!FH_STAILQ_EMPTY(&fh_LocalPinQ))
+		fh_poll_local_pins();
+
 	while (!FH_STAILQ_EMPTY(&fh_CallbackFifo)) {
 		FH_POLLQ_LOCK;
 
@@ -281,21 +370,68 @@ firehose_poll()
 }
 #endif
 
+/* Try to satisfy a pin as a "hit" without the table lock.
+ * Returns the (filled in) request on success.  Otherwise any request_t
+ * which was allocated is left in *req_p for the locked path to use.
+ */
+GASNETI_INLINE(fh_fast_pin)
+firehose_request_t *
+fh_fast_pin(gasnet_node_t node, uintptr_t addr, size_t len,
+	    firehose_request_t *ureq, firehose_request_t **req_p)
+{
+	firehose_request_t	*req;
+	int			hit = 0;
+	FH_FAST_DECL;
+
+	*req_p = req = fh_request_new(ureq, 0);
+	if_pf (req == NULL)
+		return NULL;
+
+	req->node = node;
+	req->addr = addr;
+	req->len  = len;
+
+	if_pt (FH_FAST_ENTER()) {
+		hit = fh_fast_acquire_region(req);
+		FH_FAST_EXIT();
+	}
+
+	return hit ? req : NULL;
+}
+
+/* Return an unused request_t obtained by fh_fast_pin() */
+GASNETI_INLINE(fh_fast_unpin)
+void fh_fast_unpin(firehose_request_t *req)
+{
+	if (req && (req->flags & FH_FLAG_FHREQ))
+		fh_request_free(req);
+}
+
 extern const firehose_request_t *
 firehose_local_pin(uintptr_t addr, size_t nbytes, firehose_request_t *ureq)
 {
 	firehose_request_t	*req = NULL;
+	const uintptr_t		pin_addr = FH_ADDR_ALIGN(addr);
+	const size_t		pin_len  = FH_SIZE_ALIGN(addr,nbytes);
+
+	GASNETI_TRACE_EVENT_VAL(C,FH_LOCAL_PIN,(pin_len >> FH_BUCKET_SHIFT));
+
+	if_pt (fh_fast_pin(gasneti_mynode, pin_addr, pin_len, ureq, &req)) {
+		req->flags |= FH_FLAG_PINNED;
+		GASNETI_TRACE_EVENT(C,FH_LOCAL_HIT);
+		return req;
+	}
 
 	FH_TABLE_LOCK;
 
-	req = fh_request_new(ureq, 1);
+	if_pf (req == NULL)
+		req = fh_request_new(ureq, 1);
 	gasneti_assert(req != NULL);
 
 	req->node   = gasneti_mynode;
-	req->addr   = FH_ADDR_ALIGN(addr);
-	req->len    = FH_SIZE_ALIGN(addr,nbytes);
+	req->addr   = pin_addr;
+	req->len    = pin_len;
 	req->flags |= FH_FLAG_PINNED;
-	GASNETI_TRACE_EVENT_VAL(C,FH_LOCAL_PIN,(req->len >> FH_BUCKET_SHIFT));
 
 	/* HIT/MISS tracing is done in fh_acquire_local_region() */
 	fh_acquire_local_region(req);
@@ -319,9 +455,16 @@ firehose_try_local_pin(uintptr_t addr, size_t len, firehose_request_t *ureq)
 		FIREHOSE_AMPOLL();
 #endif
 
+	if_pt (fh_fast_pin(gasneti_mynode, addr, len, ureq, &req)) {
+		req->flags |= FH_FLAG_PINNED;
+		GASNETI_TRACE_EVENT(C,FH_TRY_LOCAL_HIT);
+		return req;
+	}
+
 	FH_TABLE_LOCK;
 	if (fh_region_ispinned(gasneti_mynode, addr, len)) {
-		req = fh_request_new(ureq, 0);
+		if_pf (req == NULL)
+			req = fh_request_new(ureq, 0);
 		if_pt (req != NULL) {
 			req->node   = gasneti_mynode;
 			req->addr   = addr;
@@ -336,6 +479,8 @@ firehose_try_local_pin(uintptr_t addr, size_t len, firehose_request_t *ureq)
 		}
 	}
 	else {
+		fh_fast_unpin(req);
+		req = NULL;
 		GASNETI_TRACE_EVENT(C,FH_TRY_LOCAL_MISS);
 	}
 	FH_TABLE_UNLOCK;
@@ -382,6 +527,61 @@ firehose_partial_local_pin(uintptr_t addr, size_t len,
 	return req;
 }
 
+/* Misses are queued for firehose_poll(), which pins them in batches */
+extern const firehose_request_t *
+firehose_local_pin_async(uintptr_t addr, size_t nbytes,
+			 firehose_request_t *ureq,
+			 firehose_completed_fn_t callback, void *context)
+{
+#ifdef FH_POLL_NOOP
+	return firehose_local_pin(addr, nbytes, ureq);
+#else
+	firehose_request_t	*req = NULL;
+	fh_completion_callback_t *ccb;
+	const uintptr_t		pin_addr = FH_ADDR_ALIGN(addr);
+	const size_t		pin_len  = FH_SIZE_ALIGN(addr,nbytes);
+
+	gasneti_assert(callback != NULL);
+	GASNETI_TRACE_EVENT_VAL(C,FH_LOCAL_PIN,(pin_len >> FH_BUCKET_SHIFT));
+
+	if_pt (fh_fast_pin(gasneti_mynode, pin_addr, pin_len, ureq, &req)) {
+		req->flags |= FH_FLAG_PINNED;
+		GASNETI_TRACE_EVENT(C,FH_LOCAL_HIT);
+		return req;
+	}
+
+	FH_TABLE_LOCK;
+
+	if_pf (req == NULL)
+		req = fh_request_new(ureq, 1);
+	gasneti_assert(req != NULL);
+
+	req->node   = gasneti_mynode;
+	req->addr   = pin_addr;
+	req->len    = pin_len;
+
+	if (fh_region_ispinned(gasneti_mynode, pin_addr, pin_len)) {
+		req->flags |= FH_FLAG_PINNED;
+		fh_commit_try_local_region(req);
+		GASNETI_TRACE_EVENT(C,FH_LOCAL_HIT);
+	}
+	else {
+		ccb = fh_alloc_completion_callback();
+		ccb->request  = req;
+		ccb->callback = callback;
+		ccb->context  = context;
+		req->flags |= FH_FLAG_PENDING;
+		FH_STAILQ_INSERT_TAIL(&fh_LocalPinQ, (fh_callback_t *) ccb);
+		GASNETI_TRACE_EVENT(C,FH_LOCAL_DEFER);
+		req = NULL;
+	}
+
+	FH_TABLE_UNLOCK;
+
+	return req;
+#endif
+}
+
 extern const firehose_request_t *
 firehose_remote_pin(gasnet_node_t node, uintptr_t addr, size_t len,
 		    uint32_t flags, firehose_request_t *ureq,
@@ -396,20 +596,27 @@ firehose_remote_pin(gasnet_node_t node, uintptr_t addr, size_t len,
 	gasneti_assert(remote_args_callback == NULL ? 1 : 
 		       (flags & FIREHOSE_FLAG_ENABLE_REMOTE_CALLBACK));
 
-	FH_TABLE_LOCK;
+	GASNETI_TRACE_EVENT_VAL(C,FH_REMOTE_PIN,(FH_SIZE_ALIGN(addr,len) >> FH_BUCKET_SHIFT));
 
-	req = fh_request_new(ureq, 1);
-	gasneti_assert(req != NULL);
+	if_pt (fh_fast_pin(node, FH_ADDR_ALIGN(addr), FH_SIZE_ALIGN(addr,len), ureq, &req)) {
+		req->flags |= FH_FLAG_PINNED;
+	}
+	else {
+		FH_TABLE_LOCK;
 
-	req->node = node;
-	req->addr = FH_ADDR_ALIGN(addr); 
-	req->len  = FH_SIZE_ALIGN(addr,len);
-	GASNETI_TRACE_EVENT_VAL(C,FH_REMOTE_PIN,(req->len >> FH_BUCKET_SHIFT));
+		if_pf (req == NULL)
+			req = fh_request_new(ureq, 1);
+		gasneti_assert(req != NULL);
 
-	fh_acquire_remote_region(req, callback, context, flags, remote_args_callback);
+		req->node = node;
+		req->addr = FH_ADDR_ALIGN(addr); 
+		req->len  = FH_SIZE_ALIGN(addr,len);
 
-	/* Note that fh_acquire_remote_region unlocks before returning */
-	FH_TABLE_ASSERT_UNLOCKED;
+		fh_acquire_remote_region(req, callback, context, flags, remote_args_callback);
+
+		/* Note that fh_acquire_remote_region unlocks before returning */
+		FH_TABLE_ASSERT_UNLOCKED;
+	}
 
 	if (req->flags & FH_FLAG_PINNED) {
 		/* If the request could be entirely pinned, process the
@@ -455,10 +662,16 @@ firehose_try_remote_pin(gasnet_node_t node, uintptr_t addr, size_t len,
 		FIREHOSE_AMPOLL();
 #endif
 
+	if_pt (fh_fast_pin(node, addr, len, ureq, &req)) {
+		GASNETI_TRACE_EVENT(C,FH_TRY_REMOTE_HIT);
+		return req;
+	}
+
 	FH_TABLE_LOCK;
 
 	if (fh_region_ispinned(node, addr, len)) {
-		req = fh_request_new(ureq, 0);
+		if_pf (req == NULL)
+			req = fh_request_new(ureq, 0);
 		if_pt (req != NULL) {
 			req->node = node;
 			req->addr = addr;
@@ -472,6 +685,8 @@ firehose_try_remote_pin(gasnet_node_t node, uintptr_t addr, size_t len,
 		}
 	}
 	else {
+		fh_fast_unpin(req);
+		req = NULL;
 		GASNETI_TRACE_EVENT(C,FH_TRY_REMOTE_MISS);
 	}
 	FH_TABLE_UNLOCK;
@@ -522,30 +737,64 @@ firehose_partial_remote_pin(gasnet_node_t node, uintptr_t addr,
 	return req;
 }
 
+/* Releases which leave the region in use are done without the table lock.
+ * The remainder are done together under one acquisition of the lock, with
+ * a single trim of the local victim FIFO at the end.
+ */
 extern void
 firehose_release(firehose_request_t const **reqs, int numreqs)
 {
 	int			i;
+	int			remain = numreqs;
+	int			local = 0;
+	FH_FAST_DECL;
 
 	GASNETI_TRACE_EVENT_VAL(C, FH_RELEASE, numreqs);
 
-	FH_TABLE_LOCK;
+	if_pt (FH_FAST_ENTER()) {
+		for (i = 0; i < numreqs; i++) {
+			firehose_request_t *req = (firehose_request_t *) reqs[i];
 
-	for (i = 0; i < numreqs; i++) {
-		gasneti_assert(!(reqs[i]->flags & FH_FLAG_PENDING));
+			gasneti_assert(!(req->flags & (FH_FLAG_PENDING | FH_FLAG_RELEASED)));
+			if (fh_fast_release_region(req)) {
+				req->flags |= FH_FLAG_RELEASED;
+				remain--;
+			}
+		}
+		FH_FAST_EXIT();
+	}
 
-		if (reqs[i]->node == gasneti_mynode)
-			fh_release_local_region(
-				(firehose_request_t *) reqs[i]);
-		else
-			fh_release_remote_region(
-				(firehose_request_t *) reqs[i]);
+	if (remain) {
+		FH_TABLE_LOCK;
 
-		if (reqs[i]->flags & FH_FLAG_FHREQ)
-			fh_request_free((firehose_request_t *) reqs[i]);
+		for (i = 0; i < numreqs; i++) {
+			firehose_request_t *req = (firehose_request_t *) reqs[i];
+
+			gasneti_assert(!(req->flags & FH_FLAG_PENDING));
+			if (req->flags & FH_FLAG_RELEASED)
+				continue;
+
+			if (req->node == gasneti_mynode) {
+				fh_release_local_region(req);
+				local = 1;
+			}
+			else
+				fh_release_remote_region(req);
+		}
+
+		if (local)
+			fh_AdjustLocalFifoAndPin(gasneti_mynode, NULL, 0);
+
+		FH_TABLE_UNLOCK;
 	}
 
-	FH_TABLE_UNLOCK;
+	for (i = 0; i < numreqs; i++) {
+		firehose_request_t *req = (firehose_request_t *) reqs[i];
+
+		req->flags &= ~FH_FLAG_RELEASED;
+		if (req->flags & FH_FLAG_FHREQ)
+			fh_request_free(req);
+	}
 
 	return;
 }
@@ -583,13 +832,15 @@ fh_free_completion_callback(fh_completion_callback_t *cc)
  * pointer is used to link the request_t.
  */
 
+/* Callers passing block=1 must hold the table lock, which is dropped while
+ * polling for a request_t to be freed.  With block=0 the table lock is
+ * optional.
+ */
 static firehose_request_t *
 fh_request_new(firehose_request_t *ureq, int block)
 {
 	firehose_request_t	*req;
 
-	FH_TABLE_ASSERT_LOCKED;
-
 	if_pt (ureq != NULL) {
 		req = ureq;
 		req->flags = 0;
@@ -597,6 +848,8 @@ fh_request_new(firehose_request_t *ureq, int block)
 		return req;
 	}
 
+	gasneti_mutex_lock(&fh_request_lock);
+
 	if_pt (fh_request_freehead != NULL) {
 		req = fh_request_freehead;
 		fh_request_freehead = (firehose_request_t *) req->internal;
@@ -609,13 +862,18 @@ fh_request_new(firehose_request_t *ureq, int block)
 		/* If !block we cannot poll even once because calls to
 		 * fh_commit_*() could break if we release the lock here.
 		 */
-		if (!block)
+		if (!block) {
+			gasneti_mutex_unlock(&fh_request_lock);
 			return NULL;
+		}
 
+		FH_TABLE_ASSERT_LOCKED;
 		do {
+			gasneti_mutex_unlock(&fh_request_lock);
 			FH_TABLE_UNLOCK;
 			FIREHOSE_AMPOLL();
 			FH_TABLE_LOCK;
+			gasneti_mutex_lock(&fh_request_lock);
 		} while (fh_request_freehead == NULL);
 		req = fh_request_freehead;
 		fh_request_freehead = (firehose_request_t *) req->internal;
@@ -647,6 +905,8 @@ fh_request_new(firehose_request_t *ureq, int block)
 		fh_request_freehead = &buf[1];
 	}
 
+	gasneti_mutex_unlock(&fh_request_lock);
+
 	req->flags = FH_FLAG_FHREQ;
 	req->internal = NULL;
 			    
@@ -659,9 +919,10 @@ fh_request_free(firehose_request_t *req)
 	/* Firehose allocated request, not pending */
 	gasneti_assert((req->flags & (FH_FLAG_FHREQ | FH_FLAG_PENDING)) == FH_FLAG_FHREQ);
 
-	/* XXX: could use a distinct lock here */
+	gasneti_mutex_lock(&fh_request_lock);
 	req->internal = (firehose_private_t *) fh_request_freehead;
 	fh_request_freehead = req;
+	gasneti_mutex_unlock(&fh_request_lock);
 
 	return;
 }
@@ -919,7 +1180,7 @@ fh_priv_release_local(int local_ref, firehose_private_t *entry)
 	if (rp->refc_r == 0 && rp->refc_l == 0) {
 		/* Have entered state "B" (FIFO) */
 		#ifdef FIREHOSE_REGION
-		if (!entry->visible)
+		if (entry->covered)
 		    FH_TAILQ_INSERT_HEAD(&fh_LocalFifo, entry);
 		else
 		#endif
@@ -964,7 +1225,7 @@ fh_priv_release_remote(gasnet_node_t node, firehose_private_t *entry)
 
 	if (rp->refc_r == 0) {
 		#ifdef FIREHOSE_REGION
-		if (!entry->visible)
+		if (entry->covered)
 		    FH_TAILQ_INSERT_HEAD(&fh_RemoteNodeFifo[node], entry);
 		else
 		#endif
@@ -981,6 +1242,46 @@ fh_priv_release_remote(gasnet_node_t node, firehose_private_t *entry)
 
 	return rp;
 }
+/*
+ * fh_priv_fast_adjust() is the lock-free counterpart of the functions above,
+ * for the case that the bucket is in use both before and after the change.
+ * It adjusts the client's reference count (refc_l for local memory, refc_r
+ * for remote) by 'delta' and returns non-zero on success.  It returns zero,
+ * leaving the bucket untouched, if the change could involve a state
+ * transition (or a change to fhc_LocalOnlyBucketsPinned), in which case the
+ * caller must retry under the table lock.
+ *
+ * Must be called between FH_FAST_ENTER() and FH_FAST_EXIT().
+ */
+int
+fh_priv_fast_adjust(int is_local, firehose_private_t *entry, int delta)
+{
+	fh_refc_word_t	oldval, newval;
+
+	gasneti_assert((delta == 1) || (delta == -1));
+	gasneti_assert(entry != NULL);
+
+	/* fh_tqe_next and the PENDING tags only change under the table lock */
+	if (is_local ? !FH_IS_LOCAL_INUSE(entry) : !FH_IS_REMOTE_INUSE(entry))
+		return 0;
+
+	do {
+		fh_refc_uint_t *cnt;
+
+		oldval.word = *(volatile uintptr_t *)FH_BUCKET_REFC(entry);
+		newval = oldval;
+		cnt = is_local ? &newval.refc.refc_l : &newval.refc.refc_r;
+
+		/* Require the count to be >= 1 before and after the change,
+		 * to avoid any state change */
+		if ((*cnt < 1) || (*cnt + delta < 1))
+			return 0;
+		*cnt += delta;
+	} while (!FH_REFC_WORD_CAS(entry, oldval.word, newval.word));
+
+	return 1;
+}
+
 /*
  * Waiting/Polling for local and remote firehoses
  *
@@ -689,6 +689,72 @@ extern const firehose_request_t *
 firehose_partial_local_pin(uintptr_t addr, size_t len,
                            firehose_request_t *req);
 
+/**************************
+ * firehose_completed_fn_t
+ **************************
+ * Type for function called after firehose placement is acknowledged
+ * on the node initiating the firehose move.
+ *
+ * The callback is never run within an AM handler context unless the
+ * client defines FIREHOSE_COMPLETION_IN_HANDLER in which case the
+ * completion callback will be executed from within the firehose reply
+ * handler.  In either case, the callback must be thread-safe and
+ * firehose makes no guarantees as to what thread the callback is run
+ * on (which means the callback can run a thread different from the
+ * thread that initiated the operation).
+ *
+ * The callback is run with a context pointer passed into one of the
+ * remote pin functions and the request_t describes the remote region
+ * that was successfully pinned.  The 'allLocalHit' parameter is set
+ * to non-zero if the remote pin operation could be successfully
+ * completed without requiring any firehose moves (network roundtrips).
+ * Thus if 'allLocalHit' is non-zero, any callback requested by the flag
+ * FIREHOSE_FLAG_ENABLE_REMOTE_CALLBACK has NOT run on the remote node.
+ *
+ * The same type is used for the completion of local pins deferred by
+ * firehose_local_pin_async(), which are always run from firehose_poll().
+ *
+ * AM-handler context: Runs within AM handler if (and only if) client
+ *                     defines FIREHOSE_COMPLETION_IN_HANDLER.
+ */
+typedef void (*firehose_completed_fn_t)
+	     (void *context, const firehose_request_t *req, int allLocalHit);
+
+/****************************
+ * Firehose Local Async Pin
+ ****************************
+ * Called to request local pinning of a specified region without waiting
+ * for any required pinning to take place.
+ *
+ * If the region is already pinned, a request type is returned exactly
+ * as by firehose_local_pin(), and the callback is not invoked.
+ * Otherwise the return value is NULL and the pinning is deferred to
+ * firehose_poll(), which later invokes the supplied completion callback
+ * with the pinned request.  The 'allLocalHit' argument to the callback
+ * is non-zero if no new pinning was needed by the time the request was
+ * serviced (for instance, a preceding request covered the region).
+ *
+ * Deferred requests are serviced in batches: the pins for all the misses
+ * in a batch, and the unpins of the victims they displace, are made with
+ * a single call to firehose_move_callback().
+ *
+ * A deferred request is owned by firehose until the callback runs, and
+ * must not be passed to firehose_release() before then.
+ *
+ * In configurations without firehose_poll() (both
+ * FIREHOSE_COMPLETION_IN_HANDLER and FIREHOSE_REMOTE_CALLBACK_IN_HANDLER
+ * defined), this call is equivalent to firehose_local_pin().
+ *
+ * See the section "FIREHOSE PINNING FUNCTIONS (LOCAL & REMOTE)" for the
+ * use of the "req" argument, and additional semantics common to all
+ * firehose_*_pin() functions.
+ *
+ * AM-handler context: Cannot be run in a handler.
+ */
+extern const firehose_request_t *
+firehose_local_pin_async(uintptr_t addr, size_t len, firehose_request_t *req,
+			 firehose_completed_fn_t callback, void *context);
+
 /********************************************************************/
 /* FIREHOSE REMOTE PINNING FUNCTIONS                                */
 /********************************************************************/
@@ -724,34 +790,6 @@ firehose_partial_local_pin(uintptr_t addr, size_t len,
 #define FIREHOSE_FLAG_RETURN_IF_PINNED		0x01
 #define FIREHOSE_FLAG_ENABLE_REMOTE_CALLBACK	0x02
 
-/**************************
- * firehose_completed_fn_t
- **************************
- * Type for function called after firehose placement is acknowledged
- * on the node initiating the firehose move.
- *
- * The callback is never run within an AM handler context unless the
- * client defines FIREHOSE_COMPLETION_IN_HANDLER in which case the
- * completion callback will be executed from within the firehose reply
- * handler.  In either case, the callback must be thread-safe and
- * firehose makes no guarantees as to what thread the callback is run
- * on (which means the callback can run a thread different from the
- * thread that initiated the operation).
- *
- * The callback is run with a context pointer passed into one of the
- * remote pin functions and the request_t describes the remote region
- * that was successfully pinned.  The 'allLocalHit' parameter is set
- * to non-zero if the remote pin operation could be successfully
- * completed without requiring any firehose moves (network roundtrips).
- * Thus if 'allLocalHit' is non-zero, any callback requested by the flag
- * FIREHOSE_FLAG_ENABLE_REMOTE_CALLBACK has NOT run on the remote node.
- *
- * AM-handler context: Runs within AM handler if (and only if) client
- *                     defines FIREHOSE_COMPLETION_IN_HANDLER.
- */
-typedef void (*firehose_completed_fn_t)
-	     (void *context, const firehose_request_t *req, int allLocalHit);
-
 /***********************************
  * firehose_remotecallback_args_fn_t
  ***********************************
@@ -35,6 +35,13 @@
 #define FH_POLL_NOOP
 #endif
 
+/* Maximum number of local pins deferred by firehose_local_pin_async() which
+ * firehose_poll() will service with a single firehose_move_callback().
+ */
+#ifndef FH_MAX_PIN_BATCH
+#define FH_MAX_PIN_BATCH	16
+#endif
+
 /* If unspecified in the firehose_fwd.h, we default to using gasneti_AMPoll().
  */
 #ifndef FIREHOSE_AMPOLL
@@ -57,7 +64,56 @@ extern int fh_verbose;
 
 extern gasneti_mutex_t		fh_table_lock;
 
+/*
+ * Lock-free hit path
+ *
+ * A pin which hits a region already in use, or a release which leaves it in
+ * use, only changes a reference count.  Such operations run between
+ * FH_FAST_ENTER() and FH_FAST_EXIT() instead of taking fh_table_lock, and
+ * announce themselves in one of FH_FAST_STRIPES per-thread counters.
+ * FH_TABLE_LOCK raises fh_table_busy and then waits for those counters to
+ * drain, while FH_FAST_ENTER() fails (sending the caller to the locked path)
+ * if it finds fh_table_busy raised.  So the holder of the table lock still has
+ * exclusive access to everything, and the fast paths need only agree among
+ * themselves, by compare-and-swap on the refcount word (see fh_refc_word_t).
+ */
+#if FIREHOSE_SMP
+  #ifndef FH_FAST_STRIPES
+  #define FH_FAST_STRIPES	8
+  #endif
+
+  typedef struct {
+	gasneti_atomic_t	count;
+	char			_pad[GASNETI_CACHE_PAD(sizeof(gasneti_atomic_t))];
+  } fh_fast_stripe_t;
+
+  extern gasneti_atomic_t	fh_table_busy;
+  extern fh_fast_stripe_t	fh_fast_stripes[FH_FAST_STRIPES];
+  extern gasneti_atomic_t	*fh_fast_enter(void);
+
+  #define FH_FAST_DECL		gasneti_atomic_t *_fh_fast_count
+  #define FH_FAST_ENTER()	(NULL != (_fh_fast_count = fh_fast_enter()))
+  #define FH_FAST_EXIT()	gasneti_atomic_decrement(_fh_fast_count, GASNETI_ATOMIC_REL)
+
+  #define FH_TABLE_EXCLUDE_FAST	do { int _i;                                            \
+				     gasneti_atomic_set(&fh_table_busy, 1,             \
+							GASNETI_ATOMIC_MB_POST);       \
+				     for (_i = 0; _i < FH_FAST_STRIPES; ++_i)          \
+				       gasneti_waitwhile(gasneti_atomic_read(          \
+						   &fh_fast_stripes[_i].count, 0));    \
+				} while (0)
+  #define FH_TABLE_ADMIT_FAST	gasneti_atomic_set(&fh_table_busy, 0, GASNETI_ATOMIC_REL)
+#else
+  /* Without concurrent client threads there is nobody to exclude */
+  #define FH_FAST_DECL		int _fh_fast_unused = 1
+  #define FH_FAST_ENTER()	(_fh_fast_unused)
+  #define FH_FAST_EXIT()	((void)0)
+  #define FH_TABLE_EXCLUDE_FAST	((void)0)
+  #define FH_TABLE_ADMIT_FAST	((void)0)
+#endif
+
 #define FH_TABLE_LOCK		do { gasneti_mutex_lock(&fh_table_lock);               \
+				     FH_TABLE_EXCLUDE_FAST;                            \
 				     gasneti_compiler_fence();                         \
 				     gasneti_assert(FHC_MAXVICTIM_BUCKETS_AVAIL >= 0); \
 				     fhi_debug_local_table();                          \
@@ -65,8 +121,15 @@ extern gasneti_mutex_t		fh_table_lock;
 #define FH_TABLE_UNLOCK		do { gasneti_assert(FHC_MAXVICTIM_BUCKETS_AVAIL >= 0); \
 				     fhi_debug_local_table();                          \
 				     gasneti_compiler_fence();                         \
+				     FH_TABLE_ADMIT_FAST;                              \
 				     gasneti_mutex_unlock(&fh_table_lock);             \
 				} while (0)
+/* Condition variable waits release the table lock, so must also readmit
+ * the fast paths for the duration */
+#define FH_TABLE_COND_WAIT(cv)	do { FH_TABLE_ADMIT_FAST;                              \
+				     gasneti_cond_wait((cv), &fh_table_lock);          \
+				     FH_TABLE_EXCLUDE_FAST;                            \
+				} while (0)
 #define FH_TABLE_ASSERT_LOCKED	gasneti_mutex_assertlocked(&fh_table_lock)
 #define FH_TABLE_ASSERT_UNLOCKED gasneti_mutex_assertunlocked(&fh_table_lock)
 
@@ -230,8 +293,6 @@ fh_refc_t;
   #define FH_BSTATE_SET(entry, state)
 #endif
 
-struct _fh_bucket_t; /* forward decl of type */
-
 struct _firehose_private_t {
         fh_key_t         fh_key;                 /* cached key for hash table */
 
@@ -256,8 +317,14 @@ struct _firehose_private_t {
 	/* Region-specific additional fields: */
 	#ifdef FIREHOSE_REGION
 	size_t			len;
-	struct _fh_bucket_t	*bucket;	/* pointer to first bucket */
-	int			visible;
+	gasnet_node_t		node;		/* FH_NODE() is not usable */
+	int			covered;	/* # of regions containing us */
+
+	/* per-node interval tree, see firehose_region.c */
+	firehose_private_t	*fh_tree_left;
+	firehose_private_t	*fh_tree_right;
+	firehose_private_t	*fh_tree_best;	/* greatest end in subtree */
+	int			fh_tree_height;
 
 	#ifdef FIREHOSE_CLIENT_T
 	firehose_client_t	client;
@@ -267,6 +334,19 @@ struct _firehose_private_t {
 
 #define FH_BUCKET_REFC(priv) (&(priv)->u.fh_refc)
 
+/* The lock-free paths treat the refcount pair as a single word */
+typedef union {
+	fh_refc_t	refc;
+	uintptr_t	word;
+} fh_refc_word_t;
+#if PLATFORM_ARCH_32
+  #define FH_REFC_WORD_CAS(priv,oldval,newval) \
+	gasneti_atomic32_compare_and_swap((gasneti_atomic32_t *)FH_BUCKET_REFC(priv),(oldval),(newval),0)
+#else
+  #define FH_REFC_WORD_CAS(priv,oldval,newval) \
+	gasneti_atomic64_compare_and_swap((gasneti_atomic64_t *)FH_BUCKET_REFC(priv),(oldval),(newval),0)
+#endif
+
 /* Local and Remote buckets can be in various states.
  *
  * Local buckets can be in either of these two states:
@@ -354,8 +434,9 @@ void	fh_fini_plugin(void);
 /* Flags */
 #define FH_FLAG_FHREQ	 0x01	/* firehose supplied the request_t */
 #define FH_FLAG_PINNED	 0x02
-#define FH_FLAG_PENDING  0x04	/* Used in -PAGE only */
+#define FH_FLAG_PENDING  0x04	/* Waiting on a move or a deferred local pin */
 #define FH_FLAG_INFLIGHT 0x08
+#define FH_FLAG_RELEASED 0x10	/* Released by the lock-free path */
 
 /* ##################################################################### */
 /* Firehose Hash Table Utility (COMMON, firehose_hash.c)                 */
@@ -389,6 +470,9 @@ fh_refc_t *	fh_priv_acquire_local(int local_ref,
 				      firehose_private_t *);
 fh_refc_t *	fh_priv_acquire_remote(gasnet_node_t node,
 				       firehose_private_t *);
+		/* Lock-free refcount adjustment of an in-use private_t */
+int		fh_priv_fast_adjust(int is_local, firehose_private_t *,
+				    int delta);
 		/* Wait for local firehoses to release/reuse */
 int		fh_WaitLocalFirehoses(int count, firehose_region_t *region);
 		/* Wait for remote firehoses to release/reuse */
@@ -625,6 +709,10 @@ void	fh_free_completion_callback(fh_completion_callback_t *rc);
 /* ##################################################################### */
 /* See documentation in firehose_page.c                                  */
 void	fh_acquire_local_region(firehose_request_t *);
+/* Acquire some leading part of a batch of deferred local pins (at least one)
+ * Returns the number acquired, setting localhit[i] for those not pinned anew
+ */
+int	fh_acquire_local_batch(firehose_request_t **reqs, int *localhit, int num);
 void	fh_commit_try_local_region(firehose_request_t *);
 void	fh_release_local_region(firehose_request_t *);
 
@@ -634,6 +722,9 @@ void	fh_acquire_remote_region(firehose_request_t *req,
 		        	firehose_remotecallback_args_fn_t args_fn);
 void	fh_commit_try_remote_region(firehose_request_t *);
 void	fh_release_remote_region(firehose_request_t *);
+/* Lock-free hit and release; return zero if the table lock is needed */
+int	fh_fast_acquire_region(firehose_request_t *);
+int	fh_fast_release_region(firehose_request_t *);
 int	fh_move_request(gasnet_node_t node,
 			firehose_region_t *new_reg, size_t r_new,
 			firehose_region_t *old_reg, size_t r_old,
@@ -734,13 +825,10 @@ int fhi_FreeVictimRemote(gasnet_node_t node, int count, firehose_region_t *reg)
 
 #if GASNET_TRACE
 #ifdef FIREHOSE_REGION
-  /* Total hack:
-   * FH_NODE(priv) doesn't work in firehose-region because the
+  /* FH_NODE(priv) doesn't work in firehose-region because the
    * "private_t" doesn't have the node info in the "key" field.
-   * This hack lets us grab the info from the "key" field of the first
-   * bucket w/o exposing the bucket_t outside of firehose_region.c
    */
-  #define FH_PRIV_NODE(p) ((p)->bucket ? FH_NODE((p)->bucket) : -1)
+  #define FH_PRIV_NODE(p) ((p)->node)
 #else
   #define FH_PRIV_NODE(p) FH_NODE(p)
 #endif
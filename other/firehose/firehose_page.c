@@ -423,12 +423,42 @@ fh_release_local_region(firehose_request_t *request)
 	b_total = FH_NUM_BUCKETS(request->addr, request->len);
 	FH_COPY_REQUEST_TO_REGION(&reg, request);
 
+	/* Caller (firehose_release) trims the FIFO once for all requests */
 	fhi_ReleaseLocalRegionsList(1, &reg, 1);
-	fh_AdjustLocalFifoAndPin(gasneti_mynode, NULL, 0);
 
 	return;
 }
 
+/* -page already coalesces the pins within a request, so deferred local
+ * pins are simply acquired one by one */
+int
+fh_acquire_local_batch(firehose_request_t **reqs, int *localhit, int num)
+{
+	int i;
+
+	FH_TABLE_ASSERT_LOCKED;
+
+	for (i = 0; i < num; i++) {
+		fh_acquire_local_region(reqs[i]);
+		localhit[i] = 0;
+	}
+
+	return num;
+}
+
+/* -page has no lock-free path, since a request can span many buckets */
+int
+fh_fast_acquire_region(firehose_request_t *req)
+{
+	return 0;
+}
+
+int
+fh_fast_release_region(firehose_request_t *req)
+{
+	return 0;
+}
+
 /*
  * fh_FreeVictim(count, region_array, head)
  *
@@ -2153,7 +2183,7 @@ again:
     if_pf (fh_local_da) {
 	/* Someone else owns fhi_local_da, wait for them to finish */
 	do {
-	    gasneti_cond_wait(&fh_local_da_cv, &fh_table_lock);
+	    FH_TABLE_COND_WAIT(&fh_local_da_cv);
 	} while (fh_local_da);	/* loop until we win the race */
     }
     else if_pf (outer_count > outer_limit) {
@@ -2277,7 +2307,7 @@ again:
 	fhsmp_LocalRollback(pin_p, NULL, NULL, 0, 0);
         fhi_FreeRegionPool(pin_p);
 	pin_p = NULL;
-        gasneti_cond_wait(&inflight_condvar, &fh_table_lock);
+        FH_TABLE_COND_WAIT(&inflight_condvar);
         goto again; /* will recheck for (fh_local_da != 0) */
     }
 
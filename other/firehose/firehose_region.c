@@ -12,19 +12,6 @@
 
 #include <firehose_hash.c> /* For possible inlining */
 
-typedef
-struct _fh_bucket_t {
-        fh_key_t         fh_key;	/* cached key for hash table */
-        void            *fh_next;	/* linked list in hash table */
-					/* _must_ be in this order */
-
-        /* pointer to the containing region.  holds ref counts, etc */
-        firehose_private_t      *priv;
-        /* pointer to next bucket in same region */
-        struct _fh_bucket_t     *next;
-}
-fh_bucket_t;
-
 /* IFF firehose_fwd.h DID set these, complain now */
 #ifdef FIREHOSE_CLIENT_MAXREGION_SIZE
   #error "Conduits should no longer define FIREHOSE_CLIENT_MAXREGION_SIZE in firehose_fwd.h"
@@ -124,81 +111,261 @@ uintptr_t fh_priv_end(const firehose_private_t *priv)
 	return (FH_BADDR(priv) + (priv->len - 1));
 }
 
-/* compute ending address of "bucket" */
-GASNETI_INLINE(fh_bucket_end)
-uintptr_t fh_bucket_end(const fh_bucket_t *bucket)
-{
-	gasneti_assert(bucket != NULL);
-	return fh_priv_end(bucket->priv);
-}
-
-/* Compare two buckets with the same (node, address)
+/* Compare two regions
  * return non-zero if first is best
  * "best" is the one with the greatest forward extent.
  * In case of a tie on forward extent, the longer region wins.
  * In case of a complete tie, we return 0.
  */
-GASNETI_INLINE(fh_bucket_is_better)
-int fh_bucket_is_better(const fh_bucket_t *a, const fh_bucket_t *b)
+GASNETI_INLINE(fh_priv_is_better)
+int fh_priv_is_better(const firehose_private_t *a, const firehose_private_t *b)
 {
   uintptr_t end_a, end_b;
 
   gasneti_assert(a != NULL);
-  gasneti_assert(a->priv != NULL);
   gasneti_assert(b != NULL);
-  gasneti_assert(b->priv != NULL);
-  gasneti_assert(FH_KEY_EQ(a->fh_key, b->fh_key));
 
-  end_a = fh_bucket_end(a);
-  end_b = fh_bucket_end(b);
+  end_a = fh_priv_end(a);
+  end_b = fh_priv_end(b);
 
   if_pt (end_a != end_b) {
     return (end_a > end_b);
   }
   else {
-    return (a->priv->len > b->priv->len);
+    return (a->len > b->len);
   }
 }
 
-/* Compare two buckets with the same (node, address) to pick the "best" one */
-GASNETI_INLINE(fh_best_bucket)
-fh_bucket_t *fh_best_bucket(fh_bucket_t *a, fh_bucket_t *b)
+/* Return non-zero if region 'a' strictly contains region 'b' */
+GASNETI_INLINE(fh_priv_covers)
+int fh_priv_covers(const firehose_private_t *a, const firehose_private_t *b)
 {
-  return (fh_bucket_is_better(a,b)) ? a : b;
+  return ((FH_BADDR(a) <= FH_BADDR(b)) &&
+	  (fh_priv_end(a) >= fh_priv_end(b)) &&
+	  (a->len > b->len));
 }
 
 /* ##################################################################### */
-/* BUCKET TABLE HANDLING                                                 */
+/* REGION TREE HANDLING                                                  */
 /* ##################################################################### */
 
-/* "Best" matches for each bucket go in the first ("best") hash table (1).
- * Any others go (unsorted) in the second ("other") hash table (2).
+/* The regions of each node are kept in an AVL tree ordered by starting
+ * address, in which each tree node also records the "best" region in its
+ * subtree.  That makes it an interval tree: the best region containing a
+ * given address is the best of those starting at or below the address, if
+ * that one reaches the address at all.  So lookup, insertion and removal
+ * are O(log n) in the number of regions, independent of their length.
  *
- * Lookup only needs to consult the "best" list.
- * Insertion may involve bumping an entry from "best" to "other".
- * Deletion may involve promoting an entry from "other" to "best".
- * Only the deletion requires comparisions in the "other" list and
- * then only if we are deleting what is otherwise our best match.
+ * A region strictly contained in another will never be returned by a
+ * lookup.  We count the regions "covering" each region, so that covered
+ * regions can be recycled early from the FIFO.
+ */
+static firehose_private_t **fh_RegionTree;	/* one root per node */
+
+#define FH_TREE_HEIGHT(P)	((P) ? (P)->fh_tree_height : 0)
+
+/* Total order on regions: start address, then length, then identity */
+GASNETI_INLINE(fh_tree_cmp)
+int fh_tree_cmp(const firehose_private_t *a, const firehose_private_t *b)
+{
+    const uintptr_t start_a = FH_BADDR(a);
+    const uintptr_t start_b = FH_BADDR(b);
+
+    if (start_a != start_b)
+	return (start_a < start_b) ? -1 : 1;
+    if (a->len != b->len)
+	return (a->len < b->len) ? -1 : 1;
+    if (a != b)
+	return ((uintptr_t)a < (uintptr_t)b) ? -1 : 1;
+    return 0;
+}
+
+/* Recompute height and best region of a subtree from its children */
+GASNETI_INLINE(fh_tree_update)
+void fh_tree_update(firehose_private_t *p)
+{
+    firehose_private_t *left  = p->fh_tree_left;
+    firehose_private_t *right = p->fh_tree_right;
+    firehose_private_t *best  = p;
+    const int h_left  = FH_TREE_HEIGHT(left);
+    const int h_right = FH_TREE_HEIGHT(right);
+
+    if (left && fh_priv_is_better(left->fh_tree_best, best))
+	best = left->fh_tree_best;
+    if (right && fh_priv_is_better(right->fh_tree_best, best))
+	best = right->fh_tree_best;
+
+    p->fh_tree_best = best;
+    p->fh_tree_height = 1 + MAX(h_left, h_right);
+}
+
+static firehose_private_t *
+fh_tree_rotate_right(firehose_private_t *p)
+{
+    firehose_private_t *left = p->fh_tree_left;
+
+    p->fh_tree_left = left->fh_tree_right;
+    left->fh_tree_right = p;
+    fh_tree_update(p);
+    fh_tree_update(left);
+
+    return left;
+}
+
+static firehose_private_t *
+fh_tree_rotate_left(firehose_private_t *p)
+{
+    firehose_private_t *right = p->fh_tree_right;
+
+    p->fh_tree_right = right->fh_tree_left;
+    right->fh_tree_left = p;
+    fh_tree_update(p);
+    fh_tree_update(right);
+
+    return right;
+}
+
+static firehose_private_t *
+fh_tree_balance(firehose_private_t *p)
+{
+    const int balance = FH_TREE_HEIGHT(p->fh_tree_left) -
+			FH_TREE_HEIGHT(p->fh_tree_right);
+
+    if (balance > 1) {
+	firehose_private_t *left = p->fh_tree_left;
+	if (FH_TREE_HEIGHT(left->fh_tree_left) < FH_TREE_HEIGHT(left->fh_tree_right))
+	    p->fh_tree_left = fh_tree_rotate_left(left);
+	return fh_tree_rotate_right(p);
+    }
+    else if (balance < -1) {
+	firehose_private_t *right = p->fh_tree_right;
+	if (FH_TREE_HEIGHT(right->fh_tree_right) < FH_TREE_HEIGHT(right->fh_tree_left))
+	    p->fh_tree_right = fh_tree_rotate_right(right);
+	return fh_tree_rotate_left(p);
+    }
+
+    fh_tree_update(p);
+    return p;
+}
+
+static firehose_private_t *
+fh_tree_insert(firehose_private_t *root, firehose_private_t *priv)
+{
+    if (root == NULL) {
+	priv->fh_tree_left = priv->fh_tree_right = NULL;
+	fh_tree_update(priv);
+	return priv;
+    }
+
+    if (fh_tree_cmp(priv, root) < 0)
+	root->fh_tree_left = fh_tree_insert(root->fh_tree_left, priv);
+    else
+	root->fh_tree_right = fh_tree_insert(root->fh_tree_right, priv);
+
+    return fh_tree_balance(root);
+}
+
+static firehose_private_t *
+fh_tree_remove_min(firehose_private_t *root, firehose_private_t **min_p)
+{
+    if (root->fh_tree_left == NULL) {
+	*min_p = root;
+	return root->fh_tree_right;
+    }
+
+    root->fh_tree_left = fh_tree_remove_min(root->fh_tree_left, min_p);
+
+    return fh_tree_balance(root);
+}
+
+static firehose_private_t *
+fh_tree_remove(firehose_private_t *root, firehose_private_t *priv)
+{
+    int cmp;
+
+    gasneti_assert(root != NULL);
+
+    cmp = fh_tree_cmp(priv, root);
+    if (cmp < 0) {
+	root->fh_tree_left = fh_tree_remove(root->fh_tree_left, priv);
+    }
+    else if (cmp > 0) {
+	root->fh_tree_right = fh_tree_remove(root->fh_tree_right, priv);
+    }
+    else {
+	firehose_private_t *left = root->fh_tree_left;
+	firehose_private_t *right = root->fh_tree_right;
+	firehose_private_t *min;
+
+	if (right == NULL)
+	    return left;
+
+	right = fh_tree_remove_min(right, &min);
+	min->fh_tree_left = left;
+	min->fh_tree_right = right;
+	return fh_tree_balance(min);
+    }
+
+    return fh_tree_balance(root);
+}
+
+/* Return the best region of 'node' containing 'addr', or NULL if none.
+ * Doesn't assert the table lock, since fh_fast_acquire_region() uses it.
  */
-fh_hash_t *fh_BucketTable1;
-fh_hash_t *fh_BucketTable2;
+GASNETI_INLINE(fh_tree_lookup)
+firehose_private_t *
+fh_tree_lookup(gasnet_node_t node, uintptr_t addr)
+{
+    firehose_private_t *p = fh_RegionTree[node];
+    firehose_private_t *best = NULL;
+
+    /* Subtrees whose best region ends below addr cannot contain it */
+    while ((p != NULL) && (fh_priv_end(p->fh_tree_best) >= addr)) {
+	if (FH_BADDR(p) <= addr) {
+	    /* p and its entire left subtree start at or below addr, so the
+	     * best of them contains addr if it ends at or above it */
+	    firehose_private_t *left = p->fh_tree_left;
+	    if ((fh_priv_end(p) >= addr) && (!best || fh_priv_is_better(p, best)))
+		best = p;
+	    if (left && (fh_priv_end(left->fh_tree_best) >= addr) &&
+		(!best || fh_priv_is_better(left->fh_tree_best, best)))
+		best = left->fh_tree_best;
+	    p = p->fh_tree_right;
+	    if (p && best && !fh_priv_is_better(p->fh_tree_best, best))
+		break;	/* nothing to the right can do better */
+	}
+	else {
+	    p = p->fh_tree_left;
+	}
+    }
+
+    return best;
+}
 
+/* Count the regions in the subtree which strictly contain 'priv' */
+static int
+fh_tree_count_covering(const firehose_private_t *p, const firehose_private_t *priv)
+{
+    if ((p == NULL) || (fh_priv_end(p->fh_tree_best) < fh_priv_end(priv)))
+	return 0;	/* nothing here reaches far enough */
+
+    if (FH_BADDR(p) > FH_BADDR(priv))
+	return fh_tree_count_covering(p->fh_tree_left, priv);
 
-#define fh_bucket_uncover(B)	do { ((B)->priv)->visible += 1; } while(0)
-#define fh_bucket_cover(B)	do { ((B)->priv)->visible -= 1; } while(0)
+    return fh_priv_covers(p, priv) +
+	   fh_tree_count_covering(p->fh_tree_left, priv) +
+	   fh_tree_count_covering(p->fh_tree_right, priv);
+}
 
 #ifdef FH_CLEAN_COVERED_AGGRESSIVE
   /* Since we search full FIFO there is no need to move covered to head */
-  #define fh_bucket_cover_and_check(B) fh_bucket_cover(B)
+  #define fh_priv_cover_check(P) ((void)0)
 #else
-GASNETI_INLINE(fh_bucket_cover_and_check)
-void fh_bucket_cover_and_check(fh_bucket_t *bucket)
+GASNETI_INLINE(fh_priv_cover_check)
+void fh_priv_cover_check(firehose_private_t *priv)
 {
-  firehose_private_t *priv = bucket->priv;
-  fh_bucket_cover(bucket);
-  if (priv->visible == 0) {
     fh_fifoq_t *fifo_head = NULL;
-    gasnet_node_t node = FH_NODE(bucket);
+    gasnet_node_t node = priv->node;
     if (node == gasneti_mynode) {
       if (FH_IS_LOCAL_FIFO(priv)) {
 	fifo_head = &fh_LocalFifo;
@@ -216,152 +383,105 @@ void fh_bucket_cover_and_check(fh_bucket_t *bucket)
     } else {
       /* Not yet in FIFO */
     }
-  }
 }
 #endif
 
-static fh_bucket_t
-*fh_bucket_lookup(gasnet_node_t node, uintptr_t addr)
+/* Adjust the 'covered' count of the regions in the subtree which are
+ * strictly contained in 'priv' */
+static void
+fh_tree_cover_within(firehose_private_t *p, const firehose_private_t *priv, int delta)
 {
-        FH_TABLE_ASSERT_LOCKED;
+    if (p == NULL)
+	return;
 
-        FH_ASSERT_BUCKET_ADDR(addr);
+    if (FH_BADDR(p) >= FH_BADDR(priv))
+	fh_tree_cover_within(p->fh_tree_left, priv, delta);
 
-        /* Only ever need to lookup in the first table */
-        return (fh_bucket_t *)
-		fh_hash_find(fh_BucketTable1, FH_KEYMAKE(addr, node));
+    if (FH_BADDR(p) <= fh_priv_end(priv)) {
+	if (fh_priv_covers(priv, p)) {
+	    p->covered += delta;
+	    gasneti_assert(p->covered >= 0);
+	    if ((delta > 0) && (p->covered == 1))
+		fh_priv_cover_check(p);
+	}
+	fh_tree_cover_within(p->fh_tree_right, priv, delta);
+    }
 }
 
+/* Find the READY region overlapping [start_addr, end_addr] which covers the
+ * lowest address in that range, preferring the best in case of a tie */
 static void
-fh_bucket_hash(fh_bucket_t *bucket, fh_key_t key)
+fh_tree_find_partial(firehose_private_t *p, int is_local,
+		     uintptr_t start_addr, uintptr_t end_addr,
+		     firehose_private_t **found_p)
 {
-	fh_bucket_t *other;
-	fh_hash_t *hash;
+    if ((p == NULL) || (fh_priv_end(p->fh_tree_best) < start_addr))
+	return;	/* nothing here reaches the range */
 
-        FH_TABLE_ASSERT_LOCKED;
-	gasneti_assert(bucket != NULL);
-
-	bucket->fh_key = key;
-	hash = fh_BucketTable1;
-
-	/* check for existing entry, resolving conflict if any */
-	other = (fh_bucket_t *)fh_hash_find(fh_BucketTable1, key);
-	if_pf (other != NULL) {
-		/* resolve conflict */
-		if (fh_bucket_is_better(bucket, other)) {
-			fh_hash_replace(fh_BucketTable1, other, bucket);
-			fh_bucket_uncover(bucket);
-			fh_bucket_cover_and_check(other);
-			bucket = other;
-		}
-		hash = fh_BucketTable2;
+    fh_tree_find_partial(p->fh_tree_left, is_local, start_addr, end_addr, found_p);
+
+    if (FH_BADDR(p) > end_addr)
+	return;
+
+    if ((fh_priv_end(p) >= start_addr) && FH_IS_READY(is_local, p)) {
+	const firehose_private_t *found = *found_p;
+	const uintptr_t p_first = MAX(FH_BADDR(p), start_addr);
+
+	if (!found) {
+	    *found_p = p;
 	} else {
-		fh_bucket_uncover(bucket);
+	    const uintptr_t found_first = MAX(FH_BADDR(found), start_addr);
+	    if ((p_first < found_first) ||
+		((p_first == found_first) && fh_priv_is_better(p, found)))
+		*found_p = p;
 	}
+    }
 
-	fh_hash_insert(hash, key, bucket);
-
-	return;
+    fh_tree_find_partial(p->fh_tree_right, is_local, start_addr, end_addr, found_p);
 }
 
 static void
-fh_bucket_unhash(fh_bucket_t *bucket)
+fh_tree_apply(firehose_private_t *p, void (*fn)(void *, void *), void *arg)
 {
-    fh_key_t key;
-
-    FH_TABLE_ASSERT_LOCKED;
-    gasneti_assert(bucket != NULL);
-
-    key = bucket->fh_key;
-
-    /* check for existence in "best" list */
-    if_pf ((fh_bucket_t *)fh_hash_find(fh_BucketTable1, key) == bucket) {
-        /* found in the "best" list, so must search for a replacement */
-        fh_bucket_t *best = (fh_bucket_t *)fh_hash_find(fh_BucketTable2, key);
-
-        if (best != NULL) {
-	    fh_bucket_t *other = fh_hash_next(fh_BucketTable2, best);
-
-            while (other) {
-                best = fh_best_bucket(other, best);
-                other = fh_hash_next(fh_BucketTable2, other);
-	    }
+    while (p != NULL) {
+	firehose_private_t *right = p->fh_tree_right;
+	fh_tree_apply(p->fh_tree_left, fn, arg);
+	(*fn)(p, arg);
+	p = right;
+    }
+}
 
-	    fh_hash_replace(fh_BucketTable2, best, NULL);
-	    fh_hash_replace(fh_BucketTable1, bucket, best);
-	    fh_bucket_uncover(best);
-	}
-	else {
-	    fh_hash_replace(fh_BucketTable1, bucket, NULL);
-	}
+static firehose_private_t *
+fh_region_lookup(gasnet_node_t node, uintptr_t addr)
+{
+        FH_TABLE_ASSERT_LOCKED;
 
-	fh_bucket_cover(bucket); /* NOT fh_bucket_cover_and_check() which would place in FIFO */
-    }
-    else {
-	fh_hash_replace(fh_BucketTable2, bucket, NULL);
-    }
+        FH_ASSERT_BUCKET_ADDR(addr);
 
-    return;
+        return fh_tree_lookup(node, addr);
 }
 
 static void
-fh_bucket_rehash(fh_bucket_t *bucket)
+fh_region_insert(firehose_private_t *priv)
 {
-    fh_bucket_t *other;
-    fh_key_t key;
+    const gasnet_node_t node = priv->node;
 
     FH_TABLE_ASSERT_LOCKED;
-    gasneti_assert(bucket != NULL);
-
-    key = bucket->fh_key;
-
-    other = (fh_bucket_t *)fh_hash_find(fh_BucketTable1, key);
-    if_pf ((other != bucket) && fh_bucket_is_better(bucket, other)) {
-	/* We've moved up in the world */
-	fh_hash_replace(fh_BucketTable2, bucket, NULL);
-	fh_hash_replace(fh_BucketTable1, other, bucket);
-	fh_hash_insert(fh_BucketTable2, key, other);
-	fh_bucket_uncover(bucket);
-	fh_bucket_cover_and_check(other);
-    }
 
-    return;
+    priv->covered = fh_tree_count_covering(fh_RegionTree[node], priv);
+    fh_tree_cover_within(fh_RegionTree[node], priv, 1);
+    fh_RegionTree[node] = fh_tree_insert(fh_RegionTree[node], priv);
 }
 
-/* XXX: merge freelist w/ page? */
-static fh_bucket_t *fhi_bucket_freelist = NULL;
-
-GASNETI_INLINE(fh_bucket_new)
-fh_bucket_t *fh_bucket_new(void)
+static void
+fh_region_remove(firehose_private_t *priv)
 {
-    fh_bucket_t *bucket = fhi_bucket_freelist;
+    const gasnet_node_t node = priv->node;
 
-    if_pt (bucket != NULL) {
-	fhi_bucket_freelist = bucket->fh_next;
-    }
-    else {
-        /* Allocate a full page of buckets to amortize overheads */
-        const int count = GASNET_PAGESIZE / sizeof(fh_bucket_t);
-        int i;
-        bucket = gasneti_malloc(count * sizeof(fh_bucket_t));
-        gasneti_leak(bucket);
-        for (i = 0; i < count - 1; ++i) {
-            bucket[i].fh_next = &bucket[i+1];
-        }
-        gasneti_assert(count > 1);
-        bucket[count-1].fh_next = NULL;
-        fhi_bucket_freelist = bucket + 1;
-    }
-    memset(bucket, 0, sizeof(fh_bucket_t));
-
-    return bucket;
-}
+    FH_TABLE_ASSERT_LOCKED;
 
-GASNETI_INLINE(fh_bucket_free)
-void fh_bucket_free(fh_bucket_t *bucket)
-{
-    bucket->fh_next = fhi_bucket_freelist;
-    fhi_bucket_freelist = bucket;
+    fh_RegionTree[node] = fh_tree_remove(fh_RegionTree[node], priv);
+    fh_tree_cover_within(fh_RegionTree[node], priv, -1);
 }
 
 GASNETI_INLINE(fh_clean_covered)
@@ -371,7 +491,7 @@ int fh_clean_covered(int limit, firehose_region_t *reg, fh_fifoq_t *fifo_head) {
   FH_TABLE_ASSERT_LOCKED;
   while ((count < limit) && priv) {
     firehose_private_t *next = FH_TAILQ_NEXT(priv);
-    if (!priv->visible) {
+    if (priv->covered) {
       FH_TAILQ_REMOVE(fifo_head, priv);
       CP_PRIV_TO_REG(reg+count, priv);
       FH_TRACE_BUCKET(priv, REMFIFO);
@@ -379,7 +499,7 @@ int fh_clean_covered(int limit, firehose_region_t *reg, fh_fifoq_t *fifo_head) {
       ++count;
     }
 #ifndef FH_CLEAN_COVERED_AGGRESSIVE
-    else break; /* Stop search at first visible region */
+    else break; /* Stop search at first uncovered region */
 #endif
     priv = next;
   }
@@ -452,9 +572,7 @@ static GASNETI_MALLOC
 firehose_private_t *
 fh_create_priv(gasnet_node_t node, const firehose_region_t *reg)
 {
-    uintptr_t end_addr, bucket_addr;
     firehose_private_t *priv;
-    fh_bucket_t **prev;
 
     FH_TABLE_ASSERT_LOCKED;
 
@@ -478,19 +596,8 @@ fh_create_priv(gasnet_node_t node, const firehose_region_t *reg)
     memset(priv, 0, sizeof(firehose_private_t));
 
     CP_REG_TO_PRIV(priv, node, reg);
-
-    end_addr = fh_region_end(reg);
-    prev = &priv->bucket;
-    FH_FOREACH_BUCKET(reg->addr, end_addr, bucket_addr) {
-        fh_bucket_t *bd = fh_bucket_new();
-
-	bd->priv = priv;
-	fh_bucket_hash(bd, FH_KEYMAKE(bucket_addr, node));
-
-	*prev = bd;
-	prev= &bd->next;
-    }
-    *prev = NULL;
+    priv->node = node;
+    fh_region_insert(priv);
 
     /* Hash the priv IFF local*/
     if_pt (node == gasneti_mynode) {
@@ -507,19 +614,9 @@ fh_create_priv(gasnet_node_t node, const firehose_region_t *reg)
 static void
 fh_destroy_priv(firehose_private_t *priv)
 {
-    fh_bucket_t *bucket;
-    gasnet_node_t node;
+    gasnet_node_t node = priv->node;
 
-    /* Unhash & free all the buckets */
-    bucket = priv->bucket;
-    gasneti_assert(bucket != NULL);
-    node = FH_NODE(bucket);
-    do {
-	fh_bucket_t *next = bucket->next;
-        fh_bucket_unhash(bucket);
-	fh_bucket_free(bucket);
-	bucket = next;
-    } while (bucket != NULL);
+    fh_region_remove(priv);
 
     /* Unhash the priv IFF local*/
     if_pt (node == gasneti_mynode) {
@@ -532,18 +629,15 @@ fh_destroy_priv(firehose_private_t *priv)
     fhi_priv_freelist = priv;
 }
 
-/* Given an existing private_t and a region_t, change the necessary hash
- * table entries.
+/* Given an existing private_t and a region_t, move the private_t to
+ * the new location in its region tree.
  */
 static void
 fh_update_priv(firehose_private_t *priv, const firehose_region_t *reg)
 {
-    uintptr_t bucket_addr;
     uintptr_t old_start, new_start;
     uintptr_t old_end, new_end;
-    gasnet_node_t node = FH_NODE(priv);	/* safe because priv is remote */
-    fh_bucket_t *bucket;
-    fh_bucket_t **prev;
+    gasnet_node_t node = priv->node;
 
     FH_TABLE_ASSERT_LOCKED;
 
@@ -557,59 +651,20 @@ fh_update_priv(firehose_private_t *priv, const firehose_region_t *reg)
 	return;		/* nothing else needs to change */
     }
 
-#if 0
-    bucket = fh_bucket_lookup(node, new_start);
-    if (bucket && (fh_bucket_end(bucket) == new_end)) {
-	fprintf(stderr, "%d> exact match %p %p (%d, %p, %dk)\n",
-		gasneti_mynode, bucket->priv, priv, node, (void *)reg->addr, (int)(reg->len)/1024);
-    }
-#endif
+    /* Reposition in the tree, since the key changes */
+    fh_region_remove(priv);
 
     /* updates fh_key, len and client */
     CP_REG_TO_PRIV(priv, node, reg);
 
-    /* Create new hash entries for "prefix" */
-    bucket = priv->bucket;
-    if (new_start < old_start) {
-        prev = &priv->bucket;
-        FH_FOREACH_BUCKET(new_start, old_start-1, bucket_addr) {
-            fh_bucket_t *bd = fh_bucket_new();
-
-	    bd->priv = priv;
-	    fh_bucket_hash(bd, FH_KEYMAKE(bucket_addr, node));
-
-	    *prev = bd;
-	    prev = &bd->next;
-        }
-	*prev = bucket;
-    }
-
-    /* Rehash existing buckets as needed */
-    do {
-	fh_bucket_rehash(bucket);
-	prev = &bucket->next;
-	bucket = bucket->next;
-    } while (bucket != NULL);
-
-    /* Create new hash entries for "suffix" */
-    if (new_end > old_end) {
-	FH_FOREACH_BUCKET(old_end+1, new_end, bucket_addr) {
-            fh_bucket_t *bd = fh_bucket_new();
-
-	    bd->priv = priv;
-	    fh_bucket_hash(bd, FH_KEYMAKE(bucket_addr, node));
-
-	    *prev = bd;
-	    prev= &bd->next;
-        }
-    }
+    fh_region_insert(priv);
 
     return;
 }
 
 /*
  * Looks for opportunities to merge adjacent pinned regions.
- * The hash table is such that any region completely covered by
+ * The region tree is such that any region completely covered by
  * the new region will no longer get any hits.  So, such regions will
  * eventually end up being recycled from the FIFO.
  *
@@ -626,16 +681,16 @@ fhi_merge_regions(firehose_region_t *pin_region)
     size_t	len  = pin_region->len;
     size_t	space_avail = fhi_MaxRegionSize - len;
     size_t	extend;
-    fh_bucket_t *bd;
+    firehose_private_t *priv;
 
     gasneti_assert(len <= fhi_MaxRegionSize);
 
     /* Look to merge w/ successor */
     if (space_avail && GASNETT_PREDICT_TRUE(addr + len != 0) /* avoid wrap around */) {
 	uintptr_t next_addr = addr + len;
-	bd = fh_bucket_lookup(gasneti_mynode, next_addr);
-	if (bd && FH_MAY_MERGE(&bd->priv->client)) {
-	    uintptr_t end_addr = fh_priv_end(bd->priv) + 1;
+	priv = fh_region_lookup(gasneti_mynode, next_addr);
+	if (priv && FH_MAY_MERGE(&priv->client)) {
+	    uintptr_t end_addr = fh_priv_end(priv) + 1;
 	    gasneti_assert(end_addr > next_addr);
 
 	    extend = end_addr - next_addr;
@@ -650,11 +705,8 @@ fhi_merge_regions(firehose_region_t *pin_region)
 
     /* Look to merge w/ predecessor */
     if (space_avail && GASNETT_PREDICT_TRUE(addr != 0) /* avoid wrap around */) {
-	bd = fh_bucket_lookup(gasneti_mynode, addr - FH_BUCKET_SIZE);
-	if (bd && FH_MAY_MERGE(&bd->priv->client)) {
-	    const firehose_private_t *priv = bd->priv;
-
-	    gasneti_assert(priv != NULL);
+	priv = fh_region_lookup(gasneti_mynode, addr - FH_BUCKET_SIZE);
+	if (priv && FH_MAY_MERGE(&priv->client)) {
 	    gasneti_assert(fh_priv_end(priv) >= (addr - 1));
 	    gasneti_assert(fh_priv_end(priv) < (addr + (len - 1)));
 
@@ -771,16 +823,15 @@ GASNETI_INLINE(fhi_find_priv)
 firehose_private_t *
 fhi_find_priv(gasnet_node_t node, uintptr_t addr, size_t len)
 {
-    firehose_private_t *priv = NULL;
-    fh_bucket_t *bd;
+    firehose_private_t *priv;
 		
     FH_TABLE_ASSERT_LOCKED;
 
-    bd = fh_bucket_lookup(node, addr);
+    priv = fh_region_lookup(node, addr);
 
-    if_pt (bd && ((addr + (len - 1)) <= fh_bucket_end(bd))) {
-	/* Firehose HIT */
-	priv = bd->priv;
+    if_pf (priv && ((addr + (len - 1)) > fh_priv_end(priv))) {
+	/* Firehose MISS on the end of the region */
+	priv = NULL;
     }
 
     return priv;
@@ -835,17 +886,17 @@ fh_FreeVictim(int count, firehose_region_t *reg, fh_fifoq_t *fifo_head)
 int
 fh_region_ispinned(gasnet_node_t node, uintptr_t addr, size_t len)
 {
-    fh_bucket_t *bd;
+    firehose_private_t *priv;
     int retval = 0;
 
     FH_TABLE_ASSERT_LOCKED;
 
-    bd = fh_bucket_lookup(node, addr);
+    priv = fh_region_lookup(node, addr);
 
-    if_pt (bd &&
-	   FH_IS_READY(node == gasneti_mynode, bd->priv) &&
-	   ((addr + (len - 1)) <= fh_bucket_end(bd))) {
-	fhi_lookup_cache = bd->priv;
+    if_pt (priv &&
+	   FH_IS_READY(node == gasneti_mynode, priv) &&
+	   ((addr + (len - 1)) <= fh_priv_end(priv))) {
+	fhi_lookup_cache = priv;
 	retval = 1;
     }
 
@@ -859,7 +910,8 @@ fh_region_ispinned(gasnet_node_t node, uintptr_t addr, size_t len)
 int
 fh_region_partial(gasnet_node_t node, uintptr_t *addr_p, size_t *len_p)
 {
-    uintptr_t start_addr, end_addr, bucket_addr;
+    uintptr_t start_addr, end_addr;
+    firehose_private_t *priv = NULL;
     int is_local = (node == gasneti_mynode);
     int retval = 0;
 
@@ -868,16 +920,13 @@ fh_region_partial(gasnet_node_t node, uintptr_t *addr_p, size_t *len_p)
     start_addr = *addr_p;
     end_addr = start_addr + (*len_p - 1);
 
-    FH_FOREACH_BUCKET(start_addr, end_addr, bucket_addr) {
-        fh_bucket_t *bd = fh_bucket_lookup(node, bucket_addr);
+    fh_tree_find_partial(fh_RegionTree[node], is_local, start_addr, end_addr, &priv);
 
-	if (bd && FH_IS_READY(is_local, bd->priv)) {
-	    *addr_p = FH_BADDR(bd->priv);
-	    *len_p  = bd->priv->len;
-	    fhi_lookup_cache = bd->priv;
-	    retval = 1;
-	    break;
-	}
+    if (priv) {
+	*addr_p = FH_BADDR(priv);
+	*len_p  = priv->len;
+	fhi_lookup_cache = priv;
+	retval = 1;
     }
 
     return retval;
@@ -916,7 +965,7 @@ retry:
 	num_unpin = fh_WaitLocalFirehoses(1, unpin_regions);
 	gasneti_assert ((num_unpin == 0) || (num_unpin == 1));
 
-	/* unpin !visible regions on the Fifo */
+	/* unpin covered regions on the Fifo */
 	num_unpin += fh_clean_covered_local(FH_MAX_UNPIN_LOC - num_unpin, unpin_regions + num_unpin);
 
 	FH_TABLE_UNLOCK;
@@ -956,6 +1005,111 @@ retry:
     return;
 }
 
+/* Misses are pinned together, along with the unpin of their victims, by a
+ * single firehose_move_callback().  A miss is only added to the batch if a
+ * victim can be had w/o blocking, so only the first request may block.
+ */
+int
+fh_acquire_local_batch(firehose_request_t **reqs, int *localhit, int num)
+{
+    firehose_region_t pin_regions[FH_MAX_PIN_BATCH];
+    firehose_region_t unpin_regions[FH_MAX_PIN_BATCH + FH_MAX_UNPIN_LOC];
+    firehose_private_t *pin_privs[FH_MAX_PIN_BATCH];
+    int pin_idx[FH_MAX_PIN_BATCH];
+    int num_pin = 0;
+    int i, j;
+
+    gasneti_assert(num > 0);
+    gasneti_assert(num <= FH_MAX_PIN_BATCH);
+
+    FH_TABLE_ASSERT_LOCKED;
+
+    for (i = 0; i < num; ++i) {
+	firehose_request_t *req = reqs[i];
+	firehose_private_t *priv;
+
+	gasneti_assert(req->node == gasneti_mynode);
+	gasneti_assert(req->len <= fhi_MaxRegionSize);
+
+	localhit[i] = 1;
+	pin_idx[i] = -1;
+
+	priv = fhi_find_priv(gasneti_mynode, req->addr, req->len);
+	if (priv && FH_IS_READY(1, priv)) {
+	    fh_priv_acquire_local(1, priv);
+	    CP_PRIV_TO_REQ(req, priv);
+	    GASNETI_TRACE_EVENT(C,FH_LOCAL_HIT);
+	    continue;
+	}
+	else if (priv) {
+	    /* Must wait for space, which may drop the lock */
+	    if (num_pin) break;
+	    fh_acquire_local_region(req);
+	    continue;
+	}
+
+	/* Covered by a miss earlier in this batch? */
+	for (j = 0; j < num_pin; ++j) {
+	    if ((req->addr >= pin_regions[j].addr) &&
+		(fh_req_end(req) <= pin_regions[j].addr + (pin_regions[j].len - 1)))
+		break;
+	}
+	if (j == num_pin) {
+	    if (num_pin &&
+		(num_pin >= FHC_MAXVICTIM_BUCKETS_AVAIL + fhc_LocalVictimFifoBuckets))
+		break;
+
+	    pin_regions[j].addr = req->addr;
+	    pin_regions[j].len  = req->len;
+	    fhi_merge_regions(&pin_regions[j]);
+	    pin_privs[j] = NULL;
+	    ++num_pin;
+	}
+	localhit[i] = 0;
+	pin_idx[i] = j;
+    }
+    num = i;
+
+    if (num_pin) {
+	int num_unpin;
+
+	num_unpin = fh_WaitLocalFirehoses(num_pin, unpin_regions);
+	gasneti_assert(num_unpin <= num_pin);
+
+	/* unpin covered regions on the Fifo */
+	num_unpin += fh_clean_covered_local(FH_MAX_UNPIN_LOC, unpin_regions + num_unpin);
+
+	FH_TABLE_UNLOCK;
+	firehose_move_callback(gasneti_mynode,
+				unpin_regions, num_unpin,
+				pin_regions, num_pin);
+	FH_TABLE_LOCK;
+
+	/* The first request on each new region takes the initial reference */
+	for (i = 0; i < num; ++i) {
+	    firehose_private_t *priv;
+
+	    j = pin_idx[i];
+	    if (j < 0) continue;
+
+	    priv = pin_privs[j];
+	    if (priv == NULL) {
+		pin_privs[j] = priv = fhi_init_local_region(1, &pin_regions[j]);
+#ifdef DEBUG_LOCAL_TABLE
+		--fhc_LocalReserved;
+#endif
+		GASNETI_TRACE_EVENT(C,FH_LOCAL_MISS);
+	    }
+	    else {
+		fh_priv_acquire_local(1, priv);
+	    }
+	    CP_PRIV_TO_REQ(reqs[i], priv);
+	}
+    }
+
+    return num;
+}
+
 void
 fh_commit_try_local_region(firehose_request_t *req)
 {
@@ -987,12 +1141,45 @@ fh_release_local_region(firehose_request_t *request)
 	gasneti_assert(request->node == gasneti_mynode);
 	gasneti_assert(request->internal != NULL);
 
+	/* Caller (firehose_release) trims the FIFO once for all requests */
 	fh_priv_release_local(1, request->internal);
-	fh_AdjustLocalFifoAndPin(gasneti_mynode, NULL, 0);
 
 	return;
 }
 
+/* ##################################################################### */
+/* LOCK-FREE HIT AND RELEASE                                             */
+/* ##################################################################### */
+/* These run between FH_FAST_ENTER() and FH_FAST_EXIT(), so the region
+ * trees and the private_t states are stable while the refcounts are not.
+ */
+int
+fh_fast_acquire_region(firehose_request_t *req)
+{
+    firehose_private_t *priv;
+
+    gasneti_assert(req != NULL);
+    FH_ASSERT_BUCKET_ADDR(req->addr);
+
+    priv = fh_tree_lookup(req->node, req->addr);
+
+    if (!priv || (fh_req_end(req) > fh_priv_end(priv)) ||
+	!fh_priv_fast_adjust((req->node == gasneti_mynode), priv, 1))
+	return 0;
+
+    CP_PRIV_TO_REQ(req, priv);
+    return 1;
+}
+
+int
+fh_fast_release_region(firehose_request_t *req)
+{
+    gasneti_assert(req != NULL);
+    gasneti_assert(req->internal != NULL);
+
+    return fh_priv_fast_adjust((req->node == gasneti_mynode), req->internal, -1);
+}
+
 /* ##################################################################### */
 /* REMOTE PINNING                                                        */
 /* ##################################################################### */
@@ -1025,7 +1212,7 @@ fhi_hang_callback(firehose_private_t *priv, firehose_request_t *req,
     GASNETI_TRACE_PRINTF(C, ("Firehose Pending ADD priv=%p "
                              "(%p,%d), req=%p", (void *) priv,
                              (void *) FH_BADDR(priv),
-			     (int) FH_NODE(priv->bucket),
+			     (int) priv->node,
                              (void *) req));
 
     req->flags |= FH_FLAG_PENDING;
@@ -1071,7 +1258,7 @@ fh_acquire_remote_region(firehose_request_t *req,
 	}
 	gasneti_assert ((num_unpin == 0) || (num_unpin == 1));
 
-	/* unpin !visible regions on the Fifo */
+	/* unpin covered regions on the Fifo */
 	num_unpin += fh_clean_covered_remote(node, FH_MAX_UNPIN_REM - num_unpin, unpin_regions + num_unpin);
 
 	payload_size += num_unpin * sizeof(firehose_region_t);
@@ -1276,9 +1463,9 @@ fh_init_plugin(uintptr_t max_pinnable_memory,
 	int dflt_R, dflt_VR;
 	int dflt_RS;
 
-        /* Initialize the Bucket tables */
-        fh_BucketTable1 = fh_hash_create(1<<16); /* 64k */
-        fh_BucketTable2 = fh_hash_create(1<<17); /* 128k */
+        /* Initialize the region trees */
+        fh_RegionTree = (firehose_private_t **)
+		gasneti_calloc(gasneti_nodes, sizeof(firehose_private_t *));
 
 #if 0  /* UNUSED - see param_RS computation for explanation */
 	/* Count how many regions fit into an AM Medium payload */
@@ -1608,27 +1795,27 @@ fh_priv_print_fn(void *val, void *arg)
 	int lref = FH_IS_LOCAL_FIFO(priv) ? 0 : FH_BUCKET_REFC(priv)->refc_l;
 	int rref = FH_IS_LOCAL_FIFO(priv) ? 0 : FH_BUCKET_REFC(priv)->refc_r;
 
-	fprintf(stderr, "[n%d] %p - %p (%4d of %4d pages visible) refc=(%4dL, %4dR)\n",
+	fprintf(stderr, "[n%d] %p - %p (%4d pages, %s) refc=(%4dL, %4dR)\n",
 			(int)gasneti_mynode, (void*)FH_BADDR(priv), (void*)fh_priv_end(priv),
-			priv->visible, (int)(priv->len>>FH_BUCKET_SHIFT),
-			lref, rref);
+			(int)(priv->len>>FH_BUCKET_SHIFT),
+			priv->covered ? "covered" : "visible", lref, rref);
 }
 
 #ifdef DEBUG_BUCKETS
 static void
 fh_priv_check_fn(void *val, void *arg)
 {
-	fh_bucket_t *bucket = val;
-	firehose_private_t *priv = bucket->priv;
-	int live = (FH_NODE(bucket) == gasneti_mynode)
+	firehose_private_t *priv = val;
+	int live = (priv->node == gasneti_mynode)
 			? (!FH_IS_LOCAL_FIFO(priv) && FH_BUCKET_REFC(priv)->refc_l)
 			: (!FH_IS_REMOTE_FIFO(priv) && FH_BUCKET_REFC(priv)->refc_r);
 
 	if_pf (live && !priv->prepinned) {
 		/* XXX: promote to fatalerror? */
-		fprintf(stderr, "WARNING: firehose leak detected on node %d - %d:%p %4d pages (%4d pages visible)\n",
-			(int)gasneti_mynode, (int)FH_NODE(bucket), (void*)FH_BADDR(priv), 
-			(int)(priv->len>>FH_BUCKET_SHIFT), priv->visible);
+		fprintf(stderr, "WARNING: firehose leak detected on node %d - %d:%p %4d pages (%s)\n",
+			(int)gasneti_mynode, (int)priv->node, (void*)FH_BADDR(priv), 
+			(int)(priv->len>>FH_BUCKET_SHIFT),
+			priv->covered ? "covered" : "visible");
 		priv->prepinned = 1; /* Avoids duplicates in output */
 	}
 }
@@ -1665,9 +1852,11 @@ fh_fini_plugin(void)
 	}
 
 #ifdef DEBUG_BUCKETS
-	/* Check the hash table for leaks */
-	fh_hash_apply(fh_BucketTable1, &fh_priv_check_fn, NULL);
-	fh_hash_apply(fh_BucketTable2, &fh_priv_check_fn, NULL);
+	/* Check the region trees for leaks */
+	{ gasnet_node_t node;
+	  for (node = 0; node < gasneti_nodes; ++node)
+		fh_tree_apply(fh_RegionTree[node], &fh_priv_check_fn, NULL);
+	}
 #endif
 
 	if (fhi_InitFlags & FIREHOSE_INIT_FLAG_UNPIN_ON_FINI) {
@@ -1675,8 +1864,7 @@ fh_fini_plugin(void)
 		fh_hash_apply(fh_PrivTable, &fh_priv_cleanup_fn, NULL);
 	}
 
-        fh_hash_destroy(fh_BucketTable2);
-        fh_hash_destroy(fh_BucketTable1);
+        gasneti_free(fh_RegionTree);
         fh_hash_destroy(fh_PrivTable);
 
 #if 0 /* No - fhi_priv_freelist is allocated in chunks, not individually */
@@ -17,6 +17,8 @@
         CNT(C, FH_PARTIAL_LOCAL_HIT, cnt)                  \
         CNT(C, FH_PARTIAL_LOCAL_MISS, cnt)                 \
         CNT(C, FH_PARTIAL_LOCAL_FAIL, cnt)                 \
+        CNT(C, FH_LOCAL_DEFER, cnt)                        \
+        VAL(C, FH_LOCAL_BATCH, deferred pins serviced)     \
         VAL(C, FH_REMOTE_PIN, pages requested)             \
         CNT(C, FH_REMOTE_HIT, cnt)                         \
         CNT(C, FH_REMOTE_PENDING, cnt)                     \
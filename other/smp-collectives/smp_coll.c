@@ -20,7 +20,7 @@
 
 
 
-#define BOOTSTRAP_BARRIER(HANDLE, FLAGS) smp_coll_barrier_cond_var(HANDLE, FLAGS)
+#define BOOTSTRAP_BARRIER(HANDLE, FLAGS) (*(HANDLE)->bootstrap_barrier)(HANDLE, FLAGS)
 static volatile uint32_t *smp_coll_all_flags;
 static volatile uint32_t *smp_coll_all_barrier_flags;
 static volatile uint32_t *smp_coll_all_bcast_flags;
@@ -59,6 +59,10 @@ smp_coll_t smp_coll_init(size_t aux_space_per_thread, int flags, int THREADS, in
   ret->THREADS = THREADS;
   ret->flag_set = 0;
   ret->tempaddrs = (void**) gasneti_malloc(sizeof(void*)*THREADS);
+  ret->bootstrap_barrier = smp_coll_barrier_cond_var;
+  ret->bootstrap_arg = NULL;
+  ret->poll_fn = NULL;
+  ret->barrier_children = NULL;
   if(flags & SMP_COLL_SET_AFFINITY) {
     smp_coll_set_affinity(MYTHREAD);
   }
@@ -141,6 +145,84 @@ smp_coll_t smp_coll_init(size_t aux_space_per_thread, int flags, int THREADS, in
   return ret;
 }
 
+#define SMP_COLL_FLAG_ARRAY_SIZE(THREADS) (SMP_COLL_CACHE_LINE*(THREADS)*sizeof(uint32_t))
+
+size_t smp_coll_pshm_region_size(int THREADS) {
+  return 3*SMP_COLL_FLAG_ARRAY_SIZE(THREADS) + 
+         2*SMP_COLL_CACHE_LINE*THREADS*sizeof(gasnett_atomic_t) + SMP_COLL_CACHE_LINE;
+}
+
+/*same algorithms as smp_coll_init() but the flags and atomics live in a region that every
+  participant has mapped (at possibly different addresses), so the participants can be 
+  separate processes*/
+smp_coll_t smp_coll_init_pshm(void *region, int flags, int THREADS, int MYTHREAD,
+                              void (*bootstrap_fn)(smp_coll_t, int), void *bootstrap_arg) {
+  smp_coll_t ret;
+  uintptr_t addr = ALIGNUP(region, SMP_COLL_CACHE_LINE);
+
+  ret = (struct smp_coll_t_*) gasneti_calloc(1, sizeof(struct smp_coll_t_));
+  ret->MYTHREAD = MYTHREAD;
+  ret->THREADS = THREADS;
+  ret->tempaddrs = (void**) gasneti_malloc(sizeof(void*)*THREADS);
+  ret->bootstrap_barrier = bootstrap_fn;
+  ret->bootstrap_arg = bootstrap_arg;
+  if(flags & SMP_COLL_SET_AFFINITY) {
+    smp_coll_set_affinity(MYTHREAD);
+  }
+  SMP_COLL_CONSTRUCT_BARR_ROUTINES(ret);
+  /*the cond var barrier only works among the threads of one process*/
+  ret->barr_fns[SMP_COLL_BARRIER_COND_VAR] = bootstrap_fn;
+
+  /*every participant carves the same layout out of its own mapping*/
+  ret->flags = (volatile uint32_t*) addr;
+  addr += SMP_COLL_FLAG_ARRAY_SIZE(THREADS);
+  ret->barrier_flags = (volatile uint32_t*) addr;
+  addr += SMP_COLL_FLAG_ARRAY_SIZE(THREADS);
+  ret->bcast_flags = (volatile uint32_t*) addr;
+  addr += SMP_COLL_FLAG_ARRAY_SIZE(THREADS);
+  ret->atomic_vars = (gasnett_atomic_t*) addr;
+  gasneti_assert(addr + 2*SMP_COLL_CACHE_LINE*THREADS*sizeof(gasnett_atomic_t) <= 
+                 (uintptr_t)region + smp_coll_pshm_region_size(THREADS));
+
+  /*no scratch space is shared between the processes*/
+  ret->aux_space = NULL;
+  ret->aux_space_all = NULL;
+  ret->flag_set = 0;
+  ret->barrier_flag_set = 0;
+  ret->curr_atomic_set = 0;
+  ret->dissem_info = NULL;
+
+  /*the region's previous contents are garbage until everyone has cleared their flags*/
+  smp_coll_reset_all_flags(ret);
+
+  if(!(flags & SMP_COLL_SKIP_TUNE_BARRIERS)) {
+    smp_coll_tune_barrier(ret);
+  } else {
+    smp_coll_set_barrier_routine(ret, SMP_COLL_BARRIER_TREE_PUSH_PULL, 4);
+  }
+  
+  smp_coll_reset_all_flags(ret);
+  return ret;
+}
+
+void *smp_coll_bootstrap_arg(smp_coll_t handle) {
+  return handle->bootstrap_arg;
+}
+
+void smp_coll_set_poll_fn(smp_coll_t handle, void (*poll_fn)(void)) {
+  handle->poll_fn = poll_fn;
+}
+
+/*frees the per-participant state; shared flags belong to whoever provided them*/
+void smp_coll_fini(smp_coll_t handle) {
+  if(handle->dissem_info) smp_coll_free_dissemination(handle->dissem_info);
+  gasneti_free(handle->barrier_children);
+  gasneti_free(handle->tempaddrs);
+  gasneti_free(handle->aux_space);
+  gasneti_free(handle->aux_space_all);
+  gasneti_free(handle);
+}
+
 void smp_coll_safe_barrier(smp_coll_t handle, int flags) {
   int i,j;
   BOOTSTRAP_BARRIER(handle, flags);
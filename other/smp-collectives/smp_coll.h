@@ -25,6 +25,14 @@ typedef double (*RED_FN_DBL)(double, double);
 #define INLINE_ALL_COLLECTIVES 0
 void smp_coll_set_affinity(int location);
 smp_coll_t smp_coll_init(size_t aux_space_per_thread, int flags, int THREADS, int MYTHREAD);
+/*handles whose flags live in a caller-provided region mapped by every participant (e.g. PSHM)*/
+/*the bootstrap barrier must synchronize all THREADS participants and is only used during setup*/
+size_t smp_coll_pshm_region_size(int THREADS);
+smp_coll_t smp_coll_init_pshm(void *region, int flags, int THREADS, int MYTHREAD,
+                              void (*bootstrap_fn)(smp_coll_t, int), void *bootstrap_arg);
+void *smp_coll_bootstrap_arg(smp_coll_t handle);
+void smp_coll_set_poll_fn(smp_coll_t handle, void (*poll_fn)(void));
+void smp_coll_fini(smp_coll_t handle);
 void smp_coll_reset_all_flags(smp_coll_t handle);
 void smp_coll_tune_barrier(smp_coll_t handle);
 /*tuning knobs*/
@@ -64,6 +72,9 @@ void smp_coll_set_exchange_routine(smp_coll_t handle, smp_coll_exchange_routine_
 
 void smp_coll_safe_barrier(smp_coll_t handle, int flags);
 
+void smp_coll_broadcast_tree_flag(smp_coll_t handle, int num_addrs, void * const dstlist[], const void *src, 
+                                  size_t nbytes, int flags, int radix);
+
 #if INLINE_ALL_COLLECTIVES
 #define smp_coll_barrier(HANDLE, FLAGS) do {\
 (*(HANDLE)->barr_fns[(HANDLE)->curr_barrier_routine])(HANDLE, (FLAGS));\
@@ -75,6 +75,7 @@ void smp_coll_set_barrier_routine_with_root(smp_coll_t handle, smp_coll_barrier_
       } 
     }
     
+    gasneti_free(handle->barrier_children);
     handle->barrier_children = (int*) gasneti_malloc(sizeof(int)*child_count);
     
 
@@ -124,9 +125,9 @@ void smp_coll_tune_barrier(smp_coll_t handle) {
   double time;
   int barrier_iters=gasneti_getenv_int_withdefault("GASNET_COLL_TUNE_SMP_BARRIER_ITER", 1000, 0);
   int root;
-  static int best_barrier_radix = 2;
-  static int best_barrier_routine = SMP_COLL_BARRIER_DISSEM_ATOMIC;
-  static int best_root = 0;
+  int best_barrier_radix = 2;
+  int best_barrier_routine = SMP_COLL_BARRIER_DISSEM_ATOMIC;
+  int best_root = 0;
 
 #if VERBOSE_TUNING
   if(handle->MYTHREAD==0) fprintf(stderr, "starting autotuning of local barrier\n");
@@ -167,6 +168,17 @@ void smp_coll_tune_barrier(smp_coll_t handle) {
       }
     }
   }
+  /*thread 0 timed the candidates; publish its choice so that all participants agree*/
+  if(handle->MYTHREAD==0) {
+    SMP_COLL_SET_FLAG(handle, 0, 0, best_barrier_routine);
+    SMP_COLL_SET_FLAG(handle, 0, 1, best_barrier_radix);
+    SMP_COLL_SET_FLAG(handle, 0, 2, best_root);
+  }
+  (*handle->bootstrap_barrier)(handle, 0);
+  best_barrier_routine = SMP_COLL_GET_FLAG(handle, 0, 0);
+  best_barrier_radix = SMP_COLL_GET_FLAG(handle, 0, 1);
+  best_root = SMP_COLL_GET_FLAG(handle, 0, 2);
+  (*handle->bootstrap_barrier)(handle, 0);
 #if VERBOSE_TUNING
   if(handle->MYTHREAD==0) fprintf(stderr, "setting best barrier: routine: %d radix: %d root: %d time: %g ns\n", best_barrier_routine, best_barrier_radix, best_root, best_time);
 #endif
@@ -264,7 +276,7 @@ void smp_coll_barrier_dissem_atomic(smp_coll_t handle, int flags) {
         SMP_COLL_INC_ATOMIC(handle, dest, i, handle->curr_atomic_set);
       }
       /*wait for counter i to be barrier_order[i].n*/
-      gasneti_waitwhile(SMP_COLL_READ_ATOMIC(handle, handle->MYTHREAD, i, handle->curr_atomic_set)!=barrier_order[i].n);
+      SMP_COLL_WAITWHILE(handle, SMP_COLL_READ_ATOMIC(handle, handle->MYTHREAD, i, handle->curr_atomic_set)!=barrier_order[i].n);
       SMP_COLL_RESET_ATOMIC(handle, handle->MYTHREAD, i, handle->curr_atomic_set);
     }
   }
@@ -283,14 +295,14 @@ void smp_coll_barrier_tree_push_push(smp_coll_t handle, int flags) {
   gasnett_local_wmb();
   
   /*push based tree wait for all children*/
-  gasneti_waitwhile(SMP_COLL_READ_ATOMIC(handle, handle->MYTHREAD, 0, atomicset)!=handle->barrier_num_children);
+  SMP_COLL_WAITWHILE(handle, SMP_COLL_READ_ATOMIC(handle, handle->MYTHREAD, 0, atomicset)!=handle->barrier_num_children);
   SMP_COLL_RESET_ATOMIC(handle, handle->MYTHREAD, 0, atomicset);
 
   /*if i'm not root*/
   if(handle->MYTHREAD!=handle->barrier_root) {
     /*singal parent and wait for parent to signal us*/
     SMP_COLL_INC_ATOMIC(handle, handle->barrier_parent, 0, atomicset);
-    gasneti_waitwhile(SMP_COLL_GET_BARRIER_FLAG(handle, handle->MYTHREAD, flagset)==0);
+    SMP_COLL_WAITWHILE(handle, SMP_COLL_GET_BARRIER_FLAG(handle, handle->MYTHREAD, flagset)==0);
     SMP_COLL_SET_BARRIER_FLAG(handle, handle->MYTHREAD, flagset, 0);
   }
   
@@ -310,13 +322,13 @@ void smp_coll_barrier_tree_push_pull(smp_coll_t handle, int flags) {
   gasnett_local_wmb();
   
   /*push based tree wait for all children*/
-  gasneti_waitwhile(SMP_COLL_READ_ATOMIC(handle, handle->MYTHREAD, 0, handle->curr_atomic_set)!=handle->barrier_num_children);
+  SMP_COLL_WAITWHILE(handle, SMP_COLL_READ_ATOMIC(handle, handle->MYTHREAD, 0, handle->curr_atomic_set)!=handle->barrier_num_children);
   SMP_COLL_RESET_ATOMIC(handle, handle->MYTHREAD, 0, handle->curr_atomic_set);
   
   /*signal parent and wiat for parent*/
   if(handle->MYTHREAD!=handle->barrier_root) { 
     SMP_COLL_INC_ATOMIC(handle, handle->barrier_parent, 0, handle->curr_atomic_set);
-    gasneti_waitwhile(SMP_COLL_GET_BARRIER_FLAG(handle, handle->barrier_parent, flagset)==0);
+    SMP_COLL_WAITWHILE(handle, SMP_COLL_GET_BARRIER_FLAG(handle, handle->barrier_parent, flagset)==0);
   }
   
   /*parent has now acked my signal so we can clear the up signal*/
@@ -338,7 +350,7 @@ void smp_coll_barrier_tree_pull_push(smp_coll_t handle, int flags) {
   int flagset = handle->barrier_flag_set;
   gasnett_local_wmb();
   for(i=0; i<handle->barrier_num_children; i++) {
-    gasneti_waitwhile(SMP_COLL_GET_BARRIER_FLAG(handle, handle->barrier_children[i], flagset)==0);
+    SMP_COLL_WAITWHILE(handle, SMP_COLL_GET_BARRIER_FLAG(handle, handle->barrier_children[i], flagset)==0);
   }
   
   /*reset old one*/
@@ -348,7 +360,7 @@ void smp_coll_barrier_tree_pull_push(smp_coll_t handle, int flags) {
   SMP_COLL_SET_BARRIER_FLAG(handle, handle->MYTHREAD, flagset, 1);  
   if(handle->MYTHREAD!=handle->barrier_root) {
     /*singal parent and wait for parent to signal us*/
-    gasneti_waitwhile(SMP_COLL_GET_BARRIER_FLAG(handle, handle->MYTHREAD, 2+flagset)==0);
+    SMP_COLL_WAITWHILE(handle, SMP_COLL_GET_BARRIER_FLAG(handle, handle->MYTHREAD, 2+flagset)==0);
     SMP_COLL_SET_BARRIER_FLAG(handle, handle->MYTHREAD, 2+flagset, 0);
   }
   
@@ -366,7 +378,7 @@ void smp_coll_barrier_tree_pull_pull(smp_coll_t handle, int flags) {
   int flagset = handle->barrier_flag_set;
   gasnett_local_wmb();
   for(i=0; i<handle->barrier_num_children; i++) {
-    gasneti_waitwhile(SMP_COLL_GET_BARRIER_FLAG(handle, handle->barrier_children[i], flagset)==0);
+    SMP_COLL_WAITWHILE(handle, SMP_COLL_GET_BARRIER_FLAG(handle, handle->barrier_children[i], flagset)==0);
   }
   
   /*set my flag indicating barrier is done*/
@@ -376,7 +388,7 @@ void smp_coll_barrier_tree_pull_pull(smp_coll_t handle, int flags) {
   /*wait for parent to raise flag*/
   if(handle->MYTHREAD!=handle->barrier_root) {
 
-    gasneti_waitwhile(SMP_COLL_GET_BARRIER_FLAG(handle, handle->barrier_parent, 2+flagset)==0);
+    SMP_COLL_WAITWHILE(handle, SMP_COLL_GET_BARRIER_FLAG(handle, handle->barrier_parent, 2+flagset)==0);
   }  
 
   /*parent has now acked my signal so we can clear the up signal*/
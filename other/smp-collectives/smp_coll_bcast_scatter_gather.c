@@ -130,7 +130,7 @@ void smp_coll_broadcast_tree_flag(smp_coll_t handle, int num_addrs, void * const
   
   /*they then wait for the parent to come around and reset their flag back to 0 indicating the data has also arrived*/
   if(handle->MYTHREAD!=0) {
-    gasneti_waitwhile(SMP_COLL_GET_BCAST_FLAG(handle, handle->MYTHREAD,0)!=0);
+    SMP_COLL_WAITWHILE(handle, SMP_COLL_GET_BCAST_FLAG(handle, handle->MYTHREAD,0)!=0);
   } else {
     memcpy(dstlist[0], src, nbytes);
   }
@@ -142,7 +142,7 @@ void smp_coll_broadcast_tree_flag(smp_coll_t handle, int num_addrs, void * const
         int dest = SMP_COLL_MAKE_NUM_POWER2RADIX(handle->MYTHREAD, i, k, radix, radixlog2);
         if(dest<handle->THREADS) {
           /*wait for dest to be ready before we send*/
-          gasneti_waitwhile(SMP_COLL_GET_BCAST_FLAG(handle, dest, 0)==0);
+          SMP_COLL_WAITWHILE(handle, SMP_COLL_GET_BCAST_FLAG(handle, dest, 0)==0);
           memcpy(dstlist[dest], dstlist[handle->MYTHREAD], nbytes); 
           /*write memory barrier to ensure data is transfered before we set the flag*/
           gasnett_local_wmb();
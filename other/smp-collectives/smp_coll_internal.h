@@ -47,6 +47,17 @@ int smp_coll_mypown(int base, int power) {
 }
 
 
+/*spin while COND holds, running the handle's poll hook (if any) so that participants
+  in other processes which are waiting on our progress are not starved*/
+#define SMP_COLL_WAITWHILE(HANDLE,COND) do {\
+  if((HANDLE)->poll_fn) {\
+    while(COND) { gasnett_spinloop_hint(); (*(HANDLE)->poll_fn)(); }\
+    gasnett_local_rmb();\
+  } else {\
+    gasneti_waitwhile(COND);\
+  }\
+} while(0)
+
 #define SMP_COLL_GET_FLAG(HANDLE,THREAD_ID,IDX)\
 ((volatile uint32_t*)(HANDLE)->flags)[(THREAD_ID)*SMP_COLL_CACHE_LINE+(IDX)]
 
@@ -366,6 +377,12 @@ struct smp_coll_t_{
   uint8_t *aux_space;
   uint8_t **aux_space_all;
   void **tempaddrs;
+
+  /*barrier used during setup; a cond var for threads, caller-provided for PSHM handles*/
+  SMP_COLL_BARR_FN bootstrap_barrier;
+  void *bootstrap_arg;
+  /*called while spinning, NULL for none*/
+  void (*poll_fn)(void);
   
 
   
@@ -16,7 +16,7 @@
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 #include <netinet/in.h>
-#include <sys/select.h>
+#include <poll.h>
 #if HAVE_NETINET_TCP_H
   #include <netinet/tcp.h>
 #endif
@@ -140,8 +140,6 @@
    + Give master its own rank children too?
    + Implement "custom" spawner in the spirit of udp-conduit.
    + Look at udp-conduit for things missing from this list. :-)
-   + Can write/writev loops use O_NONBLOCK to write portions to each
-     socket w/o blocking?
 
  */
 
@@ -207,6 +205,10 @@ static struct child {
   gasnet_node_t       tree_ranks; /* ranks in this sub-tree, including self (1 for rank procs) */
   gasnet_node_t       tree_nodes; /* nodes in this sub-tree, including self (1 for rank procs) */
   char **             nodelist;
+  uint8_t *           obuf;       /* output queued by ctrl_writev() (control sockets only) */
+  size_t              obuf_off;   /* offset of first unwritten byte */
+  size_t              obuf_len;   /* offset one past last unwritten byte */
+  size_t              obuf_cap;
 #if GASNET_BLCR
   cr_restart_handle_t rstrt_handle;
   char                rstrt_args;
@@ -222,10 +224,8 @@ static int finalized = 0;
 static gasneti_atomic_t live = gasneti_atomic_init(0);
 static volatile int in_abort = 0;
 static gasnet_node_t out_degree = GASNETI_DEFAULT_SSH_OUT_DEGREE;
-static struct fds {
-  fd_set set;
-  int    max;
-} child_fds, all_fds;
+static struct pollfd *poll_fds = NULL; /* control processes: [k+1] is for child[k] */
+static struct pollfd *urg_fds = NULL;  /* control processes: for use by sigurg_handler() */
 static int parent = -1; /* socket */
 static gasnet_node_t myrank = 0;
 static int myname = -1;
@@ -634,35 +634,39 @@ static void sigurg_handler(int sig)
 
   if (is_control) {
     /* We need to read our single byte of OOB data here.
-     * Use of select() can tell us who sent it to us.
-     * MSG_OOB is supposed to always be non-blocking.i
+     * Use of poll() can tell us who sent it to us.
+     * MSG_OOB is supposed to always be non-blocking.
      * If multiple sockets have OOB data we read them all.
      * If the SIGURG came fron kill() rather than OOB,
      * then we'll keep the value 127, leading to an abort.
      */
 
-    struct timeval timeout = {0,0};
-    fd_set fds = all_fds.set;
-    int count = select(all_fds.max+1, NULL, NULL, &fds, &timeout);
-    if (!count) {
+    struct pollfd parent_fd;
+    struct pollfd *fds = urg_fds ? urg_fds : &parent_fd; /* only parent is known prior to do_common() */
+    int j, n = 0, count;
+
+    if (urg_fds) {
+      for (j = 0; j < ctrl_children; ++j) { /* Only check the control sockets */
+        if (child[j].sock <= 0) continue; /* not yet connected */
+        fds[n].fd = child[j].sock;
+        fds[n].events = POLLPRI;
+        ++n;
+      }
+    }
+    if (parent >= 0) {
+      fds[n].fd = parent;
+      fds[n].events = POLLPRI;
+      ++n;
+    }
+    count = n ? poll(fds, n, 0) : 0;
+    if (count <= 0) {
       BOOTSTRAP_VERBOSE(("[%d] sigurg with NO exception fds\n", myname));
       do_abort(-1);
     }
-    while (count) {
-      int j, fd = -1;
-      for (j = 0; j < ctrl_children; ++j) { /* Only check the control sockets */
-        if (FD_ISSET(child[j].sock, &fds)) {
-          fd = child[j].sock;
-          break;
-        }
+    for (j = 0; j < n; ++j) {
+      if (fds[j].revents & POLLPRI) {
+        (void)recv(fds[j].fd, &byte, 1, MSG_OOB);
       }
-      if ((fd < 0) && (parent >= 0) && FD_ISSET(parent, &fds)) {
-        fd = parent;
-      }
-      if (fd < 0) break; /* Unknown source! */
-      (void)recv(fd, &byte, 1, MSG_OOB);
-      FD_CLR(fd, &fds);
-      --count;
     }
   }
 
@@ -677,20 +681,30 @@ static void sigurg_handler(int sig)
   }
 }
 
+/* Control sockets are non-blocking once in event_loop() */
+#define WOULD_BLOCK(_rc) (((_rc) < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)))
+
+static void wait_fd(int fd, short events);
+
 static void do_write(int fd, const void *buf, size_t len)
 {
   const char *p = (const char *)buf;
   while (len) {
     ssize_t rc = write(fd, p, len);
-    if_pf (!rc || ((rc < 0) && (errno != EINTR))) do_abort(-1);
+    if_pf (WOULD_BLOCK(rc)) wait_fd(fd, POLLOUT);
+    else if_pf (!rc || ((rc < 0) && (errno != EINTR))) do_abort(-1);
     if_pf (in_abort) break;
+    if_pf (rc < 0) continue; /* EINTR or EAGAIN */
     p += rc;
     len -= rc;
   }
 }
 
-/* NOTE that unlike writev() we clobber the iovec */
-static void do_writev(int fd, struct iovec *iov, int iovcnt)
+/* Write as much as possible w/o blocking (if fd is non-blocking), advancing
+ * *iov_p and *iovcnt_p past the data written.
+ * Returns non-zero if any data remains unwritten.
+ * NOTE that unlike writev() we clobber the iovec */
+static int try_writev(int fd, struct iovec **iov_p, int *iovcnt_p)
 {
 #if defined(IOV_MAX)
   static int iov_max = IOV_MAX;
@@ -699,13 +713,15 @@ static void do_writev(int fd, struct iovec *iov, int iovcnt)
 #else
   static int iov_max = 1024;
 #endif
+  struct iovec *iov = *iov_p;
+  int iovcnt = *iovcnt_p;
 
   while (iovcnt) {
     ssize_t rc;
 
     while (0 == iov->iov_len) {
       ++iov;
-      if (0 == --iovcnt) return;
+      if (0 == --iovcnt) goto out;
     }
 
     rc = writev(fd, iov, MIN(iovcnt, iov_max));
@@ -713,8 +729,10 @@ static void do_writev(int fd, struct iovec *iov, int iovcnt)
       iov_max /= 2;
       continue;
     }
+    if_pf (WOULD_BLOCK(rc)) break;
     if_pf (!rc || ((rc < 0) && (errno != EINTR))) do_abort(-1);
     if_pf (in_abort) break;
+    if_pf (rc < 0) continue; /* EINTR */
 
     gasneti_assert(rc > 0);
     do {
@@ -733,6 +751,19 @@ static void do_writev(int fd, struct iovec *iov, int iovcnt)
       }
     } while (rc);
   }
+
+out:
+  *iov_p = iov;
+  *iovcnt_p = iovcnt;
+  return (iovcnt != 0);
+}
+
+/* NOTE that unlike writev() we clobber the iovec */
+static void do_writev(int fd, struct iovec *iov, int iovcnt)
+{
+  while (try_writev(fd, &iov, &iovcnt) && !in_abort) {
+    wait_fd(fd, POLLOUT);
+  }
 }
 
 static void do_write_string(int fd, const char *string) {
@@ -750,8 +781,10 @@ static void do_read(int fd, void *buf, size_t len)
   char *p = (char *)buf;
   while (len) {
     ssize_t rc = read(fd, p, len);
-    if_pf (!rc || ((rc < 0) && (errno != EINTR))) do_abort(-1);
+    if_pf (WOULD_BLOCK(rc)) wait_fd(fd, POLLIN);
+    else if_pf (!rc || ((rc < 0) && (errno != EINTR))) do_abort(-1);
     if_pf (in_abort) break;
+    if_pf (rc < 0) continue; /* EINTR or EAGAIN */
     p += rc;
     len -= rc;
   }
@@ -785,8 +818,10 @@ static void do_readv(int fd, struct iovec *iov, int iovcnt)
       iov_max /= 2;
       continue;
     }
-    if_pf (!rc || ((rc < 0) && (errno != EINTR))) do_abort(-1);
+    if_pf (WOULD_BLOCK(rc)) wait_fd(fd, POLLIN);
+    else if_pf (!rc || ((rc < 0) && (errno != EINTR))) do_abort(-1);
     if_pf (in_abort) break;
+    if_pf (rc < 0) continue; /* EINTR or EAGAIN */
 
     gasneti_assert(rc > 0);
     do {
@@ -1326,22 +1361,6 @@ static int fcntl_clrfd(int fd, int flag) {
   return rc;
 }
 
-static void fd_sets_init(void) {
-  FD_ZERO(&child_fds.set);
-  child_fds.max = -1;
-  FD_ZERO(&all_fds.set);
-  all_fds.max = -1;
-}
-
-static void fd_sets_add(int fd) {
-  FD_SET(fd, &all_fds.set);
-  all_fds.max = MAX(all_fds.max, fd);
-  if (fd != parent) {
-    FD_SET(fd, &child_fds.set);
-    child_fds.max = MAX(child_fds.max, fd);
-  }
-}
-
 
 static void pre_spawn(int count) {
   struct sockaddr_in sock_addr;
@@ -1391,7 +1410,6 @@ static void post_spawn(int count, int argc, char * const *argv) {
     }
     reaper(0); /* Disarm signal handler */
 
-    fd_sets_add(s);
     gasneti_assert(mypid == getpid());
     (void)ioctl(s, SIOCSPGRP, &mypid); /* Enable SIGURG delivery on OOB data */
     (void)fcntl_setfd(s, FD_CLOEXEC);
@@ -1500,7 +1518,6 @@ static void do_connect(const char *spawn_args, int *argc_p, char ***argv_p)
     }
   }
 
-  fd_sets_add(parent);
   gasneti_assert(mypid == getpid());
   (void)ioctl(parent, SIOCSPGRP, &mypid); /* Enable SIGURG delivery on OOB data */
   (void)fcntl_setfd(parent, FD_CLOEXEC);
@@ -1592,6 +1609,8 @@ static int do_worker(void) {
 
   gasneti_free(child-1); /* NOTE: was offset at allocation time */
   child = NULL;
+  gasneti_free(urg_fds);
+  urg_fds = NULL;
   children = 0;
   ctrl_children = 0;
 
@@ -1654,7 +1673,6 @@ static void spawn_rank(int argc, char **argv) {
     }
 
     child[j].sock = sv[1];
-    fd_sets_add(sv[1]);
     (void)fcntl_setfd(sv[1], FD_CLOEXEC);
 
   #if GASNET_BLCR
@@ -1735,12 +1753,88 @@ static void spawn_ctrl(int argc, char **argv) {
 
 /*----------------------------------------------------------------------------------------------*/
 
-static int do_select(int num_fds, fd_set *rd_fds, fd_set *wr_fds)
+/* Control process I/O
+ *
+ * Once in event_loop() all of a control process's sockets are non-blocking.
+ * Output to child[k] (k == -1 for the parent) goes through ctrl_writev(),
+ * which queues whatever the socket does not accept immediately.  Queued
+ * output drains whenever the process waits in ctrl_poll(), be that in
+ * event_loop() or in a read of a command's payload.  So a slow consumer
+ * never delays delivery to its siblings, and (unlike select()) there is no
+ * FD_SETSIZE limit on the number of sockets.
+ */
+
+static int ctrl_pending(int k)
+{
+  return (child[k].obuf_off != child[k].obuf_len);
+}
+
+/* Write as much queued output to child[k] as its socket will accept */
+static void ctrl_drain(int k)
+{
+  struct child *ch = &child[k];
+  struct iovec iov[1];
+  struct iovec *iov_p = iov;
+  int iovcnt = 1;
+  int blocked;
+
+  iov[0].iov_base = ch->obuf + ch->obuf_off;
+  iov[0].iov_len  = ch->obuf_len - ch->obuf_off;
+  blocked = try_writev(ch->sock, &iov_p, &iovcnt);
+  if (blocked) {
+    ch->obuf_off = (uint8_t *)iov_p->iov_base - ch->obuf;
+  } else {
+    ch->obuf_off = ch->obuf_len = 0;
+  }
+}
+
+/* NOTE that unlike writev() we clobber the iovec */
+static void ctrl_writev(int k, struct iovec *iov, int iovcnt)
+{
+  struct child *ch = &child[k];
+  size_t len;
+  int j;
+
+  if_pf (in_abort) return;
+
+  /* Write directly unless that would pass output already queued */
+  if (!ctrl_pending(k) && !try_writev(ch->sock, &iov, &iovcnt)) return;
+  if_pf (in_abort) return;
+
+  /* Queue the remainder */
+  if (ch->obuf_off) {
+    memmove(ch->obuf, ch->obuf + ch->obuf_off, ch->obuf_len - ch->obuf_off);
+    ch->obuf_len -= ch->obuf_off;
+    ch->obuf_off = 0;
+  }
+  for (j = 0, len = ch->obuf_len; j < iovcnt; ++j) {
+    len += iov[j].iov_len;
+  }
+  if (len > ch->obuf_cap) {
+    ch->obuf_cap = MAX(len, 2 * ch->obuf_cap);
+    ch->obuf = gasneti_realloc(ch->obuf, ch->obuf_cap);
+  }
+  for (j = 0; j < iovcnt; ++j) {
+    memcpy(ch->obuf + ch->obuf_len, iov[j].iov_base, iov[j].iov_len);
+    ch->obuf_len += iov[j].iov_len;
+  }
+}
+
+static void ctrl_write(int k, const void *buf, size_t len)
+{
+  struct iovec iov[1];
+  iov[0].iov_base = (void *)buf;
+  iov[0].iov_len  = len;
+  ctrl_writev(k, iov, 1);
+}
+
+/* Poll all control process sockets, having set the desired poll_fds[].events */
+static int ctrl_poll(void)
 {
   int rc;
 
   do {
-    rc = select(num_fds, rd_fds, wr_fds, NULL, NULL);
+    rc = poll(poll_fds, children + 1, -1);
     if_pf (!rc || ((rc < 0) && (errno != EINTR))) do_abort(-1);
     if_pf (in_abort) return -1;
   } while (rc <= 0);
@@ -1748,31 +1842,54 @@ static int do_select(int num_fds, fd_set *rd_fds, fd_set *wr_fds)
   return rc;
 }
 
-/* Return index of a writable child, removing it from the fd_set */
-static int next_write(fd_set *fds)
+/* Block until fd is ready for the given events, meanwhile draining queued output */
+static void wait_fd(int fd, short events)
 {
-  int j, rc;
-  fd_set write_fds = *fds;
+  if (!poll_fds) {
+    /* Rank process (or a control process prior to event_loop) */
+    struct pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = events;
+    while ((poll(&pfd, 1, -1) < 0) && (errno == EINTR) && !in_abort) { /* retry */ }
+    return;
+  }
 
-  rc = do_select(child_fds.max+1, NULL, &write_fds);
-  if (in_abort) return -1;
+  while (!in_abort) {
+    int k, ready = 0;
 
-  for (j = 0; j < children; ++j) {
-    if (FD_ISSET(child[j].sock, &write_fds)) {
-      FD_CLR(child[j].sock, fds);
-      return j;
+    for (k = -1; k < children; ++k) {
+      struct pollfd *p = &poll_fds[k+1];
+      p->events = ((p->fd == fd) ? events : 0) | (ctrl_pending(k) ? POLLOUT : 0);
     }
-  }
+    if (ctrl_poll() < 0) return;
 
-  /* NOT REACHED */
-  return -1; 
+    for (k = -1; k < children; ++k) {
+      struct pollfd *p = &poll_fds[k+1];
+      if (p->fd == fd) {
+        ready = (p->revents != 0);
+      } else if (p->revents & POLLOUT) {
+        ctrl_drain(k);
+      } else if (p->revents & (POLLHUP | POLLERR)) {
+        /* A peer is gone.  This is fatal unless we are finalizing. */
+        if (!finalized) do_abort(-1);
+        p->fd = -1; /* stop polling it */
+      }
+    }
+    if (ready) return;
+  }
 }
 
-#define WRITE_EACH_CHILD(_remain, _child, _fdset)         \
-  if (0 != (_remain = children))                          \
-    for (_fdset = child_fds.set;                          \
-         _remain && ((_child = next_write(&(_fdset))),1); \
-         --_remain)
+/* Block until all queued output has been written */
+static void ctrl_flush(void)
+{
+  int k;
+  for (k = -1; k < children; ++k) {
+    while (ctrl_pending(k) && (poll_fds[k+1].fd >= 0) && !in_abort) {
+      wait_fd(child[k].sock, POLLOUT);
+      if (!in_abort) ctrl_drain(k);
+    }
+  }
+}
 
 static void build_all2all_iov(struct iovec *iov, uint8_t *buf, size_t len, int rank, int size)
 {
@@ -1831,19 +1948,19 @@ static void cmd_FINI(char cmd, int i) {
     if (++count < children) return;
     count = 0;
     if (! is_root) {
-      do_write(parent, &cmd0, sizeof(cmd0));
+      ctrl_write(-1, &cmd0, sizeof(cmd0));
       return;
     }
   }
 
+  /* Must precede the writes: a rank proc may exit (SIGCHLD) as soon as it reads cmd1 */
+  finalized = 1;
+
   {
-    fd_set fds;
-    int j, k;
-    WRITE_EACH_CHILD(j,k,fds) {
-      if (k < 0) return;
-      do_write(child[k].sock, &cmd1, sizeof(cmd1));
+    int k;
+    for (k = 0; k < children; ++k) {
+      ctrl_write(k, &cmd1, sizeof(cmd1));
     }
-    finalized = 1;
   }
 }
 
@@ -1859,17 +1976,15 @@ static void cmd_BARR(char cmd, int i) {
     if (++count < children) return;
     count = 0;
     if (! is_root) {
-      do_write(parent, &cmd0, sizeof(cmd0));
+      ctrl_write(-1, &cmd0, sizeof(cmd0));
       return;
     }
   }
 
   {
-    fd_set fds;
-    int j, k;
-    WRITE_EACH_CHILD(j,k,fds) {
-      if (k < 0) return;
-      do_write(child[k].sock, &cmd1, sizeof(cmd1));
+    int k;
+    for (k = 0; k < children; ++k) {
+      ctrl_write(k, &cmd1, sizeof(cmd1));
     }
   }
 }
@@ -1899,7 +2014,7 @@ static void cmd_BCAST(char cmd, int i) {
       iov[1].iov_len  = sizeof(len);
       iov[2].iov_base = data;
       iov[2].iov_len  = len;
-      do_writev(parent, iov, 3);
+      ctrl_writev(-1, iov, 3);
     }
   } else {
     do_read(s, &len, sizeof(len));
@@ -1908,10 +2023,8 @@ static void cmd_BCAST(char cmd, int i) {
   }
 
   {
-    fd_set fds;
-    int j, k;
-    WRITE_EACH_CHILD(j,k,fds) {
-      if (k < 0) return;
+    int k;
+    for (k = 0; k < children; ++k) {
       if (k == i) continue;
       iov[0].iov_base = (void*)&cmd1;
       iov[0].iov_len  = sizeof(cmd1);
@@ -1919,7 +2032,7 @@ static void cmd_BCAST(char cmd, int i) {
       iov[1].iov_len  = sizeof(len);
       iov[2].iov_base = data;
       iov[2].iov_len  = len;
-      do_writev(child[k].sock, iov, 3);
+      ctrl_writev(k, iov, 3);
     }
     gasneti_free(data);
   }
@@ -1958,7 +2071,7 @@ static void cmd_EXCHG(char cmd, int i) {
       iov[1].iov_len  = sizeof(len);
       iov[2].iov_base = data + len * myrank;
       iov[2].iov_len  = len * tree_ranks;
-      do_writev(parent, iov, 3);
+      ctrl_writev(-1, iov, 3);
       return;
     }
   } else {
@@ -1972,11 +2085,9 @@ static void cmd_EXCHG(char cmd, int i) {
 
   {
     gasnet_node_t rank, next;
-    fd_set fds;
-    int j, k;
+    int k;
 
-    WRITE_EACH_CHILD(j,k,fds) {
-      if (k < 0) return;
+    for (k = 0; k < children; ++k) {
       rank = child[k].rank;
       next = rank + child[k].tree_ranks;
       iov[0].iov_base = (void*)&cmd1;
@@ -1985,7 +2096,7 @@ static void cmd_EXCHG(char cmd, int i) {
       iov[1].iov_len  = len * rank;
       iov[2].iov_base = data + len*next;
       iov[2].iov_len  = len * (nranks - next);
-      do_writev(child[k].sock, iov, 3);
+      ctrl_writev(k, iov, 3);
     }
     gasneti_free(data);
     data = NULL;
@@ -2029,7 +2140,7 @@ static void cmd_TRANS(char cmd, int i) {
       iov[1].iov_base = (void*)&len;
       iov[1].iov_len  = sizeof(len);
       build_all2all_iov(iov+2, data, len, myrank, tree_ranks);
-      do_writev(parent, iov, 3 + tree_ranks);
+      ctrl_writev(-1, iov, 3 + tree_ranks);
       return;
     }
   } else {
@@ -2038,14 +2149,12 @@ static void cmd_TRANS(char cmd, int i) {
   }
 
   {
-    fd_set fds;
-    int j, k;
-    WRITE_EACH_CHILD(j,k,fds) {
-      if (k < 0) return;
+    int k;
+    for (k = 0; k < children; ++k) {
       iov[0].iov_base = (void*)&cmd1;
       iov[0].iov_len  = sizeof(cmd1);
       build_all2all_iov(iov+1, data, len, child[k].rank, child[k].tree_ranks);
-      do_writev(child[k].sock, iov, 2 + child[k].tree_ranks);
+      ctrl_writev(k, iov, 2 + child[k].tree_ranks);
     }
     gasneti_free(data);
     gasneti_free(iov);
@@ -2132,7 +2241,7 @@ static void cmd_SNBCAST(char cmd, int i) {
       iov[1].iov_len  = sizeof(len);
       iov[2].iov_base = roots;
       iov[2].iov_len  = tree_ranks * sizeof(gasnet_node_t);
-      do_writev(parent, iov, 3 + children);
+      ctrl_writev(-1, iov, 3 + children);
       gasneti_free(roots);
       gasneti_free(iov);
       return;
@@ -2142,15 +2251,14 @@ static void cmd_SNBCAST(char cmd, int i) {
   }
 
   {
-    fd_set fds;
-    int j, k;
-    WRITE_EACH_CHILD(j,k,fds) {
+    int k;
+    for (k = 0; k < children; ++k) {
       struct iovec iov[2];
       iov[0].iov_base = (void*)&cmd1;
       iov[0].iov_len  = sizeof(cmd1);
       iov[1].iov_base = data + len * (child[k].rank - myrank);
       iov[1].iov_len  = len * child[k].tree_ranks;
-      do_writev(child[k].sock, iov, 2);
+      ctrl_writev(k, iov, 2);
     }
     gasneti_free(data);
     data = NULL;
@@ -2164,7 +2272,8 @@ static void cmd_rstrt_args(int j, char *args_p) {
   /* BLCR-TODO: error checking? */
   if (is_control) {
     if (child[j].rstrt_args & RSTRT_CMD_RESTART) ++initialized;
-    do_write(child[j].sock, &child[j].rstrt_args, sizeof(child[j].rstrt_args));
+    ctrl_write(j, &child[j].rstrt_args, sizeof(child[j].rstrt_args));
+    ctrl_flush();
     (void) blcr_reap(child[j].rank, 1); /* BLCR-TODO: error reporting/recovery */
   } else {
     char cmd = BOOTSTRAP_CMD_RSTRT_ARGS;
@@ -2192,7 +2301,8 @@ static void cmd_rollback(int j, const char *dir) {
       sigemptyset(&child_set);
       sigaddset(&child_set, SIGCHLD);
       sigprocmask(SIG_BLOCK, &child_set, &old_set);
-      do_write(child[j].sock, &cmd, sizeof(cmd)); /* ACK the rollback command */
+      ctrl_write(j, &cmd, sizeof(cmd)); /* ACK the rollback command */
+      ctrl_flush();
       do {
         pid = waitpid(child[j].pid, &status, 0);
       } while ((pid < 0) && (errno == EINTR) && !in_abort);
@@ -2211,7 +2321,9 @@ static void cmd_rollback(int j, const char *dir) {
         gasneti_fatalerror("socketpair() failed!");
       }
       child[j].sock = sv[1];
+      poll_fds[j+1].fd = sv[1];
       (void) fcntl_setfd(sv[1], FD_CLOEXEC);
+      (void) fcntl_setfl(sv[1], O_NONBLOCK);
       blcr_rollback(child[j].rank, dir);
       gasneti_assert(!rc); /* BLCR-TODO: proper error checking/recovery */
       (void) close(sv[0]);
@@ -2284,43 +2396,54 @@ static void dispatch(char cmd, int k) {
 static void event_loop(void) GASNETI_NORETURN;
 static void event_loop(void)
 {
-    int done = 0;
+    int *ready;
+    int k;
 
     siginterrupt(SIGCHLD, 1);
     reaper(SIGCHLD);
 
+    /* Switch the control sockets to non-blocking (see ctrl_writev()) */
+    poll_fds = gasneti_malloc((1 + children) * sizeof(struct pollfd));
+    gasneti_leak(poll_fds);
+    ready = gasneti_malloc((1 + children) * sizeof(int));
+    gasneti_leak(ready);
+    for (k = -1; k < children; ++k) {
+      int fd = child[k].sock; /* NOTE: child[-1].sock is -1 at the root, which poll() ignores */
+      if (fd >= 0) (void)fcntl_setfl(fd, O_NONBLOCK);
+      poll_fds[k+1].fd = fd;
+    }
+
     while (!finalized && !in_abort) {
-      char cmd;
-      int k, rc;
+      int j, nready = 0;
 
-      /* Use select to find a fd w/ available work or EOF */
-      {
-        static int next = 0; /* fairness: start search after prev result */
-        int n = all_fds.max + 1;
-        fd_set read_fds = all_fds.set;
-        int j;
+      /* Use poll to find all fds w/ available work or EOF, draining queued output */
+      for (k = -1; k < children; ++k) {
+        poll_fds[k+1].events = POLLIN | (ctrl_pending(k) ? POLLOUT : 0);
+      }
+      if (ctrl_poll() < 0) break;
+      for (k = -1; k < children; ++k) {
+        const short revents = poll_fds[k+1].revents;
+        if (revents & POLLOUT) ctrl_drain(k);
+        if (revents & (POLLIN | POLLHUP | POLLERR)) ready[nready++] = k;
+      }
 
-        rc = do_select(n, &read_fds, NULL);
+      /* Read 1 command byte from each, and dispatch */
+      for (j = 0; (j < nready) && !finalized && !in_abort; ++j) {
+        char cmd;
+        k = ready[j];
+        gasneti_assert(k >= -1);
+        gasneti_assert(k < children);
+
+        do_read(child[k].sock, &cmd, sizeof(cmd));
         if (in_abort) break;
 
-        for (j = 0, k = next; j <= children; ++j, ++k) {
-          if (k == children) k = is_root ? 0 : -1;
-          if (FD_ISSET(child[k].sock, &read_fds)) {
-            break;
-          }
-        }
-        next = k + 1;
+        dispatch(cmd, k);
       }
-      gasneti_assert(k >= -1);
-      gasneti_assert(k < children);
-
-      /* Read 1 command byte */
-      do_read(child[k].sock, &cmd, sizeof(cmd));
-      if (in_abort) break;
-
-      dispatch(cmd, k);
     }
 
+    /* Deliver any queued output (such as FINI1) */
+    ctrl_flush();
+
     /* Wait for all children to terminate */
     wait_for_all();
 
@@ -2404,6 +2527,9 @@ static void do_common(int argc, char **argv)
     }
     children = ctrl_children + rank_children;
 
+    urg_fds = gasneti_calloc(1 + ctrl_children, sizeof(struct pollfd));
+    gasneti_leak(urg_fds);
+
     child = gasneti_calloc(1 + children, sizeof(struct child));
     gasneti_leak(child);
 
@@ -2457,7 +2583,6 @@ static void do_master(const char *spawn_args, int *argc_p, char ***argv_p) {
   is_root = 1;
   is_control = 1;
 
-  fd_sets_init();
   gasneti_reghandler(SIGURG, &sigurg_handler);
   siginterrupt(SIGURG, 1);
 
@@ -2639,7 +2764,6 @@ static void do_control(const char *spawn_args, int *argc_p, char ***argv_p)
   is_root = 0;
   is_control = 1;
 
-  fd_sets_init();
   gasneti_reghandler(SIGURG, &sigurg_handler);
   siginterrupt(SIGURG, 1);
 
@@ -11,7 +11,7 @@
 #include <gasnet_handler.h>
 
 static pami_send_hint_t gasnete_null_send_hint;
-static const gasnete_eopaddr_t EOPADDR_NIL = { { 0xFF, 0xFF } };
+static const gasnete_eopaddr_t EOPADDR_NIL = { { 0xFFFF, 0xFF } };
 extern void _gasnete_iop_check(gasnete_iop_t *iop) { gasnete_iop_check(iop); }
 
 #if GASNET_SEGMENT_FAST || GASNET_SEGMENT_LARGE
@@ -47,20 +47,26 @@ static void gasnete_eop_alloc(gasnete_threaddata_t * const thread)) {
     gasnete_eopaddr_t addr;
     int bufidx = thread->eop_num_bufs;
     gasnete_eop_t *buf;
-    int i;
+    int i, n;
     gasnete_threadidx_t threadidx = thread->threadidx;
-    if (bufidx == 256) gasneti_fatalerror("GASNet Extended API: Ran out of explicit handles (limit=65535)");
+    if (bufidx == GASNETE_EOP_MAXBUFS) {
+      unsigned long limit = 0;
+      for (i=0; i < GASNETE_EOP_MAXBUFS; i++) limit += GASNETE_EOP_BUFSZ(i);
+      gasneti_fatalerror("GASNet Extended API: Ran out of explicit handles (limit=%lu)", limit - 1);
+    }
+    n = GASNETE_EOP_BUFSZ(bufidx);
     thread->eop_num_bufs++;
-    buf = (gasnete_eop_t *)gasneti_calloc(256,sizeof(gasnete_eop_t));
+    buf = (gasnete_eop_t *)gasneti_calloc(n,sizeof(gasnete_eop_t));
     gasneti_leak(buf);
-    for (i=0; i < 256; i++) {
+    addr.fulladdr = 0; /* compaddr does not cover all the bits */
+    for (i=0; i < n; i++) {
       addr.bufferidx = bufidx;
       #if GASNETE_SCATTER_EOPS_ACROSS_CACHELINES
         #ifdef GASNETE_EOP_MOD
-          addr.eopidx = (i+32) % 255;
+          addr.eopidx = (i+32) % (n-1);
         #else
           { int k = i+32;
-            addr.eopidx = k > 255 ? k - 255 : k;
+            addr.eopidx = k > (n-1) ? k - (n-1) : k;
           }
         #endif
       #else
@@ -82,11 +88,11 @@ static void gasnete_eop_alloc(gasnete_threaddata_t * const thread)) {
      /*  add a list terminator */
     #if GASNETE_SCATTER_EOPS_ACROSS_CACHELINES
       #ifdef GASNETE_EOP_MOD
-        buf[223].addr.eopidx = 255; /* modular arithmetic messes up this one */
+        buf[n-33].addr.eopidx = n-1; /* modular arithmetic messes up this one */
       #endif
-      buf[255].addr = EOPADDR_NIL;
+      buf[n-1].addr = EOPADDR_NIL;
     #else
-      buf[255].addr = EOPADDR_NIL;
+      buf[n-1].addr = EOPADDR_NIL;
     #endif
     thread->eop_bufs[bufidx] = buf;
     addr.bufferidx = bufidx;
@@ -96,12 +102,12 @@ static void gasnete_eop_alloc(gasnete_threaddata_t * const thread)) {
     #if GASNET_DEBUG
     { /* verify new free list got built correctly */
       int i;
-      int seen[256];
+      char *seen = gasneti_calloc(n, 1);
       gasnete_eopaddr_t addr = thread->eop_free;
 
       #if 0
       if (gasneti_mynode == 0)
-        for (i=0;i<256;i++) {                                   
+        for (i=0;i<n;i++) {                                   
           fprintf(stderr,"%i:  %i: next=%i\n",gasneti_mynode,i,buf[i].addr.eopidx);
           fflush(stderr);
         }
@@ -109,8 +115,7 @@ static void gasnete_eop_alloc(gasnete_threaddata_t * const thread)) {
       #endif
 
       gasneti_memcheck(thread->eop_bufs[bufidx]);
-      memset(seen, 0, 256*sizeof(int));
-      for (i=0;i<(bufidx==255?255:256);i++) {                                   
+      for (i=0;i<(bufidx==GASNETE_EOP_MAXBUFS-1?n-1:n);i++) {                                   
         gasnete_eop_t *eop;                                   
         gasneti_assert(!gasnete_eopaddr_isnil(addr));                 
         eop = GASNETE_EOPADDR_TO_PTR(thread,addr);            
@@ -123,6 +128,7 @@ static void gasnete_eop_alloc(gasnete_threaddata_t * const thread)) {
         addr = eop->addr;                                     
       }                                                       
       gasneti_assert(gasnete_eopaddr_isnil(addr)); 
+      gasneti_free(seen);
     }
     #endif
 }
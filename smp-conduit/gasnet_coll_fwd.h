@@ -42,10 +42,16 @@
         VAL(W, COLL_EXCHANGE_NB, sz)          \
         VAL(W, COLL_EXCHANGE_M, sz)           \
         VAL(W, COLL_EXCHANGE_M_NB, sz)        \
+        VAL(W, COLL_EXCHANGEV, sz)            \
+        VAL(W, COLL_EXCHANGEV_NB, sz)         \
         VAL(W, COLL_REDUCE, cnt)              \
         VAL(W, COLL_REDUCE_NB, cnt)           \
         VAL(W, COLL_REDUCE_M, cnt)            \
         VAL(W, COLL_REDUCE_M_NB, cnt)         \
+        VAL(W, COLL_REDUCE_ALL, cnt)          \
+        VAL(W, COLL_REDUCE_ALL_NB, cnt)       \
+        VAL(W, COLL_REDUCE_SCATTER, cnt)      \
+        VAL(W, COLL_REDUCE_SCATTER_NB, cnt)   \
         VAL(W, COLL_SCAN, cnt)                \
         VAL(W, COLL_SCAN_NB, cnt)             \
         VAL(W, COLL_SCAN_M, cnt)              \
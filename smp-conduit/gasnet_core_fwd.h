@@ -49,6 +49,29 @@
   #define gasnetc_AMPoll()        GASNET_OK  /* nothing to do */
 #endif
 
+#if GASNET_PSHM
+  /* Under GASNET_WAIT_BLOCK, after GASNETC_BLOCK_SPINS unsuccessful polls we
+   * sleep on our PSHM doorbell rather than continuing to spin and yield */
+  #define GASNETC_BLOCK_SPINS 64
+  #define gasneti_pollwhile(cnd) do {                         \
+    if (cnd) {                                                \
+      int _gasnetc_spins = 0;                                 \
+      gasneti_AMPoll();                                       \
+      while (cnd) {                                           \
+        if ((gasneti_wait_mode == GASNET_WAIT_BLOCK) &&       \
+            (++_gasnetc_spins == GASNETC_BLOCK_SPINS)) {      \
+          gasneti_pshm_block();                               \
+          _gasnetc_spins = 0;                                 \
+        } else {                                              \
+          GASNETI_WAITHOOK();                                 \
+        }                                                     \
+        gasneti_AMPoll();                                     \
+      }                                                       \
+    }                                                         \
+    gasneti_local_rmb();                                      \
+  } while (0)
+#endif
+
   /* define to 1 if conduit allows internal GASNet fns to issue put/get for remote
      addrs out of segment - not true when PSHM is used */
 #if 0
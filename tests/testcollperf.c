@@ -45,6 +45,22 @@ options that is covered testcoll
 #define NB_TESTS_ENABLED 1
 #endif
 
+/* When set, the reduce tests are repeated using the predefined
+   GASNET_COLL_FN_SUM_INT32 operator in place of the registered one */
+#ifndef REDUCE_BUILTIN_ENABLED
+#define REDUCE_BUILTIN_ENABLED 0
+#endif
+
+/* reduce_all/reduce_scatter are only exercised by testreduceallperf */
+#ifndef REDUCE_ALL_ENABLED
+#define REDUCE_ALL_ENABLED 0
+#endif
+
+/* exchangev is only exercised by testexchangeperf */
+#ifndef EXCHANGEV_ENABLED
+#define EXCHANGEV_ENABLED 0
+#endif
+
 #define ROOT_THREAD 0
 
 /* max data size for the test in bytes*/
@@ -88,6 +104,7 @@ typedef struct {
   int mythread;
   
   gasnet_coll_handle_t *hndl;
+  gasnet_coll_fn_handle_t reduce_func;
   char _pad[GASNETT_CACHE_LINE_BYTES];
   uint8_t *mysrc, *mydest;
   uint8_t *node_src, *node_dst;
@@ -468,6 +485,87 @@ void run_SINGLE_ADDR_test(thread_data_t *td, uint8_t **dst_arr, uint8_t **src_ar
   print_timer(td,  "exchange_NB", output_str,  "SINGLE-addr", flag_str, nelem, end);  
  #endif
 #endif
+
+#if EXCHANGEV_ENABLED
+  /* the count and offset arrays are indexed by image so LOCAL mode is limited 
+     to one thread per node*/
+  if(!(flags & GASNET_COLL_LOCAL) || threads_per_node == 1) {
+  /*EXCHANGEV*/
+  /* block sizes are skewed between nelem/3 and nelem elements (possibly zero) and 
+     the received blocks are packed back to back.  The dst in segment flag is also
+     dropped once to cover the algorithms that only go through the scratch space*/
+  size_t *src_counts = test_malloc(4*sizeof(size_t)*THREADS);
+  size_t *src_offsets = src_counts + THREADS;
+  size_t *dst_counts = src_offsets + THREADS;
+  size_t *dst_offsets = dst_counts + THREADS;
+  int v;
+#define EXCHANGEV_COUNT(FROM, TO) ((nelem*(((FROM)+(TO))%3+1))/3)
+  for(t=0; t<THREADS; t++) {
+    src_counts[t] = EXCHANGEV_COUNT(td->mythread, t)*sizeof(int);
+    src_offsets[t] = t*nelem*sizeof(int);
+    dst_counts[t] = EXCHANGEV_COUNT(t, td->mythread)*sizeof(int);
+    dst_offsets[t] = (t ? dst_offsets[t-1] + dst_counts[t-1] : 0);
+  }
+  for(v=0; v<2; v++) {
+  const int vflags = (v ? flags & ~GASNET_COLL_DST_IN_SEGMENT : flags);
+  for(k=0; k<outer_verification_iters; k++) {
+    COLL_BARRIER();
+    for(i=0; i<inner_verification_iters*nelem*THREADS; i++) {
+      src[i] = 42+i+td->mythread*10000;
+      dst[i] = -1;
+    }
+    
+    if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();} 
+    for(i=0; i<inner_verification_iters; i++) {
+      gasnet_coll_exchangev(GASNET_TEAM_ALL, dst+i*nelem*THREADS, dst_counts, dst_offsets, 
+                            src+i*nelem*THREADS, src_counts, src_offsets, nelem*sizeof(int), vflags);
+    }
+    if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
+    
+    for(i=0; i<inner_verification_iters; i++) {
+      for(t=0; t<THREADS; t++) {
+        const int *blk = dst + i*nelem*THREADS + dst_offsets[t]/sizeof(int);
+        for(j=0; j<EXCHANGEV_COUNT(t, td->mythread); j++) {
+          int expected = (int)(42+t*10000+i*THREADS*nelem+td->mythread*nelem+j);
+          if(blk[j] != expected) {
+            MSG("%d> exchangev verification @ iteration: %d ... expected %d got %d", td->mythread, i, expected, blk[j]);
+            ERROR_EXIT();
+          }
+        }
+      }
+    }
+  }
+  }
+#undef EXCHANGEV_COUNT
+  COLL_BARRIER();
+  begin = gasnett_ticks_now();
+  if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();}
+  for(i=0; i<performance_iters; i++) { 
+    gasnet_coll_exchangev(GASNET_TEAM_ALL, dst, dst_counts, dst_offsets, src, src_counts, src_offsets, sizeof(int)*nelem, flags);
+  }
+  if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
+  end =  gasnett_ticks_now() - begin;
+  COLL_BARRIER();  
+  print_timer(td,  "exchangev", output_str,  "SINGLE-addr", flag_str, nelem, end);  
+
+ #if NB_TESTS_ENABLED
+  COLL_BARRIER();
+  begin = gasnett_ticks_now();
+  if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();}
+  for(i=0; i<performance_iters; i++) { 
+    handles[i] = gasnet_coll_exchangev_nb(GASNET_TEAM_ALL, dst, dst_counts, dst_offsets, src, src_counts, src_offsets, sizeof(int)*nelem, flags);
+  }
+  for(i=0; i<performance_iters; i++) { 
+    gasnet_coll_wait_sync(handles[i]);
+  }
+  if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
+  end =  gasnett_ticks_now() - begin;
+  COLL_BARRIER();  
+  print_timer(td,  "exchangev_NB", output_str,  "SINGLE-addr", flag_str, nelem, end);  
+ #endif
+  test_free(src_counts);
+  }
+#endif
   
 #if REDUCE_ENABLED || ALL_COLL_ENABLED  
   /*REDUCE*/
@@ -485,7 +583,7 @@ void run_SINGLE_ADDR_test(thread_data_t *td, uint8_t **dst_arr, uint8_t **src_ar
     }
     if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();} 
     for(i=0; i<inner_verification_iters; i++) {
-      gasnet_coll_reduce(GASNET_TEAM_ALL, root_thread, dst+i*nelem, src+i*nelem, 0,0, sizeof(int), nelem, 0, 0, flags);
+      gasnet_coll_reduce(GASNET_TEAM_ALL, root_thread, dst+i*nelem, src+i*nelem, 0,0, sizeof(int), nelem, td->reduce_func, 0, flags);
     }
     if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
     
@@ -509,20 +607,20 @@ void run_SINGLE_ADDR_test(thread_data_t *td, uint8_t **dst_arr, uint8_t **src_ar
   begin = gasnett_ticks_now();
   if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();}
   for(i=0; i<performance_iters; i++) { 
-    gasnet_coll_reduce(GASNET_TEAM_ALL, root_thread, dst, src, 0,0, sizeof(int), nelem, 0, 0, flags);
+    gasnet_coll_reduce(GASNET_TEAM_ALL, root_thread, dst, src, 0,0, sizeof(int), nelem, td->reduce_func, 0, flags);
   }
   if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
   end =  gasnett_ticks_now() - begin;
   COLL_BARRIER();  
 
-  print_timer(td,  "reduce", output_str,  "SINGLE-addr", flag_str, nelem, end);  
+  print_timer(td,  (td->reduce_func ? "reduce(builtin)" : "reduce"), output_str,  "SINGLE-addr", flag_str, nelem, end);  
 
  #if NB_TESTS_ENABLED
   COLL_BARRIER();
   begin = gasnett_ticks_now();
   if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();}
   for(i=0; i<performance_iters; i++) { 
-    handles[i] = gasnet_coll_reduce_nb(GASNET_TEAM_ALL, root_thread, dst, src, 0,0, sizeof(int), nelem, 0, 0, flags);
+    handles[i] = gasnet_coll_reduce_nb(GASNET_TEAM_ALL, root_thread, dst, src, 0,0, sizeof(int), nelem, td->reduce_func, 0, flags);
   }
   for(i=0; i<performance_iters; i++) { 
     gasnet_coll_wait_sync(handles[i]);
@@ -530,10 +628,121 @@ void run_SINGLE_ADDR_test(thread_data_t *td, uint8_t **dst_arr, uint8_t **src_ar
   if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
   end =  gasnett_ticks_now() - begin;
   COLL_BARRIER();  
-  print_timer(td,  "reduce_NB", output_str,  "SINGLE-addr", flag_str, nelem, end);  
+  print_timer(td,  (td->reduce_func ? "reduce_NB(builtin)" : "reduce_NB"), output_str,  "SINGLE-addr", flag_str, nelem, end);  
  #endif
 #endif
 
+#if REDUCE_ALL_ENABLED
+  /* the single-address reduce_all/reduce_scatter take one local buffer per node 
+     so LOCAL mode is limited to one thread per node*/
+  if(!(flags & GASNET_COLL_LOCAL) || threads_per_node == 1) {
+  /*REDUCE_ALL*/
+  for(k=0; k<outer_verification_iters; k++) {
+    COLL_BARRIER();
+    for(i=0; i<inner_verification_iters; i++) {
+      for(j=0; j<nelem; j++) {
+        src[i*nelem+j] = (42*(i+1)+j);
+      }
+    }
+    for(i=0; i<nelem*inner_verification_iters; i++) {
+      dst[i] = -1;
+    }
+    if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();} 
+    for(i=0; i<inner_verification_iters; i++) {
+      gasnet_coll_reduce_all(GASNET_TEAM_ALL, dst+i*nelem, src+i*nelem, sizeof(int), nelem, td->reduce_func, 0, flags);
+    }
+    if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
+    
+    for(i=0; i<inner_verification_iters; i++) {
+      for(j=0; j<nelem; j++) {
+        int expected = (42*(i+1)+j)*THREADS;
+        if(dst[i*nelem+j] != expected) {
+          MSG("%d> reduce_all verification @ iteration: %d,%d ... expected %d got %d", td->mythread, i, j, expected, dst[i*nelem+j]);
+          ERROR_EXIT();
+        }
+      }
+    }
+  }
+
+  COLL_BARRIER();
+  begin = gasnett_ticks_now();
+  if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();}
+  for(i=0; i<performance_iters; i++) { 
+    gasnet_coll_reduce_all(GASNET_TEAM_ALL, dst, src, sizeof(int), nelem, td->reduce_func, 0, flags);
+  }
+  if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
+  end =  gasnett_ticks_now() - begin;
+  COLL_BARRIER();  
+  print_timer(td,  (td->reduce_func ? "reduce_all(builtin)" : "reduce_all"), output_str,  "SINGLE-addr", flag_str, nelem, end);  
+
+  /* the same result composed from a rooted reduce and a broadcast, for comparison*/
+  COLL_BARRIER();
+  begin = gasnett_ticks_now();
+  if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();}
+  for(i=0; i<performance_iters; i++) { 
+    gasnet_coll_reduce(GASNET_TEAM_ALL, root_thread, dst, src, 0,0, sizeof(int), nelem, td->reduce_func, 0, flags);
+    gasnet_coll_broadcast(GASNET_TEAM_ALL, dst, root_thread, dst, sizeof(int)*nelem, flags);
+  }
+  if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
+  end =  gasnett_ticks_now() - begin;
+  COLL_BARRIER();  
+  print_timer(td,  "reduce+broadcast", output_str,  "SINGLE-addr", flag_str, nelem, end);  
+
+  /*REDUCE_SCATTER*/
+  for(k=0; k<outer_verification_iters; k++) {
+    COLL_BARRIER();
+    for(i=0; i<inner_verification_iters; i++) {
+      for(j=0; j<nelem*THREADS; j++) {
+        src[i*nelem*THREADS+j] = (42*(i+1)+j);
+      }
+    }
+    for(i=0; i<nelem*inner_verification_iters; i++) {
+      dst[i] = -1;
+    }
+    if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();} 
+    for(i=0; i<inner_verification_iters; i++) {
+      gasnet_coll_reduce_scatter(GASNET_TEAM_ALL, dst+i*nelem, src+i*nelem*THREADS, sizeof(int), nelem, td->reduce_func, 0, flags);
+    }
+    if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
+    
+    for(i=0; i<inner_verification_iters; i++) {
+      for(j=0; j<nelem; j++) {
+        int expected = (42*(i+1)+td->mythread*nelem+j)*THREADS;
+        if(dst[i*nelem+j] != expected) {
+          MSG("%d> reduce_scatter verification @ iteration: %d,%d ... expected %d got %d", td->mythread, i, j, expected, dst[i*nelem+j]);
+          ERROR_EXIT();
+        }
+      }
+    }
+  }
+
+  COLL_BARRIER();
+  begin = gasnett_ticks_now();
+  if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();}
+  for(i=0; i<performance_iters; i++) { 
+    gasnet_coll_reduce_scatter(GASNET_TEAM_ALL, dst, src, sizeof(int), nelem, td->reduce_func, 0, flags);
+  }
+  if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
+  end =  gasnett_ticks_now() - begin;
+  COLL_BARRIER();  
+  print_timer(td,  (td->reduce_func ? "reduce_scatter(builtin)" : "reduce_scatter"), output_str,  "SINGLE-addr", flag_str, nelem, end);  
+
+  /* the same data movement composed from a rooted reduce and a scatter, for comparison
+     (the reduced vector lands in dst on the root and the blocks overwrite src)*/
+  COLL_BARRIER();
+  begin = gasnett_ticks_now();
+  if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();}
+  for(i=0; i<performance_iters; i++) { 
+    gasnet_coll_reduce(GASNET_TEAM_ALL, root_thread, dst, src, 0,0, sizeof(int), nelem*THREADS, td->reduce_func, 0, flags);
+    gasnet_coll_scatter(GASNET_TEAM_ALL, src, root_thread, dst, sizeof(int)*nelem, flags);
+  }
+  if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
+  end =  gasnett_ticks_now() - begin;
+  COLL_BARRIER();  
+  print_timer(td,  "reduce+scatter", output_str,  "SINGLE-addr", flag_str, nelem, end);  
+  }
+#endif
+
   if(td->my_local_thread==0 && VERBOSE_VERIFICATION_OUTPUT) MSG0("%c: %s/SINGLE-addr sync_mode: %s size: %ld bytes root: %d.  PASS", TEST_SECTION_NAME(), output_str, flag_str, (long int) (sizeof(int)*nelem), root_thread);
   
   COLL_BARRIER();
@@ -895,7 +1104,7 @@ void run_MULTI_ADDR_test(thread_data_t *td, uint8_t **dst_arr, uint8_t **src_arr
     curr_src_arr = tmp_src;
     for(i=0; i<inner_verification_iters; i++) {
       scale_ptrM((void**) curr_src_arr, (void**) src_arr, nelem*i, sizeof(int), num_addrs);
-      gasnet_coll_reduceM(GASNET_TEAM_ALL, root_thread, dst+i*nelem, (void**)curr_src_arr, 0,0, sizeof(int), nelem, 0, 0, flags);
+      gasnet_coll_reduceM(GASNET_TEAM_ALL, root_thread, dst+i*nelem, (void**)curr_src_arr, 0,0, sizeof(int), nelem, td->reduce_func, 0, flags);
       curr_src_arr +=num_addrs;
     }
     if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
@@ -920,19 +1129,19 @@ void run_MULTI_ADDR_test(thread_data_t *td, uint8_t **dst_arr, uint8_t **src_arr
   begin = gasnett_ticks_now();
   if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();}
   for(i=0; i<performance_iters; i++) { 
-    gasnet_coll_reduceM(GASNET_TEAM_ALL, root_thread, dst, (void**)src_arr, 0,0, sizeof(int), nelem, 0, 0, flags);
+    gasnet_coll_reduceM(GASNET_TEAM_ALL, root_thread, dst, (void**)src_arr, 0,0, sizeof(int), nelem, td->reduce_func, 0, flags);
   }
   if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
   end =  gasnett_ticks_now() - begin;
   COLL_BARRIER();  
-  print_timer(td,  "reduceM", output_str,  "MULTI-addr", flag_str, nelem, end);  
+  print_timer(td,  (td->reduce_func ? "reduceM(builtin)" : "reduceM"), output_str,  "MULTI-addr", flag_str, nelem, end);  
 
  #if NB_TESTS_ENABLED
   COLL_BARRIER();
   begin = gasnett_ticks_now();
   if(flags & GASNET_COLL_IN_NOSYNC) {COLL_BARRIER();}
   for(i=0; i<performance_iters; i++) { 
-    handles[i] = gasnet_coll_reduceM_nb(GASNET_TEAM_ALL, root_thread, dst, (void**)src_arr, 0,0, sizeof(int), nelem, 0, 0, flags);
+    handles[i] = gasnet_coll_reduceM_nb(GASNET_TEAM_ALL, root_thread, dst, (void**)src_arr, 0,0, sizeof(int), nelem, td->reduce_func, 0, flags);
   }
   for(i=0; i<performance_iters; i++) {
     gasnet_coll_wait_sync(handles[i]);
@@ -940,7 +1149,7 @@ void run_MULTI_ADDR_test(thread_data_t *td, uint8_t **dst_arr, uint8_t **src_arr
   if(flags & GASNET_COLL_OUT_NOSYNC) {COLL_BARRIER();}
   end =  gasnett_ticks_now() - begin;
   COLL_BARRIER();  
-  print_timer(td,  "reduceM_NB", output_str,  "MULTI-addr", flag_str, nelem, end);  
+  print_timer(td,  (td->reduce_func ? "reduceM_NB(builtin)" : "reduceM_NB"), output_str,  "MULTI-addr", flag_str, nelem, end);  
  #endif
 #endif
   
@@ -978,14 +1187,15 @@ void *thread_main(void *arg) {
 
   COLL_BARRIER();
 
-  for(flag_iter=0; flag_iter<9; flag_iter++) {
+  for(flag_iter=0; flag_iter<9*(1+REDUCE_BUILTIN_ENABLED); flag_iter++) {
     int flags;
+    td->reduce_func = (flag_iter < 9) ? 0 : GASNET_COLL_FN_SUM_INT32;
     if(td->my_local_thread==0) TEST_SECTION_BEGIN();
     COLL_BARRIER();
     
     if(TEST_SECTION_ENABLED()) {
       
-      switch(flag_iter) { 
+      switch(flag_iter % 9) { 
       case 0: flags = GASNET_COLL_IN_NOSYNC  | GASNET_COLL_OUT_NOSYNC; break;
       case 1: flags = GASNET_COLL_IN_NOSYNC  | GASNET_COLL_OUT_MYSYNC; break;
       case 2: flags = GASNET_COLL_IN_NOSYNC  | GASNET_COLL_OUT_ALLSYNC; break;
@@ -1034,7 +1244,8 @@ void *thread_main(void *arg) {
       if(td->my_local_thread==0  && !VERBOSE_VERIFICATION_OUTPUT) {
         char flag_str[8];
         fill_flag_str(flags, flag_str);
-        MSG0("%c: sync_mode: %s %ld-%ld (powers of 2) bytes root: %d.  PASS",  TEST_SECTION_NAME(), flag_str, (long int) (sizeof(int)*1), (long int) sizeof(int)*max_data_size, (int) root_thread);
+        MSG0("%c: sync_mode: %s %ld-%ld (powers of 2) bytes root: %d%s.  PASS",  TEST_SECTION_NAME(), flag_str, (long int) (sizeof(int)*1), (long int) sizeof(int)*max_data_size, (int) root_thread,
+             (td->reduce_func ? " (builtin reduce)" : ""));
       }
 
     }
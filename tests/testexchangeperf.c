@@ -2,6 +2,9 @@
 #define ALL_ADDR_MODE_ENABLED 0
 
 #define EXCHANGE_ENABLED 1
+#define EXCHANGEV_ENABLED 1
+#define SINGLE_SINGLE_MODE_ENABLED 1
+#define SINGLE_LOCAL_MODE_ENABLED 1
 #define MULTI_SINGLE_MODE_ENABLED 1
 
 #include "testcollperf.c"
@@ -0,0 +1,138 @@
+/*   $Source: bitbucket.org:berkeleylab/gasnet.git/tests/testhandles.c $
+ * Description: GASNet explicit-handle stress test
+ *   keeps a large number of non-blocking explicit-handle operations
+ *   outstanding at once, and checks that they all complete correctly,
+ *   then times gasnet_{wait,try}_syncnb_{all,some}() on a smaller array
+ * Copyright (c) 2026, The Regents of the University of California
+ * Terms of use are as specified in license.txt
+ */
+
+#include <gasnet.h>
+
+#define SLOTS 4096
+#ifndef TEST_SEGSZ
+  #define TEST_SEGSZ_EXPR ((uintptr_t)SLOTS*sizeof(uint64_t))
+#endif
+#include <test.h>
+
+#define VALUE(node,slot) ((((uint64_t)(node)) << 32) | (uint64_t)(slot))
+
+/* number of handles in the timed section */
+#define SYNC_HANDLES 10000
+
+int main(int argc, char **argv) {
+  int iters = 2;
+  long numhandles = 1048576;
+  gasnet_node_t mynode, peer;
+  uint64_t *myseg, *peerseg, *dst;
+  gasnet_handle_t *handles;
+  long i;
+  int iter;
+
+  GASNET_Safe(gasnet_init(&argc, &argv));
+  GASNET_Safe(gasnet_attach(NULL, 0, TEST_SEGSZ_REQUEST, TEST_MINHEAPOFFSET));
+  test_init("testhandles",1,"(handles) (iters)");
+
+  if (argc > 1) numhandles = atol(argv[1]);
+  if (numhandles <= 0) numhandles = 1048576;
+  if (argc > 2) iters = atoi(argv[2]);
+  if (iters <= 0) iters = 2;
+  if (argc > 3) test_usage();
+
+  mynode = gasnet_mynode();
+  peer = (mynode + 1) % gasnet_nodes();
+  myseg = (uint64_t *)TEST_MYSEG();
+  peerseg = (uint64_t *)TEST_SEG(peer);
+
+  handles = (gasnet_handle_t *)test_malloc(numhandles * sizeof(gasnet_handle_t));
+  dst = (uint64_t *)test_malloc(numhandles * sizeof(uint64_t));
+
+  for (i = 0; i < SLOTS; ++i) myseg[i] = VALUE(mynode, i);
+
+  MSG0("Running explicit-handle stress test with %ld outstanding handles and %d iterations",
+       numhandles, iters);
+  BARRIER();
+
+  for (iter = 0; iter < iters; ++iter) {
+    memset(dst, 0, numhandles * sizeof(uint64_t));
+
+    /* initiate every operation before syncing any of them */
+    for (i = 0; i < numhandles; ++i) {
+      handles[i] = gasnet_get_nb_bulk(&dst[i], peer, &peerseg[i % SLOTS], sizeof(uint64_t));
+    }
+
+    /* alternate between bulk sync and one-at-a-time sync in reverse order,
+       so later iterations allocate from a free list built in both orders */
+    if (iter & 1) {
+      for (i = numhandles - 1; i >= 0; --i) {
+        gasnet_wait_syncnb(handles[i]);
+      }
+    } else {
+      gasnet_wait_syncnb_all(handles, numhandles);
+      for (i = 0; i < numhandles; ++i) {
+        if (handles[i] != GASNET_INVALID_HANDLE) {
+          ERR("handle %ld not reset by gasnet_wait_syncnb_all", i);
+          break;
+        }
+      }
+    }
+
+    for (i = 0; i < numhandles; ++i) {
+      if (dst[i] != VALUE(peer, i % SLOTS)) {
+        ERR("iter %d: mismatch at op %ld: expected 0x%llx got 0x%llx", iter, i,
+            (unsigned long long)VALUE(peer, i % SLOTS), (unsigned long long)dst[i]);
+        break;
+      }
+    }
+    BARRIER();
+  }
+
+  { /* time syncing a (more typical) array of handles with wait_all, with a
+       loop on wait_some which also visits each newly completed handle, and
+       by polling with try_all */
+    const long n = MIN(numhandles, SYNC_HANDLES);
+    gasnett_tick_t start, all_ticks, some_ticks, try_ticks;
+    long done, calls = 0, polls = 0;
+
+    for (i = 0; i < n; ++i) {
+      handles[i] = gasnet_get_nb_bulk(&dst[i], peer, &peerseg[i % SLOTS], sizeof(uint64_t));
+    }
+    start = gasnett_ticks_now();
+    gasnet_wait_syncnb_all(handles, n);
+    all_ticks = gasnett_ticks_now() - start;
+    BARRIER();
+
+    for (i = 0; i < n; ++i) {
+      handles[i] = gasnet_get_nb_bulk(&dst[i], peer, &peerseg[i % SLOTS], sizeof(uint64_t));
+    }
+    start = gasnett_ticks_now();
+    for (done = 0; done < n; ) {
+      gasnet_wait_syncnb_some(handles, n);
+      ++calls;
+      for (done = 0, i = 0; i < n; ++i) done += (handles[i] == GASNET_INVALID_HANDLE);
+    }
+    some_ticks = gasnett_ticks_now() - start;
+    BARRIER();
+
+    for (i = 0; i < n; ++i) {
+      handles[i] = gasnet_get_nb_bulk(&dst[i], peer, &peerseg[i % SLOTS], sizeof(uint64_t));
+    }
+    start = gasnett_ticks_now();
+    while (gasnet_try_syncnb_all(handles, n) != GASNET_OK) ++polls;
+    try_ticks = gasnett_ticks_now() - start;
+    BARRIER();
+
+    MSG("%ld handles: wait_syncnb_all %.3f ms, wait_syncnb_some loop %.3f ms (%ld calls), "
+        "try_syncnb_all loop %.3f ms (%ld polls)", n,
+        gasnett_ticks_to_ns(all_ticks) / 1.0e6, gasnett_ticks_to_ns(some_ticks) / 1.0e6, calls,
+        gasnett_ticks_to_ns(try_ticks) / 1.0e6, polls);
+  }
+
+  test_free(handles);
+  test_free(dst);
+
+  MSG("done.");
+
+  gasnet_exit(0);
+  return 0;
+}
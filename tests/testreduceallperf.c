@@ -0,0 +1,9 @@
+#define ALL_COLL_ENABLED 0
+#define ALL_ADDR_MODE_ENABLED 0
+
+#define REDUCE_ALL_ENABLED 1
+#define SINGLE_SINGLE_MODE_ENABLED 1
+#define SINGLE_LOCAL_MODE_ENABLED 1
+#define REDUCE_BUILTIN_ENABLED 1
+
+#include "testcollperf.c"
@@ -3,5 +3,6 @@
 
 #define REDUCE_ENABLED 1
 #define MULTI_SINGLE_MODE_ENABLED 1
+#define REDUCE_BUILTIN_ENABLED 1
 
 #include "testcollperf.c"
@@ -853,7 +853,14 @@ void doit(int iters, int runtests) {
         trim_addr_list(src, dst);
         tmp = buildcontig_addr_list(TEST_RAND_PICK(my_heap_write2_area, my_seg_write2_area), dst->totalsz/VEC_SZ, areasz);
 
-        TIMED_PUT(gasnet_puti_bulk(partner, dst->count, dst->list, dst->chunklen, src->count, src->list, src->chunklen),dst->totalsz);
+        if (TEST_RAND_PICK(0,1)) {
+          TIMED_PUT(gasnet_puti_bulk(partner, dst->count, dst->list, dst->chunklen, src->count, src->list, src->chunklen),dst->totalsz);
+        } else { /* persistent plan, executed repeatedly */
+          gasnet_visplan_t plan = gasnet_puti_plan(partner, dst->count, dst->list, dst->chunklen, src->count, src->list, src->chunklen);
+          gasnet_visplan_exec_bulk(plan);
+          gasnet_wait_syncnb(gasnet_visplan_exec_nb_bulk(plan));
+          gasnet_visplan_destroy(plan);
+        }
         verify_addr_list(src);
         verify_addr_list(dst);
         TIMED_GET(gasnet_geti_bulk(tmp->count, tmp->list, tmp->chunklen, partner, dst->count, dst->list, dst->chunklen),dst->totalsz);
@@ -878,7 +885,15 @@ void doit(int iters, int runtests) {
         trim_addr_list(src, dst);
         tmp = buildcontig_addr_list(my_seg_write2_area, dst->totalsz/VEC_SZ, areasz);
 
-        gasnet_geti_bulk(dst->count, dst->list, dst->chunklen, partner, src->count, src->list, src->chunklen);
+        if (TEST_RAND_PICK(0,1)) {
+          gasnet_geti_bulk(dst->count, dst->list, dst->chunklen, partner, src->count, src->list, src->chunklen);
+        } else { /* persistent plan, executed repeatedly */
+          gasnet_visplan_t plan = gasnet_geti_plan(dst->count, dst->list, dst->chunklen, partner, src->count, src->list, src->chunklen);
+          gasnet_visplan_exec_nbi_bulk(plan);
+          gasnet_wait_syncnbi_all();
+          gasnet_visplan_exec_bulk(plan);
+          gasnet_visplan_destroy(plan);
+        }
         verify_addr_list(src);
         verify_addr_list(dst);
         if ((segeverything || dstarea == my_seg_write1_area) && 
@@ -32,9 +32,9 @@ int contigfactor = 8;
 int datafactor = 2;
 int densitysteps = 4;
 
-typedef enum { TEST_V=0, TEST_I=1, TEST_S=2 } test_vis_t;
-int dovis[] = { 1, 1, 1 };
-const char *visdesc[] = { "VECTOR", "INDEXED", "STRIDED" };
+typedef enum { TEST_V=0, TEST_I=1, TEST_S=2, TEST_IP=3 } test_vis_t;
+int dovis[] = { 1, 1, 1, 1 };
+const char *visdesc[] = { "VECTOR", "INDEXED", "STRIDED", "INDEXED-PLAN" };
 
 gasnet_memvec_t *make_vlist(void *baseaddr, size_t stride, size_t cnt, size_t chunksz) {
   gasnet_memvec_t *retval = test_malloc(cnt*sizeof(gasnet_memvec_t));
@@ -240,7 +240,7 @@ int main(int argc, char **argv) {
     int rawdatasz;
     int isget;
     test_vis_t viscat;
-    for (viscat = TEST_V; viscat <= TEST_S; viscat++) {
+    for (viscat = TEST_V; viscat <= TEST_IP; viscat++) {
     for (isget = 0; isget < 2; isget++) {
       if (TEST_SECTION_BEGIN_ENABLED()) {
         if (isget && !dogets) continue;
@@ -279,6 +279,7 @@ int main(int argc, char **argv) {
               size_t *Lstrides = NULL;
               size_t *Rstrides = NULL;
               size_t *LRcount = NULL;
+              gasnet_visplan_t plan = NULL;
               size_t stride = contigsz*(((double)densitysteps)/(densitysteps-di));
               if (stride * MAX(Lcnt,Rcnt) > maxsz) { strcat(mystr,"    -   "); continue; }
 
@@ -292,6 +293,12 @@ int main(int argc, char **argv) {
                     Lilist = make_ilist(Lbase, stride, Lcnt, Lsz);
                     Rilist = make_ilist(Rbase, stride, Rcnt, Rsz);
                     break;
+                  case TEST_IP: /* same pattern as TEST_I, but packetized once up front */
+                    Lilist = make_ilist(Lbase, stride, Lcnt, Lsz);
+                    Rilist = make_ilist(Rbase, stride, Rcnt, Rsz);
+                    if (isget) plan = gasnet_geti_plan(Lcnt,Lilist,Lsz,peerproc,Rcnt,Rilist,Rsz);
+                    else plan = gasnet_puti_plan(peerproc,Rcnt,Rilist,Rsz,Lcnt,Lilist,Lsz);
+                    break;
                   case TEST_S: {
                     size_t chunkcnt = datasz/contigsz;
                     int dim;
@@ -342,6 +349,11 @@ int main(int argc, char **argv) {
                                                 LRcount,stridelevels);                           \
                     }                                                                            \
                     break;                                                                       \
+                  case TEST_IP:                                                                  \
+                    for (i = 0; i < iters; i++) {                                                \
+                      gasnet_visplan_exec_nbi_bulk(plan);                                        \
+                    }                                                                            \
+                    break;                                                                       \
                 }                                                                                \
                 gasnet_wait_syncnbi_all();                                                       \
               } while (0)
@@ -367,6 +379,7 @@ int main(int argc, char **argv) {
               if (Lstrides) test_free(Lstrides);
               if (Rstrides) test_free(Rstrides);
               if (LRcount) test_free(LRcount);
+              if (plan) gasnet_visplan_destroy(plan);
             }
             if (iamsender) { printf("%s\n", mystr); fflush(stdout); }
             BARRIER();